@@ -44,6 +44,9 @@ def TLB_constructor(level):
             missLatency2 = options.L%(level)dMissLatency,\
             maxOutstandingReqs = options.L%(level)dMaxOutstandingReqs,\
             accessDistance = options.L%(level)dAccessDistanceStat,\
+            largePages = options.gpu_large_pages,\
+            pageWalkCacheSize = options.gpu_pwc_entries,\
+            numWalkers = options.gpu_walkers,\
             clk_domain = SrcClockDomain(\
                 clock = options.gpu_clock,\
                 voltage_domain = VoltageDomain(\
@@ -37,6 +37,15 @@ def tlb_options(parser):
 
     parser.add_option("--TLB-config", type="string", default="perCU",
             help="Options are: perCU (default), mono, 2CU, or perLane")
+    parser.add_option("--gpu-large-pages", action="store_true",
+            help="Map the GPU allocations on 2MB pages and use 2MB and 1GB "
+            "entries in the GPU TLBs")
+    parser.add_option("--gpu-pwc-entries", type='int', default="0",
+            help="Entries of the page walk cache of the last level GPU TLB, "
+            "0 for fixed latency page walks")
+    parser.add_option("--gpu-walkers", type='int', default="0",
+            help="Page walks the last level GPU TLB does in parallel, "
+            "0 for no limit")
 
     #===================================================================
     #   L1 TLB Options (D-TLB, I-TLB, Dispatcher-TLB)
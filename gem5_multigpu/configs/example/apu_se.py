@@ -203,6 +203,20 @@ parser.add_option("--coal-tokens", type=int, default=4,
                   help="Number of coalescer tokens per CU")
 parser.add_option("--default-acq-rel", action="store_true", default=False,
                   help="sets rel/acq for every kernel")
+parser.add_option("--sample-kernels-after", type=int, default=0,
+                  help="Simulate this many instances of each kernel in "
+                  "detail, then sample later instances using their runtime "
+                  "(0 disables kernel sampling)")
+parser.add_option("--gpu-fast-forward-kernels", type=int, default=0,
+                  help="Execute this many GPU kernels functionally before "
+                  "switching to detailed simulation")
+parser.add_option("--gpu-fast-forward-until", type="string", default="",
+                  help="Execute GPU kernels functionally until the first "
+                  "launch of the kernel with this name")
+parser.add_option("--gpu-fast-forward-warmup", type=int, default=0,
+                  help="Number of kernels simulated in detail to warm up "
+                  "the caches before stats are reset after a GPU "
+                  "fast-forward")
 parser.add_option("--vrf_lm_bus_latency", type=int, default=1,
                   help="Latency while accessing shared memory")
 parser.add_option("--mem-req-latency", type=int, default=50,
@@ -279,10 +293,12 @@ for i in range(num_gpus):
 # these impl_kern_launch_rel and impl_kern_end_rel flags. The flag=true
 # means pipeline initiates a acquire/release operation at kernel launch/end.
 # VIPER protocol is write-through based, and thus only impl_kern_launch_acq
-# needs to set.
+# needs to set. With a write-back TCP (--WB_L1), each workgroup also
+# writes its dirty TCP lines back when it ends.
 for i in range(num_gpus): #!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     if (buildEnv['PROTOCOL'] == 'GPU_VIPER'):
         shader[i].impl_kern_launch_acq = True
+        shader[i].impl_wg_end_l1_rel = options.WB_L1
         shader[i].impl_kern_end_rel = False
     else:
         shader[i].impl_kern_launch_acq = True
@@ -470,12 +486,17 @@ global_scheduler = GlobalScheduler(num_gpus=options.num_gpus, n_cu=n_cu,
                                    num_SIMDs=options.simds_per_cu,
                                    pioAddr=gs_map_paddr, pioDelay=10,
                                    sched_policy=options.gs_policy,
-                                   outdir=m5.options.outdir, num_sched_gpu=options.gs_num_sched_gpu, default_acq_rel=options.default_acq_rel, num_tccs=options.num_tccs)
+                                   outdir=m5.options.outdir, num_sched_gpu=options.gs_num_sched_gpu, default_acq_rel=options.default_acq_rel, num_tccs=options.num_tccs,
+                                   sample_kernels_after=options.sample_kernels_after,
+                                   fast_forward_kernels=options.gpu_fast_forward_kernels,
+                                   fast_forward_until=options.gpu_fast_forward_until,
+                                   fast_forward_warmup=options.gpu_fast_forward_warmup)
 
 #global_scheduler.shader_list = []
 
 gpu_driver = GPUComputeDriver(filename="kfd", num_gpus=options.num_gpus,
-                              global_scheduler=global_scheduler, isdGPU = options.dgpu, gfxVersion = options.gfx_version)
+                              global_scheduler=global_scheduler, isdGPU = options.dgpu, gfxVersion = options.gfx_version,
+                              largePages = options.gpu_large_pages)
 gpu_driver.device = []
 gpu_hsapp = []
 gpu_cmd_proc = []
@@ -632,6 +653,22 @@ for i in range(num_gpus):
     gpu_cmd_proc[i].pio = system.piobus.mem_side_ports
     gpu_hsapp[i].pio = system.piobus.mem_side_ports
 
+# The CP of each GPU preloads the kernel code into the SQCs of its GPU,
+# and the kernel arguments into its scalar caches
+if buildEnv['PROTOCOL'] == 'GPU_VIPER':
+    for i in range(num_gpus):
+        sqc_cntrls = [getattr(system.ruby, 'sqc_cntrl%d' % (i * num_sqc + j))
+                      for j in range(num_sqc)]
+        gpu_cmd_proc[i].sqc_prefetchers = [c.prefetcher for c in sqc_cntrls]
+        gpu_cmd_proc[i].sqc_preload_size = options.sqc_preload_size
+        scalar_cntrls = [getattr(system.ruby, 'scalar_cntrl%d' %
+                                 (i * num_scalar_cache + j))
+                         for j in range(num_scalar_cache)]
+        gpu_cmd_proc[i].scalar_prefetchers = \
+            [c.prefetcher for c in scalar_cntrls]
+        gpu_cmd_proc[i].preload_kernargs = options.preload_kernargs
+        gpu_cmd_proc[i].scalar_preload_size = options.scalar_preload_size
+
 global_scheduler.pio = system.piobus.mem_side_ports
 
 for i, dma_device in enumerate(dma_list):
@@ -251,10 +251,12 @@ for i in xrange(num_gpus):
 # these impl_kern_launch_rel and impl_kern_end_rel flags. The flag=true
 # means pipeline initiates a acquire/release operation at kernel launch/end.
 # VIPER protocol is write-through based, and thus only impl_kern_launch_acq
-# needs to set.
+# needs to set. With a write-back TCP (--WB_L1), each workgroup also
+# writes its dirty TCP lines back when it ends.
 for i in xrange(num_gpus):
     if (buildEnv['PROTOCOL'] == 'GPU_VIPER'):
         shader[i].impl_kern_launch_acq = True
+        shader[i].impl_wg_end_l1_rel = options.WB_L1
         shader[i].impl_kern_end_rel = True
     else:
         shader[i].impl_kern_launch_acq = True
@@ -0,0 +1,130 @@
+# Copyright (c) 2026 The gem5 multi-GPU authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#
+# Replays the GPU memory traces recorded with --coalescer-trace into a
+# GPU_VIPER Ruby system, without simulating the compute units. The Ruby
+# system has to be configured the same way as in the recording run, e.g.,
+# with the same number of GPUs and CUs, but its caches, network and
+# memory can be changed freely.
+#
+
+import m5
+from m5.objects import *
+from m5.defines import buildEnv
+from m5.util import addToPath
+import os, optparse, sys
+
+addToPath('../')
+
+from common import Options
+from ruby import Ruby
+
+#
+# Add the ruby specific and protocol specific options
+#
+parser = optparse.OptionParser()
+Options.addNoISAOptions(parser)
+Ruby.define_options(parser)
+
+parser.add_option("--trace-prefix", type="string", default="gpu_mem",
+                  help="Prefix of the traces recorded with "
+                  "--coalescer-trace, one <prefix>.<tcp>.trc.gz per CU")
+parser.add_option("--num-gpus", type="int", default=1,
+                  help="Number of GPUs (chiplets) in the recording run")
+parser.add_option("-u", "--num-compute-units", type="int", default=4,
+                  help="Number of CUs per GPU in the recording run")
+parser.add_option("--cu-per-sqc", type="int", default=4,
+                  help="Number of CUs sharing an SQC")
+parser.add_option("--cu-per-scalar-cache", type="int", default=4,
+                  help="Number of CUs sharing a scalar cache")
+parser.add_option("--max-cu-tokens", type="int", default=160,
+                  help="Number of requests a CU can have waiting in its "
+                  "coalescer's uncoalesced table")
+parser.add_option("--default-acq-rel", action="store_true", default=False,
+                  help="Use the default acquire/release latencies")
+
+(options, args) = parser.parse_args()
+
+if args:
+     print("Error: script doesn't take any positional arguments")
+     sys.exit(1)
+
+options.num_cpus = 0
+options.num_cp = 0
+
+n_CUs = options.num_gpus * options.num_compute_units
+
+assert(options.num_compute_units % options.cu_per_sqc == 0)
+options.num_sqc = options.num_compute_units // options.cu_per_sqc
+assert(options.cu_per_scalar_cache != 0)
+options.num_scalar_cache = \
+    options.num_compute_units // options.cu_per_scalar_cache
+
+traces = []
+for i in range(n_CUs):
+    trace = "%s.%d.trc.gz" % (options.trace_prefix, i)
+    if not os.path.isfile(trace):
+        print("Error: could not find trace %s" % trace)
+        sys.exit(1)
+    traces.append(trace)
+
+player = GPUMemTracePlayer(trace_files = traces,
+                           max_cu_tokens = options.max_cu_tokens)
+
+#
+# The system doesn't have real CPUs or CUs. It just has a player that has
+# physical ports to be connected to Ruby
+#
+system = System(cpu = player,
+                mem_ranges = [AddrRange(options.mem_size)],
+                cache_line_size = options.cacheline_size,
+                mem_mode = 'timing')
+
+system.voltage_domain = VoltageDomain(voltage = options.sys_voltage)
+system.clk_domain = SrcClockDomain(clock = options.sys_clock,
+                                   voltage_domain = system.voltage_domain)
+
+Ruby.create_system(options, False, system)
+
+#
+# The TCP coalescers are created first. The SQC and scalar cache
+# sequencers are left unconnected since the traces only hold vector
+# memory requests
+#
+for i, ruby_port in enumerate(system.ruby._cpu_ports[:n_CUs]):
+    ruby_port.using_ruby_tester = True
+    player.cu_vector_ports = ruby_port.in_ports
+    player.cu_token_ports = ruby_port.gmTokenPort
+
+root = Root(full_system = False, system = system)
+
+m5.instantiate()
+
+exit_event = m5.simulate()
+
+print('Exiting tick: ', m5.curTick())
+print('Exiting because ', exit_event.getCause())
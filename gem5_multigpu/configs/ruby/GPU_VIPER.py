@@ -40,6 +40,7 @@ from common import FileSystemConfig
 
 addToPath('../')
 
+from topologies.Chiplets import ChipletCluster
 from topologies.Cluster import Cluster
 from topologies.Crossbar import Crossbar
 
@@ -133,6 +134,7 @@ class TCPCache(RubyCache):
         self.assoc = options.tcp_assoc
         self.resourceStalls = options.no_tcc_resource_stalls
         self.replacement_policy = TreePLRURP()
+        self.flat_tag_store = options.flat_tag_store
 
 class TCPCntrl(TCP_Controller, CntrlBase):
 
@@ -170,6 +172,11 @@ class TCPCntrl(TCP_Controller, CntrlBase):
 
         self.use_seq_not_coal = False
 
+        self.prefetcher = GPUPrefetcher(
+            table_entries = options.tcp_prefetch_entries,
+            degree = options.tcp_prefetch_degree)
+        self.enable_prefetch = options.tcp_prefetch
+
         self.ruby_system = ruby_system
 
         if options.recycle_latency:
@@ -200,6 +207,9 @@ class TCPCntrl(TCP_Controller, CntrlBase):
 
         self.use_seq_not_coal = True
 
+        # The prefetcher needs the coalescer
+        self.prefetcher = GPUPrefetcher()
+
         self.ruby_system = ruby_system
 
         if options.recycle_latency:
@@ -215,6 +225,7 @@ class SQCCache(RubyCache):
         self.size = MemorySize(options.sqc_size)
         self.assoc = options.sqc_assoc
         self.replacement_policy = TreePLRURP()
+        self.flat_tag_store = options.flat_tag_store
 
 class SQCCntrl(SQC_Controller, CntrlBase):
 
@@ -236,6 +247,10 @@ class SQCCntrl(SQC_Controller, CntrlBase):
           self.sequencer.deadlock_threshold = \
             options.sqc_deadlock_threshold
 
+        self.prefetcher = GPUPrefetcher(
+            next_line = True,
+            degree = options.sqc_prefetch_degree)
+
         self.ruby_system = ruby_system
 
         if options.recycle_latency:
@@ -267,6 +282,12 @@ class TCC(RubyCache):
         self.start_index_bit = math.log(options.cacheline_size, 2) + \
                                math.log(options.num_tccs, 2)
         self.replacement_policy = TreePLRURP()
+        self.flat_tag_store = options.flat_tag_store
+        if options.tcc_compressor != "none":
+            compressors = { "BDI": BDI, "CPack": CPack, "FPC": FPC,
+                            "Zero": ZeroCompressor }
+            self.compressor = compressors[options.tcc_compressor]()
+            self.max_compression_ratio = options.tcc_compression_ratio
 
 
 class TCCCntrl(TCC_Controller, CntrlBase):
@@ -292,8 +313,16 @@ class TCCCntrl(TCC_Controller, CntrlBase):
         self.coalescer.is_cpu_sequencer = False
         self.coalescer.max_coalesces_per_cycle = \
             options.max_coalesces_per_cycle
+        # checkpoints only hold memory, so dirty TCC data is written back
+        self.coalescer.write_back_on_drain = True
         self.num_gpus = options.num_gpus
 
+        self.prefetcher = GPUPrefetcher(
+            region_size = options.tcc_prefetch_region,
+            degree = options.tcc_prefetch_degree)
+        self.enable_prefetch = options.tcc_prefetch
+        self.near_memory_atomics = options.near_memory_atomics
+
 class L3Cache(RubyCache):
     dataArrayBanks = 16
     tagArrayBanks = 16
@@ -311,6 +340,20 @@ class L3Cache(RubyCache):
         self.resourceStalls = False
         self.replacement_policy = TreePLRURP()
 
+class MALLCache(RubyCache):
+    """ The memory-side slice of a directory, shared by all the chiplets """
+    def create(self, options, ruby_system, system):
+        self.size = MemorySize(options.mall_size)
+        self.size.value /= options.num_dirs
+        self.assoc = options.mall_assoc
+        # The banks bound the bandwidth of the slice
+        self.dataArrayBanks = options.mall_banks
+        self.tagArrayBanks = options.mall_banks
+        self.dataAccessLatency = options.mall_latency
+        self.tagAccessLatency = options.mall_latency
+        self.resourceStalls = True
+        self.replacement_policy = TreePLRURP()
+
 class L3Cntrl(L3Cache_Controller, CntrlBase):
     def create(self, options, ruby_system, system):
         self.version = self.versionCount()
@@ -341,13 +384,18 @@ class DirCntrl(Directory_Controller, CntrlBase):
         self.addr_ranges = dir_ranges
         self.directory = RubyDirectoryMemory()
 
-        self.L3CacheMemory = L3Cache()
+        if options.mall:
+            self.L3CacheMemory = MALLCache()
+            self.L3MemorySide = True
+        else:
+            self.L3CacheMemory = L3Cache()
         self.L3CacheMemory.create(options, ruby_system, system)
 
         self.l3_hit_latency = max(self.L3CacheMemory.dataAccessLatency,
                                   self.L3CacheMemory.tagAccessLatency)
 
         self.number_of_TBEs = options.num_tbes
+        self.near_memory_atomics = options.near_memory_atomics
 
         self.ruby_system = ruby_system
 
@@ -375,6 +423,17 @@ def define_options(parser):
     parser.add_option("--no-tcc-resource-stalls", action = "store_false",
                       default = True)
     parser.add_option("--use-L3-on-WT", action = "store_true", default = False)
+    parser.add_option("--mall", action = "store_true", default = False,
+                      help = "Replace the directories' L3 with a memory-side "
+                      "cache shared by all chiplets that keeps the lines "
+                      "read from it and takes the TCC write-throughs")
+    parser.add_option("--mall-size", type = "string", default = "64MB",
+                      help = "Total size of the memory-side cache")
+    parser.add_option("--mall-assoc", type = "int", default = 16)
+    parser.add_option("--mall-banks", type = "int", default = 16,
+                      help = "Banks of each directory's memory-side cache")
+    parser.add_option("--mall-latency", type = "int", default = 20,
+                      help = "Tag and data latency of the memory-side cache")
     parser.add_option("--num-tbes", type = "int", default = 256)
     parser.add_option("--l2-latency", type = "int", default = 50)  # load to use
     parser.add_option("--num-tccs", type = "int", default = 1,
@@ -387,7 +446,8 @@ def define_options(parser):
                       help="Set the SQC deadlock threshold to some value")
 
     parser.add_option("--WB_L1", action = "store_true", default = False,
-                      help = "writeback L1")
+                      help = "writeback L1, written back at eviction, "
+                      "acquire and workgroup end")
     parser.add_option("--WB_L2", action = "store_true", default = True,
                       help = "writeback L2")
     parser.add_option("--TCP_latency", type = "int", default = 4,
@@ -422,6 +482,84 @@ def define_options(parser):
                       help="Data access latency in L2 cache")
     parser.add_option("--chiplet_dequeue_rate", type='int', default=0,
                       help="Deque latency for chiplet links")                      
+    parser.add_option("--flat-tag-store", action="store_true",
+                      default=False, help="Use per-set tag arrays instead "
+                      "of a global tag index in the GPU caches")
+    parser.add_option("--coalescer-trace", type='string', default="",
+                      help="Record the requests of each TCP's coalescer into "
+                      "<prefix>.<tcp>.trc.gz for GPUMemTracePlayer")
+    parser.add_option("--sorted-msg-buffers", action="store_true",
+                      default=False, help="Keep the messages of the "
+                      "controllers' buffers in sorted FIFOs and their "
+                      "stalled messages in hash maps")
+    parser.add_option("--wakeup-coalescing", action="store_true",
+                      default=False, help="Only wake the controllers up "
+                      "after a stalled transition when the stall can have "
+                      "cleared")
+    parser.add_option("--tcc-mapping", type="choice", default="interleave",
+                      choices=["interleave", "hashed", "home"],
+                      help="How lines map to TCC slices. interleave: the "
+                      "slice bits above the line offset; hashed: an XOR of "
+                      "the address bits above them; home: hashed, and the "
+                      "TCPs send their requests straight to the TCC of the "
+                      "chiplet a line is homed at")
+    parser.add_option("--chiplet-topology", type="choice",
+                      default="crossbar",
+                      choices=["crossbar"] + ChipletCluster.topologies,
+                      help="How the GPU chiplets are connected. crossbar: "
+                      "one router for all of them, with the inter-chiplet "
+                      "hop modeled as a fixed TCC latency; ring, mesh, "
+                      "full: a router per chiplet and bandwidth-limited "
+                      "links between them")
+    parser.add_option("--chiplet-link-bw", type="int", default=32,
+                      help="Bandwidth factor (bytes per cycle on the "
+                      "SimpleNetwork) of each direction of a chiplet link")
+    parser.add_option("--chiplet-link-latency", type="int", default=25,
+                      help="Latency in cycles of a chiplet link")
+    parser.add_option("--tcp-prefetch", action="store_true", default=False,
+                      help="Prefetch into the TCPs with a stride prefetcher "
+                      "trained on the PC and page of the loads")
+    parser.add_option("--tcp-prefetch-degree", type="int", default=4,
+                      help="Number of lines the TCP prefetcher runs ahead")
+    parser.add_option("--tcp-prefetch-entries", type="int", default=64,
+                      help="Number of strides the TCP prefetcher tracks")
+    parser.add_option("--sqc-prefetch", action="store_true", default=False,
+                      help="Prefetch the lines after the start of each "
+                      "instruction fetch stream into the SQCs")
+    parser.add_option("--sqc-prefetch-degree", type="int", default=4,
+                      help="Number of lines the SQC prefetcher sends per "
+                      "fetch stream")
+    parser.add_option("--sqc-preload-size", type="string", default="0B",
+                      help="Size of the kernel code the command processor "
+                      "preloads into the SQCs at dispatch, 0B to disable")
+    parser.add_option("--preload-kernargs", action="store_true",
+                      default=False,
+                      help="Preload the kernel arguments into the scalar "
+                      "caches once the launch invalidations are done")
+    parser.add_option("--scalar-preload-size", type="string",
+                      default="256B",
+                      help="Size of the start of each read-only buffer "
+                      "argument preloaded with the kernel arguments")
+    parser.add_option("--tcc-prefetch", action="store_true", default=False,
+                      help="Prefetch into the TCCs with a region prefetcher "
+                      "trained on the misses to the lines homed at them")
+    parser.add_option("--tcc-prefetch-degree", type="int", default=4,
+                      help="Number of lines the TCC prefetcher sends per "
+                      "miss")
+    parser.add_option("--tcc-prefetch-region", type="string", default="4kB",
+                      help="Size of the regions of the TCC prefetcher, at "
+                      "most a page")
+    parser.add_option("--tcc-compressor", type="choice", default="none",
+                      choices=["none", "BDI", "CPack", "FPC", "Zero"],
+                      help="Compress the TCC data array so that a way "
+                      "holds several lines of a super-block")
+    parser.add_option("--tcc-compression-ratio", type="int", default=4,
+                      help="Most lines a compressed TCC way holds")
+    parser.add_option("--near-memory-atomics", action="store_true",
+                      default=False,
+                      help="Run the system-scope atomics at the "
+                      "directories, sending them there directly from the "
+                      "TCCs and returning only the old values")
 
 def create_system(options, full_system, system, dma_devices, bootmem,
                   ruby_system):
@@ -487,7 +625,15 @@ def create_system(options, full_system, system, dma_devices, bootmem,
                                               intlvMatch = i)
             dir_ranges.append(addr_range)
 
-        dir_cntrl = DirCntrl(noTCCdir = True, TCC_select_num_bits = TCC_bits2)
+        if options.tcc_mapping == "interleave":
+            dir_cntrl = DirCntrl(noTCCdir = True,
+                                 TCC_select_num_bits = TCC_bits2)
+        else:
+            # Probe the slice a line hashes to on every chiplet
+            dir_cntrl = DirCntrl(noTCCdir = True,
+                                 TCC_select_num_bits = TCC_bits,
+                                 TCC_select_chiplets = num_gpus,
+                                 TCC_select_hashed = True)
         dir_cntrl.create(options, dir_ranges, ruby_system, system)
         dir_cntrl.number_of_TBEs = options.num_tbes
         dir_cntrl.useL3OnWT = options.use_L3_on_WT
@@ -616,11 +762,25 @@ def create_system(options, full_system, system, dma_devices, bootmem,
 
     gpuCluster = None
     if hasattr(options, 'bw_scalor') and options.bw_scalor > 0:
-      gpuCluster = Cluster(extBW = crossbar_bw, intBW = crossbar_bw)
+      gpu_bw = crossbar_bw
     else:
-      gpuCluster = Cluster(extBW = 8, intBW = 8) # 16 GB/s
+      gpu_bw = 8 # 16 GB/s
+    if options.chiplet_topology == "crossbar":
+        gpuCluster = Cluster(extBW = gpu_bw, intBW = gpu_bw)
+    else:
+        gpuCluster = ChipletCluster(options.chiplet_topology,
+                                    linkBW = options.chiplet_link_bw,
+                                    linkLatency = options.chiplet_link_latency,
+                                    extBW = gpu_bw, intBW = gpu_bw)
 
     for x in range(num_gpus):
+        # The cluster this chiplet's controllers are connected to
+        if options.chiplet_topology == "crossbar":
+            chipletCluster = gpuCluster
+        else:
+            chipletCluster = Cluster(extBW = gpu_bw, intBW = gpu_bw)
+            gpuCluster.addChiplet(chipletCluster)
+
         for i in range(options.num_compute_units):
 
             tcp_cntrl = TCPCntrl(TCC_select_num_bits = TCC_bits,
@@ -632,6 +792,10 @@ def create_system(options, full_system, system, dma_devices, bootmem,
             tcp_cntrl.disableL1 = options.noL1
             tcp_cntrl.L1cache.tagAccessLatency = options.TCP_latency
             tcp_cntrl.L1cache.dataAccessLatency = options.TCP_latency
+            if options.coalescer_trace:
+                tcp_cntrl.coalescer.trace_file = "%s.%d.trc.gz" % \
+                    (options.coalescer_trace,
+                     x*options.num_compute_units+i)
             exec("ruby_system.tcp_cntrl%d = tcp_cntrl" \
                  % (x*options.num_compute_units+i))
             #
@@ -639,6 +803,10 @@ def create_system(options, full_system, system, dma_devices, bootmem,
             #
             cpu_sequencers.append(tcp_cntrl.coalescer)
             tcp_cntrl_nodes.append(tcp_cntrl)
+            if i == 0:
+                # The TCCs replay their cache trace through this chiplet's
+                # first TCP when restoring from a checkpoint
+                chiplet_sequencer = tcp_cntrl.sequencer
 
             # Connect the TCP controller to the ruby network
             tcp_cntrl.requestFromTCP = MessageBuffer(ordered = True)
@@ -658,14 +826,16 @@ def create_system(options, full_system, system, dma_devices, bootmem,
 
             tcp_cntrl.mandatoryQueue = \
                 MessageBuffer(buffer_size=0)
+            tcp_cntrl.prefetchQueue = MessageBuffer()
 
-            gpuCluster.add(tcp_cntrl)
+            chipletCluster.add(tcp_cntrl)
 
         for i in range(options.num_sqc):
 
             sqc_cntrl = \
                 SQCCntrl(TCC_select_num_bits = TCC_bits, cluster_id = x)
             sqc_cntrl.create(options, ruby_system, system)
+            sqc_cntrl.enable_prefetch = options.sqc_prefetch
 
             exec("ruby_system.sqc_cntrl%d = sqc_cntrl" % (x*options.num_sqc+i))
             #
@@ -685,9 +855,10 @@ def create_system(options, full_system, system, dma_devices, bootmem,
 
             sqc_cntrl.mandatoryQueue = \
                 MessageBuffer(buffer_size=0)
+            sqc_cntrl.prefetchQueue = MessageBuffer()
 
             # SQC also in GPU cluster
-            gpuCluster.add(sqc_cntrl)
+            chipletCluster.add(sqc_cntrl)
 
         for i in range(options.num_scalar_cache):
             scalar_cntrl = \
@@ -710,8 +881,9 @@ def create_system(options, full_system, system, dma_devices, bootmem,
 
             scalar_cntrl.mandatoryQueue = \
                 MessageBuffer(buffer_size=options.scalar_buffer_size)
+            scalar_cntrl.prefetchQueue = MessageBuffer()
 
-            gpuCluster.add(scalar_cntrl)
+            chipletCluster.add(scalar_cntrl)
 
         for i in range(options.num_cp):
 
@@ -753,8 +925,9 @@ def create_system(options, full_system, system, dma_devices, bootmem,
 
             tcp_cntrl.mandatoryQueue = \
                 MessageBuffer(buffer_size=0)
+            tcp_cntrl.prefetchQueue = MessageBuffer()
 
-            gpuCluster.add(tcp_cntrl)
+            chipletCluster.add(tcp_cntrl)
 
             sqc_cntrl = \
                 SQCCntrl(TCC_select_num_bits = TCC_bits, cluster_id = x)
@@ -767,7 +940,7 @@ def create_system(options, full_system, system, dma_devices, bootmem,
             cpu_sequencers.append(sqc_cntrl.sequencer)
 
             # SQC also in GPU cluster
-            gpuCluster.add(sqc_cntrl)
+            chipletCluster.add(sqc_cntrl)
 
         for i in range(options.num_tccs):
 
@@ -775,10 +948,21 @@ def create_system(options, full_system, system, dma_devices, bootmem,
             tcc_cntrl.create(options, ruby_system, system)
             tcc_cntrl.l2_request_latency = options.gpu_to_dir_latency
             tcc_cntrl.l2_response_latency = options.TCC_latency
-            tcc_cntrl.inter_chiplet_request_latency = options.inter_chiplet_latency
+            if options.chiplet_topology == "crossbar":
+                tcc_cntrl.inter_chiplet_request_latency = \
+                    options.inter_chiplet_latency
+            else:
+                # The chiplet links model the hop
+                tcc_cntrl.inter_chiplet_request_latency = 1
             tcc_cntrl_nodes.append(tcc_cntrl)
             tcc_cntrl.WB = options.WB_L2
+            tcc_cntrl.warmup_sequencer = chiplet_sequencer
             tcc_cntrl.number_of_TBEs = 2560 * options.num_compute_units
+            # the cores ask this slice only for the lines that map to it
+            tcc_cntrl.prefetcher.slice = i
+            tcc_cntrl.prefetcher.slice_bits = TCC_bits
+            tcc_cntrl.prefetcher.slice_hashed = \
+                options.tcc_mapping != "interleave"
             # the number_of_TBEs is inclusive of TBEs below
 
             # Connect the TCC controllers to the ruby network
@@ -807,6 +991,7 @@ def create_system(options, full_system, system, dma_devices, bootmem,
 
             tcc_cntrl.mandatoryQueue = \
                 MessageBuffer(buffer_size=0)
+            tcc_cntrl.prefetchQueue = MessageBuffer()
 
             tcc_cntrl.requestFromTCC = MessageBuffer(ordered = True)
             tcc_cntrl.requestFromTCC.out_port = ruby_system.network.in_port
@@ -830,7 +1015,7 @@ def create_system(options, full_system, system, dma_devices, bootmem,
             #cpu_sequencers.append(tcc_cntrl.coalescer)
             # connect all of the wire buffers between L3 and dirs up
             # TCC cntrls added to the GPU cluster
-            gpuCluster.add(tcc_cntrl)
+            chipletCluster.add(tcc_cntrl)
 
         for i in range(x*2,x*2+2):
             dma_device = dma_devices[i]
@@ -849,7 +1034,7 @@ def create_system(options, full_system, system, dma_devices, bootmem,
             dma_cntrl.responseFromDir = MessageBuffer(buffer_size=0)
             dma_cntrl.responseFromDir.in_port = ruby_system.network.out_port
             dma_cntrl.mandatoryQueue = MessageBuffer(buffer_size = 0)
-            gpuCluster.add(dma_cntrl)
+            chipletCluster.add(dma_cntrl)
 
     '''
     for i, dma_device in enumerate(dma_devices):
@@ -895,4 +1080,23 @@ def create_system(options, full_system, system, dma_devices, bootmem,
 
     ruby_system.network.number_of_virtual_networks = 11
 
+    if options.sorted_msg_buffers:
+        for obj in system.descendants():
+            if isinstance(obj, MessageBuffer):
+                obj.sorted_fifo = True
+                obj.hashed_stall_map = True
+
+    if options.wakeup_coalescing:
+        for obj in system.descendants():
+            if isinstance(obj, RubyController):
+                obj.wakeup_coalescing = True
+
+    if options.tcc_mapping != "interleave":
+        for cntrl in tcp_cntrl_nodes:
+            cntrl.TCC_select_hashed = True
+            cntrl.TCC_select_home = options.tcc_mapping == "home"
+        for obj in system.descendants():
+            if isinstance(obj, SQC_Controller):
+                obj.TCC_select_hashed = True
+
     return (cpu_sequencers, dir_cntrl_nodes, mainCluster)
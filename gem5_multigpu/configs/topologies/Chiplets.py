@@ -0,0 +1,104 @@
+# Copyright (c) 2026 The gem5 multi-GPU authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import math
+
+from topologies.Cluster import Cluster
+
+class ChipletCluster(Cluster):
+    """ A cluster of chiplets, each of them a cluster of its own, that are
+        connected to each other by chiplet links as well as to the router
+        of this cluster.
+
+        The chiplets are linked in a ring, a 2D mesh or all to all. Every
+        chiplet link is a pair of one-way links with their own bandwidth
+        and latency, so the traffic between two chiplets queues at the
+        links of the path it takes, and on the SimpleNetwork is throttled
+        to the link bandwidth. The links to this cluster's router only
+        carry the traffic to the rest of the system; their routing weight
+        is raised so that no path between chiplets goes through them.
+    """
+
+    topologies = ["ring", "mesh", "full"]
+
+    def __init__(self, topology, linkBW=0, linkLatency=0, **kwargs):
+        assert(topology in self.topologies)
+        super(ChipletCluster, self).__init__(**kwargs)
+        self.topology = topology
+        self.linkBW = linkBW
+        self.linkLatency = linkLatency
+        self.chiplets = []
+
+    def addChiplet(self, chiplet):
+        """ Add a chiplet cluster, the chiplets are numbered in the order
+            they are added
+        """
+        self.chiplets.append(chiplet)
+        self.add(chiplet)
+
+    def chipletPairs(self):
+        """ The pairs of chiplets that have a link between them """
+        n = len(self.chiplets)
+        if self.topology == "full":
+            return [(i, j) for i in range(n) for j in range(i + 1, n)]
+        if self.topology == "ring":
+            if n <= 2:
+                return [(0, 1)] if n == 2 else []
+            return [(i, (i + 1) % n) for i in range(n)]
+
+        # The mesh is as square as the number of chiplets allows
+        rows = int(math.sqrt(n))
+        while n % rows:
+            rows -= 1
+        cols = n // rows
+        pairs = []
+        for i in range(n):
+            if (i % cols) + 1 < cols:
+                pairs.append((i, i + 1))
+            if i + cols < n:
+                pairs.append((i, i + cols))
+        return pairs
+
+    def makeTopology(self, options, network, IntLink, ExtLink, Router):
+        # A path through this cluster's router takes two links, give those
+        # links the weight of a path through every chiplet
+        for chiplet in self.chiplets:
+            if not chiplet.extWeight:
+                chiplet.extWeight = max(len(self.chiplets), 1)
+
+        super(ChipletCluster, self).makeTopology(options, network, IntLink,
+                                                 ExtLink, Router)
+
+        for (i, j) in self.chipletPairs():
+            for (src, dst) in ((i, j), (j, i)):
+                link = IntLink(link_id=self.num_int_links(),
+                               src_node=self.chiplets[src].router,
+                               dst_node=self.chiplets[dst].router)
+                if self.linkBW:
+                    link.bandwidth_factor = self.linkBW
+                if self.linkLatency:
+                    link.latency = self.linkLatency
+                network.int_links.append(link)
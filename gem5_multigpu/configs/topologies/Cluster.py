@@ -37,25 +37,28 @@ class Cluster(BaseTopology):
     _num_ext_links = 0
     _num_routers = 0
 
-    # Below methods for auto counting
-    @classmethod
-    def num_int_links(cls):
-        cls._num_int_links += 1
-        return cls._num_int_links - 1
-    @classmethod
-    def num_ext_links(cls):
-        cls._num_ext_links += 1
-        return cls._num_ext_links - 1
-    @classmethod
-    def num_routers(cls):
-        cls._num_routers += 1
-        return cls._num_routers - 1
-
-    def __init__(self, intBW=0, extBW=0, intLatency=0, extLatency=0):
+    # Below methods for auto counting, shared with the subclasses
+    @staticmethod
+    def num_int_links():
+        Cluster._num_int_links += 1
+        return Cluster._num_int_links - 1
+    @staticmethod
+    def num_ext_links():
+        Cluster._num_ext_links += 1
+        return Cluster._num_ext_links - 1
+    @staticmethod
+    def num_routers():
+        Cluster._num_routers += 1
+        return Cluster._num_routers - 1
+
+    def __init__(self, intBW=0, extBW=0, intLatency=0, extLatency=0,
+                 extWeight=0):
         """ internalBandwidth is bandwidth of all links within the cluster
             externalBandwidth is bandwidth from this cluster to any cluster
                 connecting to it.
             internal/externalLatency are similar
+            externalWeight is the routing weight of the links to the super
+                cluster
             **** When creating a cluster with sub-clusters, the sub-cluster
                  external bandwidth overrides the internal bandwidth of the
                  super cluster
@@ -66,6 +69,7 @@ class Cluster(BaseTopology):
         self.extBW = extBW
         self.intLatency = intLatency
         self.extLatency = extLatency
+        self.extWeight = extWeight
 
     def add(self, node):
         self.nodes.append(node)
@@ -79,7 +83,7 @@ class Cluster(BaseTopology):
         network.routers.append(self.router)
 
         for node in self.nodes:
-            if type(node) == Cluster:
+            if isinstance(node, Cluster):
                 node.makeTopology(options, network, IntLink,
                                   ExtLink, Router)
 
@@ -106,6 +110,10 @@ class Cluster(BaseTopology):
                     link_out.latency = self.intLatency
                     link_in.latency = self.intLatency
 
+                if node.extWeight:
+                    link_out.weight = node.extWeight
+                    link_in.weight = node.extWeight
+
                 network.int_links.append(link_out)
                 network.int_links.append(link_in)
             else:
@@ -122,5 +130,5 @@ class Cluster(BaseTopology):
                 network.ext_links.append(link)
 
     def __len__(self):
-        return len([i for i in self.nodes if type(i) != Cluster]) + \
-               sum([len(i) for i in self.nodes if type(i) == Cluster])
+        return len([i for i in self.nodes if not isinstance(i, Cluster)]) + \
+               sum([len(i) for i in self.nodes if isinstance(i, Cluster)])
@@ -68,6 +68,13 @@ class X86GPUTLB(ClockedObject):
                         '`master` is now called `mem_side_ports`')
     allocationPolicy = Param.Bool(True, "Allocate on an access")
     accessDistance = Param.Bool(False, "print accessDistance stats")
+    largePages = Param.Bool(False, "Use 2MB and 1GB entries for the "
+                            "large pages of the page table")
+    pageWalkCacheSize = Param.Int(0, "Entries of the cache of the upper "
+                                  "page table levels of a last level TLB, "
+                                  "0 for fixed latency page walks")
+    numWalkers = Param.Int(0, "Page walks a last level TLB does at once, "
+                           "0 for no limit")
 
 class TLBCoalescer(ClockedObject):
     type = "TLBCoalescer"
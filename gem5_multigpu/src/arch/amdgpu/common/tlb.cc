@@ -34,6 +34,7 @@
 
 #include "arch/amdgpu/common/tlb.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -72,32 +73,25 @@ namespace X86ISA
         assoc = p.assoc;
         assert(assoc <= size);
         numSets = size/assoc;
+        fatal_if(!isPowerOf2(numSets), "%s: the number of sets, %d, must "
+                 "be a power of 2", name(), numSets);
         allocationPolicy = p.allocationPolicy;
         hasMemSidePort = false;
         accessDistance = p.accessDistance;
+        largePages = p.largePages;
 
         tlb.assign(size, TlbEntry());
+        entryIndex.reserve(size);
 
-        freeList.resize(numSets);
-        entryList.resize(numSets);
-
-        for (int set = 0; set < numSets; ++set) {
-            for (int way = 0; way < assoc; ++way) {
-                int x = set * assoc + way;
-                freeList[set].push_back(&tlb.at(x));
-            }
-        }
+        wordsPerSet = divCeil(assoc, 64);
+        validBits.assign(numSets * wordsPerSet, 0);
+        usedBits.assign(numSets * wordsPerSet, 0);
+        std::fill(std::begin(numEntries), std::end(numEntries), 0);
 
         FA = (size == assoc);
 
-        /**
-         * @warning: the set-associative version assumes you have a
-         * fixed page size of 4KB.
-         * If the page size is greather than 4KB (as defined in the
-         * X86ISA::PageBytes), then there are various issues w/ the current
-         * implementation (you'd have the same 8KB page being replicated in
-         * different sets etc)
-         */
+        // The set of an entry is taken from its page number, whatever the
+        // size of its page
         setMask = numSets - 1;
 
         maxCoalescedReqs = p.maxOutstandingReqs;
@@ -113,6 +107,12 @@ namespace X86ISA
         missLatency1 = p.missLatency1;
         missLatency2 = p.missLatency2;
 
+        pageWalkCacheSize = p.pageWalkCacheSize;
+        numWalkers = p.numWalkers;
+        walkCache.reserve(pageWalkCacheSize);
+        walkCacheUses = 0;
+        activeWalks = 0;
+
         // create the response ports based on the number of connected ports
         for (size_t i = 0; i < p.port_cpu_side_ports_connection_count; ++i) {
             cpuSidePort.push_back(new CpuSidePort(csprintf("%s-port%d",
@@ -155,73 +155,154 @@ namespace X86ISA
         }
     }
 
+    const unsigned GpuTLB::pageShifts[GpuTLB::NumPageSizes] = {
+        PageShift, EmulationPageTable::LargePageShift,
+        EmulationPageTable::HugePageShift
+    };
+
+    int
+    GpuTLB::pageSizeIdx(unsigned log_bytes)
+    {
+        for (int i = 0; i < NumPageSizes; ++i) {
+            if (pageShifts[i] == log_bytes)
+                return i;
+        }
+        panic("Unsupported GPU TLB page size 2^%d\n", log_bytes);
+    }
+
+    void
+    GpuTLB::touch(int idx)
+    {
+        uint64_t *used = &usedBits[(idx / assoc) * wordsPerSet];
+        int way = idx % assoc;
+        used[way / 64] |= 1ULL << (way % 64);
+
+        for (int w = 0; w < wordsPerSet; ++w) {
+            uint64_t all = (w + 1) * 64 <= assoc ? ~0ULL :
+                                                   mask(assoc % 64);
+            if (used[w] != all)
+                return;
+        }
+
+        // Every way is recently used now, only this one stays so
+        std::fill(used, used + wordsPerSet, 0);
+        used[way / 64] = 1ULL << (way % 64);
+    }
+
+    int
+    GpuTLB::victimWay(int set) const
+    {
+        const uint64_t *valid = &validBits[set * wordsPerSet];
+        const uint64_t *used = &usedBits[set * wordsPerSet];
+
+        for (const uint64_t *bits : {valid, used}) {
+            for (int w = 0; w < wordsPerSet; ++w) {
+                uint64_t all = (w + 1) * 64 <= assoc ? ~0ULL :
+                                                       mask(assoc % 64);
+                if (bits[w] != all)
+                    return w * 64 + findLsbSet(~bits[w]);
+            }
+        }
+
+        // Only a single way is always recently used
+        return 0;
+    }
+
+    void
+    GpuTLB::invalidateEntry(int idx)
+    {
+        TlbEntry &entry = tlb[idx];
+        int size_idx = pageSizeIdx(entry.logBytes);
+        entryIndex.erase(entryKey(entry.vaddr, size_idx));
+        --numEntries[size_idx];
+
+        int word = (idx / assoc) * wordsPerSet + (idx % assoc) / 64;
+        uint64_t bit = 1ULL << ((idx % assoc) % 64);
+        validBits[word] &= ~bit;
+        usedBits[word] &= ~bit;
+    }
+
     TlbEntry*
     GpuTLB::insert(Addr vpn, TlbEntry &entry)
     {
-        TlbEntry *newEntry = nullptr;
-
         /**
-         * vpn holds the virtual page address
-         * The least significant bits are simply masked
+         * vpn holds the virtual page address, of a base page within the
+         * entry's page if that is larger
          */
-        int set = (vpn >> PageShift) & setMask;
+        int size_idx = pageSizeIdx(entry.logBytes);
+        Addr page = roundDown(vpn, entry.size());
 
-        if (!freeList[set].empty()) {
-            newEntry = freeList[set].front();
-            freeList[set].pop_front();
+        int idx;
+        auto it = entryIndex.find(entryKey(page, size_idx));
+        if (it != entryIndex.end()) {
+            idx = it->second;
         } else {
-            newEntry = entryList[set].back();
-            entryList[set].pop_back();
+            int set = (page >> entry.logBytes) & setMask;
+            idx = set * assoc + victimWay(set);
+            int word = set * wordsPerSet + (idx % assoc) / 64;
+            uint64_t bit = 1ULL << ((idx % assoc) % 64);
+            if (validBits[word] & bit)
+                invalidateEntry(idx);
+
+            validBits[word] |= bit;
+            entryIndex.emplace(entryKey(page, size_idx), idx);
+            ++numEntries[size_idx];
         }
 
+        TlbEntry *newEntry = &tlb[idx];
         *newEntry = entry;
-        newEntry->vaddr = vpn;
-        entryList[set].push_front(newEntry);
+        newEntry->vaddr = page;
+        touch(idx);
 
         return newEntry;
     }
 
-    GpuTLB::EntryList::iterator
-    GpuTLB::lookupIt(Addr va, bool update_lru)
+    int
+    GpuTLB::lookupIdx(Addr va, bool update_lru)
     {
-        int set = (va >> PageShift) & setMask;
+        for (int size_idx = 0; size_idx < NumPageSizes; ++size_idx) {
+            if (!numEntries[size_idx])
+                continue;
 
-        if (FA) {
-            assert(!set);
-        }
+            Addr page = roundDown(va, Addr(1) << pageShifts[size_idx]);
+            auto it = entryIndex.find(entryKey(page, size_idx));
+            if (it == entryIndex.end())
+                continue;
 
-        auto entry = entryList[set].begin();
-        for (; entry != entryList[set].end(); ++entry) {
-            int page_size = (*entry)->size();
+            DPRINTF(GPUTLB, "Matched vaddr %#x to entry starting at %#x "
+                    "with size %#x.\n", va, page, tlb[it->second].size());
 
-            if ((*entry)->vaddr <= va && (*entry)->vaddr + page_size > va) {
-                DPRINTF(GPUTLB, "Matched vaddr %#x to entry starting at %#x "
-                        "with size %#x.\n", va, (*entry)->vaddr, page_size);
+            if (update_lru)
+                touch(it->second);
 
-                if (update_lru) {
-                    entryList[set].push_front(*entry);
-                    entryList[set].erase(entry);
-                    entry = entryList[set].begin();
-                }
-
-                break;
-            }
+            return it->second;
         }
 
-        return entry;
+        return -1;
     }
 
     TlbEntry*
     GpuTLB::lookup(Addr va, bool update_lru)
     {
-        int set = (va >> PageShift) & setMask;
+        int idx = lookupIdx(va, update_lru);
 
-        auto entry = lookupIt(va, update_lru);
+        return idx < 0 ? nullptr : &tlb[idx];
+    }
 
-        if (entry == entryList[set].end())
-            return nullptr;
-        else
-            return *entry;
+    TlbEntry*
+    GpuTLB::newEntry(Process *p, Addr vaddr,
+                     const EmulationPageTable::Entry *pte)
+    {
+        unsigned shift = largePages ? p->pTable->pageShiftAt(vaddr) :
+                                      PageShift;
+        Addr page = roundDown(vaddr, Addr(1) << shift);
+        // The pte is the one of the base page that holds vaddr
+        Addr paddr = pte->paddr - (p->pTable->pageAlign(vaddr) - page);
+
+        TlbEntry *entry = new TlbEntry(p->pid(), page, paddr, false, false);
+        entry->logBytes = shift;
+
+        return entry;
     }
 
     void
@@ -229,13 +310,10 @@ namespace X86ISA
     {
         DPRINTF(GPUTLB, "Invalidating all entries.\n");
 
-        for (int i = 0; i < numSets; ++i) {
-            while (!entryList[i].empty()) {
-                TlbEntry *entry = entryList[i].front();
-                entryList[i].pop_front();
-                freeList[i].push_back(entry);
-            }
-        }
+        entryIndex.clear();
+        std::fill(validBits.begin(), validBits.end(), 0);
+        std::fill(usedBits.begin(), usedBits.end(), 0);
+        std::fill(std::begin(numEntries), std::end(numEntries), 0);
     }
 
     void
@@ -249,30 +327,21 @@ namespace X86ISA
     {
         DPRINTF(GPUTLB, "Invalidating all non global entries.\n");
 
-        for (int i = 0; i < numSets; ++i) {
-            for (auto entryIt = entryList[i].begin();
-                 entryIt != entryList[i].end();) {
-                if (!(*entryIt)->global) {
-                    freeList[i].push_back(*entryIt);
-                    entryList[i].erase(entryIt++);
-                } else {
-                    ++entryIt;
-                }
-            }
+        for (auto it = entryIndex.begin(); it != entryIndex.end();) {
+            int idx = it->second;
+            ++it;
+            if (!tlb[idx].global)
+                invalidateEntry(idx);
         }
     }
 
     void
     GpuTLB::demapPage(Addr va, uint64_t asn)
     {
+        int idx = lookupIdx(va, false);
 
-        int set = (va >> PageShift) & setMask;
-        auto entry = lookupIt(va, false);
-
-        if (entry != entryList[set].end()) {
-            freeList[set].push_back(*entry);
-            entryList[set].erase(entry);
-        }
+        if (idx >= 0)
+            invalidateEntry(idx);
     }
 
 
@@ -704,9 +773,11 @@ namespace X86ISA
             assert(entry);
 
             auto p = sender_state->tc->getProcessPtr();
-            sender_state->tlbEntry =
+            TlbEntry *hit_entry =
                 new TlbEntry(p->pid(), entry->vaddr, entry->paddr,
                              false, false);
+            hit_entry->logBytes = entry->logBytes;
+            sender_state->tlbEntry = hit_entry;
 
             if (update_stats) {
                 // the reqCnt has an entry per level, so its size tells us
@@ -941,16 +1012,29 @@ namespace X86ISA
                 if (update_stats)
                     stats.pageTableCycles -= (req_cnt*curTick());
 
-                TLBEvent *tlb_event = translationReturnEvent[virtPageAddr];
-                assert(tlb_event);
-                tlb_event->updateOutcome(PAGE_WALK);
-                schedule(tlb_event,
-                         curTick() + cyclesToTicks(Cycles(missLatency2)));
+                if (numWalkers && activeWalks >= numWalkers) {
+                    DPRINTF(GPUTLB, "No free walker, queue the walk for "
+                            "addr %#x\n", virtPageAddr);
+
+                    walkQueue.emplace(virtPageAddr, pkt);
+                    if (update_stats)
+                        stats.queuedWalks++;
+                } else {
+                    startWalk(virtPageAddr, pkt);
+                }
             }
         } else if (outcome == PAGE_WALK) {
             if (update_stats)
                 stats.pageTableCycles += (req_cnt*curTick());
 
+            // The walker is free for the next walk
+            --activeWalks;
+            if (!walkQueue.empty()) {
+                std::pair<Addr, PacketPtr> walk = walkQueue.front();
+                walkQueue.pop();
+                startWalk(walk.first, walk.second);
+            }
+
             // Need to access the page table and update the TLB
             DPRINTF(GPUTLB, "Doing a page walk for address %#x\n",
                     virtPageAddr);
@@ -976,9 +1060,7 @@ namespace X86ISA
                 DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
                         pte->paddr);
 
-                sender_state->tlbEntry =
-                    new TlbEntry(p->pid(), virtPageAddr, pte->paddr, false,
-                                 false);
+                sender_state->tlbEntry = newEntry(p, vaddr, pte);
             } else {
                 sender_state->tlbEntry = nullptr;
             }
@@ -994,6 +1076,90 @@ namespace X86ISA
         }
     }
 
+    const unsigned GpuTLB::walkLevelShifts[GpuTLB::NumWalkLevels] = {
+        39, 30, 21, 12
+    };
+
+    void
+    GpuTLB::startWalk(Addr virt_page_addr, PacketPtr pkt)
+    {
+        GpuTranslationState *sender_state =
+            safe_cast<GpuTranslationState*>(pkt->senderState);
+
+        Tick done = curTick() + cyclesToTicks(Cycles(missLatency2));
+        if (pageWalkCacheSize) {
+            done = walkDoneTick(sender_state->tc->getProcessPtr(),
+                                pkt->req->getVaddr());
+        }
+
+        DPRINTF(GPUTLB, "Page walk for addr %#x done @ tick %d\n",
+                virt_page_addr, done);
+
+        ++activeWalks;
+
+        TLBEvent *tlb_event = translationReturnEvent[virt_page_addr];
+        assert(tlb_event);
+        tlb_event->updateOutcome(PAGE_WALK);
+        schedule(tlb_event, done);
+    }
+
+    Tick
+    GpuTLB::walkDoneTick(Process *p, Addr vaddr)
+    {
+        // The walk ends at the level of the page it maps
+        unsigned page_shift = largePages ? p->pTable->pageShiftAt(vaddr) :
+                                           PageShift;
+        int leaf = 0;
+        while (walkLevelShifts[leaf] > page_shift)
+            ++leaf;
+
+        // Start below the deepest upper level entry in the cache
+        Tick tick = curTick();
+        int level = 0;
+        for (int l = leaf - 1; l >= 0; --l) {
+            auto it = walkCache.find(walkCacheKey(vaddr, l));
+            if (it != walkCache.end()) {
+                tick = std::max(tick, it->second.readyTick);
+                it->second.lastUse = ++walkCacheUses;
+                level = l + 1;
+                break;
+            }
+        }
+
+        if (level)
+            stats.pageWalkCacheHits++;
+        else
+            stats.pageWalkCacheMisses++;
+
+        Tick level_latency = cyclesToTicks(Cycles(divCeil(missLatency2,
+                                                          NumWalkLevels)));
+        for (; level <= leaf; ++level) {
+            tick += level_latency;
+            stats.pageTableReads++;
+            if (level < leaf)
+                walkCacheInsert(walkCacheKey(vaddr, level), tick);
+        }
+
+        return tick;
+    }
+
+    void
+    GpuTLB::walkCacheInsert(Addr key, Tick ready_tick)
+    {
+        // The cache is small, so the LRU entry is found by a scan
+        if (walkCache.size() >= (size_t)pageWalkCacheSize &&
+            !walkCache.count(key)) {
+            auto victim = walkCache.begin();
+            for (auto it = walkCache.begin(); it != walkCache.end(); ++it) {
+                if (it->second.lastUse < victim->second.lastUse)
+                    victim = it;
+            }
+            walkCache.erase(victim);
+        }
+
+        walkCache[key] = WalkCacheEntry{ready_tick, ++walkCacheUses};
+    }
+
     void
     GpuTLB::TLBEvent::process()
     {
@@ -1186,9 +1352,7 @@ namespace X86ISA
                     DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
                             pte->paddr);
 
-                    sender_state->tlbEntry =
-                        new TlbEntry(p->pid(), virt_page_addr,
-                                     pte->paddr, false, false);
+                    sender_state->tlbEntry = tlb->newEntry(p, vaddr, pte);
                 } else {
                     // If this was a prefetch, then do the normal thing if it
                     // was a successful translation.  Otherwise, send an empty
@@ -1199,8 +1363,7 @@ namespace X86ISA
                                 pte->paddr);
 
                         sender_state->tlbEntry =
-                            new TlbEntry(p->pid(), virt_page_addr,
-                                         pte->paddr, false, false);
+                            tlb->newEntry(p, vaddr, pte);
                     } else {
                         DPRINTF(GPUPrefetch, "Prefetch failed %#x\n",
                                 alignedVaddr);
@@ -1221,9 +1384,11 @@ namespace X86ISA
             assert(entry);
 
             auto p = sender_state->tc->getProcessPtr();
-            sender_state->tlbEntry =
+            TlbEntry *hit_entry =
                 new TlbEntry(p->pid(), entry->vaddr, entry->paddr,
                              false, false);
+            hit_entry->logBytes = entry->logBytes;
+            sender_state->tlbEntry = hit_entry;
         }
         // This is the function that would populate pkt->req with the paddr of
         // the translation. But if no translation happens (i.e Prefetch fails)
@@ -1450,7 +1615,13 @@ namespace X86ISA
                    "incoming reqs"),
           ADD_STAT(localLatency, "Avg. latency over incoming coalesced reqs"),
           ADD_STAT(avgReuseDistance, "avg. reuse distance over all pages (in "
-                   "ticks)")
+                   "ticks)"),
+          ADD_STAT(pageWalkCacheHits, "Page walks that hit in the page walk "
+                   "cache"),
+          ADD_STAT(pageWalkCacheMisses, "Page walks that missed in the page "
+                   "walk cache"),
+          ADD_STAT(pageTableReads, "Page table entries read by page walks"),
+          ADD_STAT(queuedWalks, "Page walks that waited for a free walker")
     {
         localLatency = localCycles / localNumTLBAccesses;
 
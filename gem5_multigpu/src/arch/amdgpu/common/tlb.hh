@@ -35,9 +35,10 @@
 #define __GPU_TLB_HH__
 
 #include <fstream>
-#include <list>
 #include <queue>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "arch/generic/tlb.hh"
@@ -49,6 +50,7 @@
 #include "base/statistics.hh"
 #include "base/stats/group.hh"
 #include "gpu-compute/compute_unit.hh"
+#include "mem/page_table.hh"
 #include "mem/port.hh"
 #include "mem/request.hh"
 #include "params/X86GPUTLB.hh"
@@ -57,6 +59,7 @@
 
 class BaseTLB;
 class Packet;
+class Process;
 class ThreadContext;
 
 namespace X86ISA
@@ -67,8 +70,6 @@ namespace X86ISA
       protected:
         friend class Walker;
 
-        typedef std::list<TlbEntry*> EntryList;
-
         uint32_t configAddress;
 
       public:
@@ -103,7 +104,8 @@ namespace X86ISA
         void setConfigAddress(uint32_t addr);
 
       protected:
-        EntryList::iterator lookupIt(Addr va, bool update_lru=true);
+        /** Get the index of the entry that maps an address, or -1 */
+        int lookupIdx(Addr va, bool update_lru=true);
         Walker *walker;
 
       public:
@@ -123,6 +125,12 @@ namespace X86ISA
         bool FA;
         Addr setMask;
 
+        /**
+         * Fill the TLB with the large pages of the page table, rather
+         * than with one entry per base page.
+         */
+        bool largePages;
+
         /**
          * Allocation Policy: true if we always allocate on a hit, false
          * otherwise. Default is true.
@@ -140,23 +148,99 @@ namespace X86ISA
          */
         bool accessDistance;
 
+        /**
+         * The entries, the ways of a set next to each other. An entry of
+         * a page of 2^n bytes goes in the set of its page number, the
+         * address bits from n up, so a large page has a single entry.
+         */
         std::vector<TlbEntry> tlb;
 
-        /*
-         * It's a per-set list. As long as we have not reached
-         * the full capacity of the given set, grab an entry from
-         * the freeList.
+        /**
+         * The index in tlb of every valid entry, by its page address with
+         * the page size in the low bits, so that a lookup only probes
+         * this map once per page size in use, whatever the
+         * associativity.
+         */
+        std::unordered_map<Addr, int> entryIndex;
+
+        /**
+         * A valid and a recently used bit per way, packed in words of 64
+         * ways, wordsPerSet words per set. A hit sets the used bit of its
+         * way, clearing the other used bits of the set when it would set
+         * them all, and a fill replaces the first invalid way or else
+         * the first way that is not recently used.
+         */
+        int wordsPerSet;
+        std::vector<uint64_t> validBits;
+        std::vector<uint64_t> usedBits;
+
+        static const int NumPageSizes = 3;
+        static const unsigned pageShifts[NumPageSizes];
+        // The valid entries of each page size
+        int numEntries[NumPageSizes];
+
+        static int pageSizeIdx(unsigned log_bytes);
+        static Addr
+        entryKey(Addr page, int size_idx)
+        {
+            return page | size_idx;
+        }
+
+        void touch(int idx);
+        int victimWay(int set) const;
+        void invalidateEntry(int idx);
+
+        /**
+         * Make the entry that translates an address from the page table,
+         * over the largest page the address is mapped on if largePages
+         * is set.
          */
-        std::vector<EntryList> freeList;
+        TlbEntry *newEntry(Process *p, Addr vaddr,
+                           const EmulationPageTable::Entry *pte);
 
         /**
-         * An entryList per set is the equivalent of an LRU stack;
-         * it's used to guide replacement decisions. The head of the list
-         * contains the MRU TLB entry of the given set. If the freeList
-         * for this set is empty, the last element of the list
-         * is evicted (i.e., dropped on the floor).
+         * The page walks of a last level TLB. Without a page walk cache
+         * a walk takes missLatency2 cycles. With one, missLatency2 is
+         * the latency of a walk of all four levels of the page table, a
+         * quarter of it per level, and a walk starts from the deepest
+         * level the cache has an entry for.
+         *
+         * The cache holds the PML4, PDP and PD entries that walks read,
+         * and holds them from the time a walk starts to read them, with
+         * the tick they are read at. So the walks of pages that share the
+         * upper levels, which come in bursts when the CUs touch fresh
+         * pages at once, wait for the one read of those levels instead of
+         * each reading them.
+         *
+         * At most numWalkers walks are in flight, 0 for no limit, the
+         * others wait in walkQueue.
          */
-        std::vector<EntryList> entryList;
+        struct WalkCacheEntry
+        {
+            Tick readyTick;
+            uint64_t lastUse;
+        };
+
+        int pageWalkCacheSize;
+        int numWalkers;
+        std::unordered_map<Addr, WalkCacheEntry> walkCache;
+        uint64_t walkCacheUses;
+
+        int activeWalks;
+        std::queue<std::pair<Addr, PacketPtr>> walkQueue;
+
+        static const int NumWalkLevels = 4;
+        static const unsigned walkLevelShifts[NumWalkLevels];
+
+        static Addr
+        walkCacheKey(Addr vaddr, int level)
+        {
+            return (vaddr >> walkLevelShifts[level]) << 2 | level;
+        }
+
+        void startWalk(Addr virt_page_addr, PacketPtr pkt);
+        Tick walkDoneTick(Process *p, Addr vaddr);
+        void walkCacheInsert(Addr key, Tick ready_tick);
 
         Fault translateInt(bool read, const RequestPtr &req,
                            ThreadContext *tc);
@@ -185,6 +269,10 @@ namespace X86ISA
         Tick doMmuRegRead(ThreadContext *tc, Packet *pkt);
         Tick doMmuRegWrite(ThreadContext *tc, Packet *pkt);
 
+        /**
+         * Add an entry, for the page that contains an address. A page
+         * that already has an entry has it replaced.
+         */
         TlbEntry *insert(Addr vpn, TlbEntry &entry);
 
         // Checkpointing
@@ -382,6 +470,11 @@ namespace X86ISA
             // I take the avg. per page and then
             // the avg. over all pages.
             Stats::Scalar avgReuseDistance;
+
+            Stats::Scalar pageWalkCacheHits;
+            Stats::Scalar pageWalkCacheMisses;
+            Stats::Scalar pageTableReads;
+            Stats::Scalar queuedWalks;
         } stats;
     };
 }
@@ -158,6 +158,7 @@ TLBCoalescer::updatePhysAddresses(PacketPtr pkt)
     Addr first_entry_vaddr = tlb_entry->vaddr;
     Addr first_entry_paddr = tlb_entry->paddr;
     int page_size = tlb_entry->size();
+    unsigned log_page_size = tlb_entry->logBytes;
     bool uncacheable = tlb_entry->uncacheable;
     int first_hit_level = sender_state->hitLevel;
 
@@ -195,9 +196,11 @@ TLBCoalescer::updatePhysAddresses(PacketPtr pkt)
             // update senderState->tlbEntry, so we can insert
             // the correct TLBEentry in the TLBs above.
             auto p = sender_state->tc->getProcessPtr();
-            sender_state->tlbEntry =
+            TheISA::TlbEntry *entry =
                 new TheISA::TlbEntry(p->pid(), first_entry_vaddr,
                     first_entry_paddr, false, false);
+            entry->logBytes = log_page_size;
+            sender_state->tlbEntry = entry;
 
             // update the hitLevel for all uncoalesced reqs
             // so that each packet knows where it hit
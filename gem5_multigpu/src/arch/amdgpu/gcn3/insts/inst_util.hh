@@ -294,6 +294,82 @@ namespace Gcn3ISA
         return (VecElemU32)(result >> 64) ? 1 : 0;
     }
 
+    /**
+     * lane-parallel VALU helpers. the source operands are copied into
+     * contiguous, aligned lane arrays and, when every lane is active, the
+     * operation is applied to all lanes without consulting the exec mask.
+     * this leaves a branch-free loop over plain arrays that the host
+     * compiler can vectorize using whichever SIMD extensions the build
+     * targets (e.g., AVX2 or AVX-512 with -march=native). the exec mask is
+     * applied as a masked store when vdst is written back to the VRF, so
+     * these helpers must only be used for operations whose only side
+     * effect is writing vdst.
+     *
+     * inactive lanes hold stale register data, which the operation must
+     * not see (e.g., a float to int conversion of a NaN or a shift by an
+     * out-of-range amount is undefined behavior on the host), so with a
+     * partial exec mask the loop keeps the per-lane exec check.
+     */
+    template<typename DstOp, typename Func>
+    inline void
+    laneOp(DstOp &vdst, Func op)
+    {
+        typename DstOp::ElemType *__restrict__ d = vdst.lanes();
+        const auto active = vdst.activeLanes();
+
+        if (active.all()) {
+            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                d[lane] = op(lane);
+            }
+        } else {
+            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                if (active[lane]) {
+                    d[lane] = op(lane);
+                }
+            }
+        }
+    }
+
+    template<typename DstOp, typename SrcOp, typename Func>
+    inline void
+    laneOp1(DstOp &vdst, const SrcOp &src, Func op)
+    {
+        alignas(64) typename SrcOp::ElemType s[NumVecElemPerVecReg];
+        src.readLanes(s);
+
+        laneOp(vdst, [&](int lane) { return op(s[lane]); });
+    }
+
+    template<typename DstOp, typename Src0Op, typename Src1Op, typename Func>
+    inline void
+    laneOp2(DstOp &vdst, const Src0Op &src0, const Src1Op &src1, Func op)
+    {
+        alignas(64) typename Src0Op::ElemType s0[NumVecElemPerVecReg];
+        alignas(64) typename Src1Op::ElemType s1[NumVecElemPerVecReg];
+        src0.readLanes(s0);
+        src1.readLanes(s1);
+
+        laneOp(vdst, [&](int lane) { return op(s0[lane], s1[lane]); });
+    }
+
+    template<typename DstOp, typename Src0Op, typename Src1Op,
+             typename Src2Op, typename Func>
+    inline void
+    laneOp3(DstOp &vdst, const Src0Op &src0, const Src1Op &src1,
+            const Src2Op &src2, Func op)
+    {
+        alignas(64) typename Src0Op::ElemType s0[NumVecElemPerVecReg];
+        alignas(64) typename Src1Op::ElemType s1[NumVecElemPerVecReg];
+        alignas(64) typename Src2Op::ElemType s2[NumVecElemPerVecReg];
+        src0.readLanes(s0);
+        src1.readLanes(s1);
+        src2.readLanes(s2);
+
+        laneOp(vdst, [&](int lane) {
+            return op(s0[lane], s1[lane], s2[lane]);
+        });
+    }
+
     /**
      * dppInstImpl is a helper function that performs the inputted operation
      * on the inputted vector register lane.  The returned output lane
@@ -3873,13 +3873,38 @@ namespace Gcn3ISA
              * the kernel end) then release operation is needed.
              */
 
+            // a write-back L1 writes the dirty lines of the workgroup back
+            // before the workgroup retires, and the kernel end release, if
+            // needed, follows
+            if (wf->computeUnit->shader->impl_wg_end_l1_rel &&
+                !wf->fastForward) {
+                setFlag(MemSync);
+                setFlag(GlobalSegment);
+                wf->setStatus(Wavefront::S_RETURNING);
+                gpuDynInst->simdId = wf->simdId;
+                gpuDynInst->wfSlotId = wf->wfSlotId;
+                gpuDynInst->wfDynId = wf->wfDynId;
+
+                DPRINTF(GPUExec, "inject L1 release for CU%d: "
+                                 "WF[%d][%d][%d]\n",
+                        wf->computeUnit->cu_id,
+                        wf->simdId, wf->wfSlotId, wf->wfDynId);
+
+                wf->computeUnit->doL1Release(gpuDynInst);
+                wf->computeUnit->stats.completedWGs++;
+
+                return;
+            }
+
             // check whether the workgroup is indicating the kernel end (i.e.,
             // the last workgroup in the kernel).
             bool kernelEnd =
                 wf->computeUnit->shader->dispatcher().isReachingKernelEnd(wf);
             // further check whether 'release @ kernel end' is needed
+            // fast-forwarded kernels leave no dirty data to release
             bool relNeeded =
-                wf->computeUnit->shader->impl_kern_end_rel;
+                wf->computeUnit->shader->impl_kern_end_rel &&
+                !wf->fastForward;
 
             // if not a kernel end or no release needed, retire the workgroup
             // directly
@@ -5510,11 +5535,9 @@ namespace Gcn3ISA
                 }
             }
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] + src1[lane];
-                }
-            }
+            laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+                return s0 + s1;
+            });
         }
 
         vdst.write();
@@ -5535,7 +5558,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUB_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5543,11 +5565,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 - s1;
+        });
 
         vdst.write();
     }
@@ -5567,7 +5587,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUBREV_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5575,11 +5594,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 - s0;
+        });
 
         vdst.write();
     }
@@ -5599,7 +5616,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MUL_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5607,11 +5623,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 * s1;
+        });
 
         vdst.write();
     }
@@ -5707,7 +5721,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MUL_I32_I24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -5715,11 +5728,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = szext<24>(src0[lane]) * szext<24>(src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return szext<24>(s0) * szext<24>(s1);
+        });
 
         vdst.write();
     }
@@ -5881,7 +5892,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5889,11 +5899,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmin(s0, s1);
+        });
 
         vdst.write();
     }
@@ -5913,7 +5921,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -5921,11 +5928,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmax(s0, s1);
+        });
 
         vdst.write();
     }
@@ -5944,7 +5949,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -5952,11 +5956,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -5975,7 +5977,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -5983,11 +5984,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -6006,7 +6005,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6014,11 +6012,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -6037,7 +6033,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6045,11 +6040,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -6069,7 +6062,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_LSHRREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6077,11 +6069,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -6101,7 +6091,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_ASHRREV_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -6109,11 +6098,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -6180,11 +6167,9 @@ namespace Gcn3ISA
 
             processSDWA_dst(extData.iFmt_VOP_SDWA, vdst, origVdst);
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
-                }
-            }
+            laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+                return s1 << bits(s0, 4, 0);
+            });
         }
 
         vdst.write();
@@ -6205,7 +6190,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_AND_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6213,11 +6197,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] & src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 & s1;
+        });
 
         vdst.write();
     }
@@ -6285,11 +6267,9 @@ namespace Gcn3ISA
 
             processSDWA_dst(extData.iFmt_VOP_SDWA, vdst, origVdst);
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] | src1[lane];
-                }
-            }
+            laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+                return s0 | s1;
+            });
         }
 
         vdst.write();
@@ -6310,7 +6290,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_XOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -6318,11 +6297,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 ^ s1;
+        });
 
         vdst.write();
     }
@@ -6405,7 +6382,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MADMK_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -6414,11 +6390,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], k, src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [&](auto s0, auto s1) {
+            return std::fma(s0, k, s1);
+        });
 
         vdst.write();
     }
@@ -6440,7 +6414,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MADAK_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -6449,11 +6422,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], k);
-            }
-        }
+        laneOp2(vdst, src0, src1, [&](auto s0, auto s1) {
+            return std::fma(s0, s1, k);
+        });
 
         vdst.write();
     }
@@ -6896,7 +6867,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_ADD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6904,11 +6874,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 + s1;
+        });
 
         vdst.write();
     }
@@ -6927,7 +6895,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUB_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6935,11 +6902,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 - s1;
+        });
 
         vdst.write();
     }
@@ -6958,7 +6923,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_SUBREV_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6966,11 +6930,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 - s0;
+        });
 
         vdst.write();
     }
@@ -6989,7 +6951,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MUL_LO_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -6997,11 +6958,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 * s1;
+        });
 
         vdst.write();
     }
@@ -7020,7 +6979,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_LSHLREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -7028,11 +6986,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 << bits(s0, 3, 0);
+        });
 
         vdst.write();
     }
@@ -7052,7 +7008,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_LSHRREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -7060,11 +7015,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> src0[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> s0;
+        });
 
         vdst.write();
     }
@@ -7084,7 +7037,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_ASHRREV_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -7092,11 +7044,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> src0[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> s0;
+        });
 
         vdst.write();
     }
@@ -7151,7 +7101,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -7159,11 +7108,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -7182,7 +7129,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MAX_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -7190,11 +7136,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -7213,7 +7157,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -7221,11 +7164,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -7244,7 +7185,6 @@ namespace Gcn3ISA
     void
     Inst_VOP2__V_MIN_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -7252,11 +7192,9 @@ namespace Gcn3ISA
         src0.readSrc();
         src1.read();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -7346,11 +7284,9 @@ namespace Gcn3ISA
                 }
             }
         } else {
-            for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src[lane];
-                }
-            }
+            laneOp1(vdst, src, [](auto s) {
+                return s;
+            });
         }
 
         vdst.write();
@@ -7450,17 +7386,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -7480,17 +7413,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -7510,17 +7440,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -7685,17 +7612,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_RPI_I32_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemI32)std::floor(src[lane] + 0.5);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemI32)std::floor(s + 0.5);
+        });
 
         vdst.write();
     }
@@ -7716,17 +7640,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_FLR_I32_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemI32)std::floor(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemI32)std::floor(s);
+        });
 
         vdst.write();
     }
@@ -7764,17 +7685,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -7794,17 +7712,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -7824,17 +7739,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE0::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 7, 0));
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)(bits(s, 7, 0));
+        });
 
         vdst.write();
     }
@@ -7854,17 +7766,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE1::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 15, 8));
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)(bits(s, 15, 8));
+        });
 
         vdst.write();
     }
@@ -7884,17 +7793,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE2::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 23, 16));
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)(bits(s, 23, 16));
+        });
 
         vdst.write();
     }
@@ -7914,17 +7820,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE3::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 31, 24));
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)(bits(s, 31, 24));
+        });
 
         vdst.write();
     }
@@ -7990,17 +7893,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CVT_F64_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -8020,17 +7920,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_TRUNC_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::trunc(s);
+        });
 
         vdst.write();
     }
@@ -8050,17 +7947,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CEIL_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::ceil(s);
+        });
 
         vdst.write();
     }
@@ -8080,17 +7974,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_RNDNE_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = roundNearestEven(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return roundNearestEven(s);
+        });
 
         vdst.write();
     }
@@ -8110,17 +8001,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FLOOR_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::floor(s);
+        });
 
         vdst.write();
     }
@@ -8171,17 +8059,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_TRUNC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst (gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::trunc(s);
+        });
 
         vdst.write();
     }
@@ -8201,17 +8086,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_CEIL_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::ceil(s);
+        });
 
         vdst.write();
     }
@@ -8231,17 +8113,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_RNDNE_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = roundNearestEven(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return roundNearestEven(s);
+        });
 
         vdst.write();
     }
@@ -8261,17 +8140,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FLOOR_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::floor(s);
+        });
 
         vdst.write();
     }
@@ -8291,17 +8167,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_EXP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::pow(2.0, src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::pow(2.0, s);
+        });
 
         vdst.write();
     }
@@ -8321,17 +8194,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_LOG_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::log2(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::log2(s);
+        });
 
         vdst.write();
     }
@@ -8524,17 +8394,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_SQRT_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -8554,17 +8421,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_SQRT_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -8656,17 +8520,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_NOT_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return ~s;
+        });
 
         vdst.write();
     }
@@ -8686,17 +8547,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_BFREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = reverseBits(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return reverseBits(s);
+        });
 
         vdst.write();
     }
@@ -8716,17 +8574,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FFBH_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = findFirstOneMsb(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return findFirstOneMsb(s);
+        });
 
         vdst.write();
     }
@@ -8746,17 +8601,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FFBL_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = findFirstOne(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return findFirstOne(s);
+        });
 
         vdst.write();
     }
@@ -8776,17 +8628,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_FFBH_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = firstOppositeSignBit(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return firstOppositeSignBit(s);
+        });
 
         vdst.write();
     }
@@ -9344,17 +9193,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_EXP_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::pow(2.0, src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::pow(2.0, s);
+        });
 
         vdst.write();
     }
@@ -9374,17 +9220,14 @@ namespace Gcn3ISA
     void
     Inst_VOP1__V_LOG_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::log2(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::log2(s);
+        });
 
         vdst.write();
     }
@@ -23169,7 +23012,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ADD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23199,11 +23041,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 + s1;
+        });
 
         vdst.write();
     }
@@ -23223,7 +23063,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUB_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23253,11 +23092,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 - s1;
+        });
 
         vdst.write();
     }
@@ -23277,7 +23114,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUBREV_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23307,11 +23143,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 - s0;
+        });
 
         vdst.write();
     }
@@ -23528,7 +23362,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MUL_I32_I24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -23546,11 +23379,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = szext<24>(src0[lane]) * szext<24>(src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return szext<24>(s0) * szext<24>(s1);
+        });
 
         vdst.write();
     }
@@ -23613,7 +23444,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MUL_U32_U24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23631,11 +23461,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = bits(src0[lane], 23, 0) * bits(src1[lane], 23, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return bits(s0, 23, 0) * bits(s1, 23, 0);
+        });
 
         vdst.write();
     }
@@ -23698,7 +23526,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23728,11 +23555,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmin(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23752,7 +23577,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -23782,11 +23606,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmax(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23805,7 +23627,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -23823,11 +23644,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23846,7 +23665,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -23864,11 +23682,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23887,7 +23703,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23905,11 +23720,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23928,7 +23741,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23946,11 +23758,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -23970,7 +23780,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHRREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -23988,11 +23797,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -24012,7 +23819,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ASHRREV_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -24030,11 +23836,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -24053,7 +23857,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHLREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24071,11 +23874,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 << bits(s0, 4, 0);
+        });
 
         vdst.write();
     }
@@ -24095,7 +23896,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_AND_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24113,11 +23913,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] & src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 & s1;
+        });
 
         vdst.write();
     }
@@ -24137,7 +23935,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_OR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24155,11 +23952,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] | src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 | s1;
+        });
 
         vdst.write();
     }
@@ -24179,7 +23974,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_XOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -24197,11 +23991,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 ^ s1;
+        });
 
         vdst.write();
     }
@@ -24660,7 +24452,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ADD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24678,11 +24469,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 + s1;
+        });
 
         vdst.write();
     }
@@ -24701,7 +24490,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUB_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24719,11 +24507,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 - s1;
+        });
 
         vdst.write();
     }
@@ -24742,7 +24528,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SUBREV_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24760,11 +24545,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 - s0;
+        });
 
         vdst.write();
     }
@@ -24783,7 +24566,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MUL_LO_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24801,11 +24583,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s0 * s1;
+        });
 
         vdst.write();
     }
@@ -24824,7 +24604,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHLREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24842,11 +24621,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 << bits(s0, 3, 0);
+        });
 
         vdst.write();
     }
@@ -24866,7 +24643,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHRREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -24890,11 +24666,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 3, 0);
+        });
 
         vdst.write();
     }
@@ -24914,7 +24688,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_ASHRREV_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -24932,11 +24705,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 3, 0);
+        });
 
         vdst.write();
     }
@@ -24991,7 +24762,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -25015,11 +24785,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -25038,7 +24806,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -25062,11 +24829,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::max(s0, s1);
+        });
 
         vdst.write();
     }
@@ -25085,7 +24850,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -25109,11 +24873,9 @@ namespace Gcn3ISA
             src1.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
 
         vdst.write();
     }
@@ -25132,7 +24894,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -25152,16 +24913,14 @@ namespace Gcn3ISA
             src0.negModifier();
         }
 
-        if (extData.NEG & 0x2) {
-            src1.negModifier();
-        }
-
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+        if (extData.NEG & 0x2) {
+            src1.negModifier();
         }
 
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::min(s0, s1);
+        });
+
         vdst.write();
     }
 
@@ -25215,17 +24974,14 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MOV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return s;
+        });
 
         vdst.write();
     }
@@ -25297,7 +25053,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25311,11 +25066,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -25335,7 +25088,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         VecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25351,11 +25103,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -25375,7 +25125,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25389,11 +25138,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -25582,7 +25329,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_RPI_I32_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
 
@@ -25596,11 +25342,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemI32)std::floor(src[lane] + 0.5);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemI32)std::floor(s + 0.5);
+        });
 
         vdst.write();
     }
@@ -25621,7 +25365,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_FLR_I32_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
 
@@ -25635,11 +25378,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemI32)std::floor(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemI32)std::floor(s);
+        });
 
         vdst.write();
     }
@@ -25677,7 +25418,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25699,11 +25439,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)s;
+        });
 
         vdst.write();
     }
@@ -25723,7 +25461,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25745,11 +25482,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -25769,7 +25504,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE0::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25783,11 +25517,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 7, 0);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)bits(s, 7, 0);
+        });
 
         vdst.write();
     }
@@ -25807,7 +25539,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE1::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25821,11 +25552,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 15, 8);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)bits(s, 15, 8);
+        });
 
         vdst.write();
     }
@@ -25845,7 +25574,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE2::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25859,11 +25587,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 23, 16);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)bits(s, 23, 16);
+        });
 
         vdst.write();
     }
@@ -25883,7 +25609,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE3::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -25897,11 +25622,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 31, 24);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF32)bits(s, 31, 24);
+        });
 
         vdst.write();
     }
@@ -25975,7 +25698,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CVT_F64_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -25989,11 +25711,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return (VecElemF64)s;
+        });
 
         vdst.write();
     }
@@ -26013,7 +25733,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_TRUNC_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26027,11 +25746,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::trunc(s);
+        });
 
         vdst.write();
     }
@@ -26051,7 +25768,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CEIL_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26065,11 +25781,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::ceil(s);
+        });
 
         vdst.write();
     }
@@ -26089,7 +25803,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_RNDNE_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26103,11 +25816,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = roundNearestEven(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return roundNearestEven(s);
+        });
 
         vdst.write();
     }
@@ -26127,7 +25838,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FLOOR_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26141,11 +25851,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::floor(s);
+        });
 
         vdst.write();
     }
@@ -26204,7 +25912,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_TRUNC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26218,11 +25925,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::trunc(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::trunc(s);
+        });
 
         vdst.write();
     }
@@ -26242,7 +25947,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_CEIL_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26256,11 +25960,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ceil(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::ceil(s);
+        });
 
         vdst.write();
     }
@@ -26280,7 +25982,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_RNDNE_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26294,11 +25995,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = roundNearestEven(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return roundNearestEven(s);
+        });
 
         vdst.write();
     }
@@ -26318,7 +26017,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FLOOR_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26332,11 +26030,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::floor(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::floor(s);
+        });
 
         vdst.write();
     }
@@ -26356,7 +26052,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_EXP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26370,11 +26065,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::pow(2.0, src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::pow(2.0, s);
+        });
 
         vdst.write();
     }
@@ -26394,7 +26087,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LOG_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26416,11 +26108,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::log2(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::log2(s);
+        });
 
         vdst.write();
     }
@@ -26652,7 +26342,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SQRT_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -26666,11 +26355,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -26690,7 +26377,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SQRT_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -26704,11 +26390,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sqrt(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::sqrt(s);
+        });
 
         vdst.write();
     }
@@ -26728,7 +26412,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         ConstScalarOperandF32 pi(gpuDynInst, REG_PI);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -26744,11 +26427,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::sin(src[lane] * 2 * pi.rawData());
-            }
-        }
+        laneOp1(vdst, src, [&](auto s) {
+            return std::sin(s * 2 * pi.rawData());
+        });
 
         vdst.write();
     }
@@ -26768,7 +26449,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_COS_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         ConstScalarOperandF32 pi(gpuDynInst, REG_PI);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -26784,11 +26464,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::cos(src[lane] * 2 * pi.rawData());
-            }
-        }
+        laneOp1(vdst, src, [&](auto s) {
+            return std::cos(s * 2 * pi.rawData());
+        });
 
         vdst.write();
     }
@@ -26808,17 +26486,14 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_NOT_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~src[lane];
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return ~s;
+        });
 
         vdst.write();
     }
@@ -26838,17 +26513,14 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BFREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = reverseBits(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return reverseBits(s);
+        });
 
         vdst.write();
     }
@@ -26868,7 +26540,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FFBH_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
@@ -26882,11 +26553,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = findFirstOneMsb(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return findFirstOneMsb(s);
+        });
 
         vdst.write();
     }
@@ -26906,7 +26575,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FFBL_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
@@ -26920,11 +26588,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = findFirstOne(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return findFirstOne(s);
+        });
 
         vdst.write();
     }
@@ -26944,7 +26610,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FFBH_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
@@ -26958,11 +26623,9 @@ namespace Gcn3ISA
             src.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = firstOppositeSignBit(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return firstOppositeSignBit(s);
+        });
 
         vdst.write();
     }
@@ -27551,7 +27214,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_EXP_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -27573,11 +27235,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::pow(2.0, src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::pow(2.0, s);
+        });
 
         vdst.write();
     }
@@ -27597,17 +27257,14 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LOG_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::log2(src[lane]);
-            }
-        }
+        laneOp1(vdst, src, [](auto s) {
+            return std::log2(s);
+        });
 
         vdst.write();
     }
@@ -27628,7 +27285,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -27662,11 +27318,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -27687,7 +27341,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -27721,11 +27374,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28046,7 +27697,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FMA_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -28080,11 +27730,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28105,7 +27753,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_FMA_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF64 src2(gpuDynInst, extData.SRC2);
@@ -28139,11 +27786,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28606,7 +28251,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MED3_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -28640,11 +28284,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return median(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28663,7 +28305,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MED3_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandI32 src2(gpuDynInst, extData.SRC2);
@@ -28683,11 +28324,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return median(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28706,7 +28345,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MED3_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -28726,11 +28364,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return median(s0, s1, s2);
+        });
 
         vdst.write();
     }
@@ -28899,7 +28535,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_SAD_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -28919,11 +28554,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::abs(src0[lane] - src1[lane]) + src2[lane];
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::abs(s0 - s1) + s2;
+        });
 
         vdst.write();
     }
@@ -29343,11 +28976,9 @@ namespace Gcn3ISA
             src2.negModifier();
         }
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return std::fma(s0, s1, s2);
+        });
 
         //vdst.write();
     } // execute
@@ -29622,7 +29253,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src2(gpuDynInst, extData.SRC2);
@@ -29642,11 +29272,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane] + src2[lane];
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return s0 * s1 + s2;
+        });
 
         vdst.write();
     }
@@ -29667,7 +29295,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAD_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandI16 src2(gpuDynInst, extData.SRC2);
@@ -29687,11 +29314,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane] + src2[lane];
-            }
-        }
+        laneOp3(vdst, src0, src1, src2, [](auto s0, auto s1, auto s2) {
+            return s0 * s1 + s2;
+        });
 
         vdst.write();
     }
@@ -30165,7 +29790,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MIN_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
@@ -30195,11 +29819,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmin(s0, s1);
+        });
 
         vdst.write();
     }
@@ -30219,7 +29841,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_MAX_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
@@ -30249,11 +29870,9 @@ namespace Gcn3ISA
         assert(!(instData.ABS & 0x4));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::fmax(s0, s1);
+        });
 
         vdst.write();
     }
@@ -30463,7 +30082,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LDEXP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -30479,11 +30097,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::ldexp(src0[lane], src1[lane]);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return std::ldexp(s0, s1);
+        });
 
         vdst.write();
     }
@@ -30582,7 +30198,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_BCNT_U32_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -30600,11 +30215,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = popCount(src0[lane]) + src1[lane];
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return popCount(s0) + s1;
+        });
 
         vdst.write();
     }
@@ -30737,11 +30350,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 5, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 << bits(s0, 5, 0);
+        });
 
         vdst.write();
     }
@@ -30761,7 +30372,6 @@ namespace Gcn3ISA
     void
     Inst_VOP3__V_LSHRREV_B64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU64 src1(gpuDynInst, extData.SRC1);
         VecOperandU64 vdst(gpuDynInst, instData.VDST);
@@ -30779,11 +30389,9 @@ namespace Gcn3ISA
         assert(!(extData.NEG & 0x2));
         assert(!(extData.NEG & 0x4));
 
-        for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 5, 0);
-            }
-        }
+        laneOp2(vdst, src0, src1, [](auto s0, auto s1) {
+            return s1 >> bits(s0, 5, 0);
+        });
 
         vdst.write();
     }
@@ -33859,6 +33859,7 @@ namespace Gcn3ISA
 
         int numDstRegOperands() override { return 1; }
         int numSrcRegOperands() override { return 1; }
+        int ldsReadDWords() const override { return 2; }
 
         int
         getOperandSize(int opIdx) override
@@ -35275,6 +35276,7 @@ namespace Gcn3ISA
 
         int numDstRegOperands() override { return 1; }
         int numSrcRegOperands() override { return 1; }
+        int ldsReadDWords() const override { return 3; }
 
         int
         getOperandSize(int opIdx) override
@@ -35309,6 +35311,7 @@ namespace Gcn3ISA
 
         int numDstRegOperands() override { return 1; }
         int numSrcRegOperands() override { return 1; }
+        int ldsReadDWords() const override { return 4; }
 
         int
         getOperandSize(int opIdx) override
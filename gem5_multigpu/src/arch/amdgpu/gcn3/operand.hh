@@ -34,6 +34,7 @@
 #ifndef __ARCH_GCN3_OPERAND_HH__
 #define __ARCH_GCN3_OPERAND_HH__
 
+#include <algorithm>
 #include <array>
 
 #include "arch/amdgpu/gcn3/gpu_registers.hh"
@@ -103,6 +104,8 @@ namespace Gcn3ISA
             "Incorrect number of DWORDS for GCN3 operand.");
 
       public:
+        typedef DataType ElemType;
+
         VecOperand() = delete;
 
         VecOperand(GPUDynInstPtr gpuDynInst, int opIdx)
@@ -314,6 +317,88 @@ namespace Gcn3ISA
             return vecReg.template as<DataType>()[idx];
         }
 
+        /**
+         * copy all lanes of this operand into a contiguous array, with
+         * any abs/neg modifiers applied. scalar sources (regs or inline
+         * constants) are broadcast to every lane. this is used by the
+         * lane-parallel VALU helpers (see inst_util.hh), which operate
+         * on plain arrays so the host compiler can vectorize them, as
+         * opposed to going through operator[] one lane at a time.
+         */
+        template<bool Condition = NumDwords == 1 || NumDwords == 2>
+        typename std::enable_if_t<Condition, void>
+        readLanes(DataType *lanes) const
+        {
+            if (scalar) {
+                DataType val = scRegData.rawData();
+
+                if (absMod) {
+                    assert(std::is_floating_point<DataType>::value);
+                    val = std::fabs(val);
+                }
+
+                if (negMod) {
+                    assert(std::is_floating_point<DataType>::value);
+                    val = -val;
+                }
+
+                std::fill_n(lanes, NumVecElemPerVecReg, val);
+                return;
+            }
+
+            const DataType *vgpr = vecReg.template raw_ptr<DataType>();
+            std::copy_n(vgpr, NumVecElemPerVecReg, lanes);
+
+            if (absMod) {
+                assert(std::is_floating_point<DataType>::value);
+                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                    lanes[lane] = std::fabs(lanes[lane]);
+                }
+            }
+
+            if (negMod) {
+                assert(std::is_floating_point<DataType>::value);
+                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                    lanes[lane] = -lanes[lane];
+                }
+            }
+        }
+
+        /**
+         * direct access to the contiguous lane storage of a destination
+         * operand. the exec mask is applied when the data are written
+         * back to the VRF in write(), so callers may compute every lane
+         * unconditionally as long as the operation has no side effects.
+         */
+        template<bool Condition = (NumDwords == 1 || NumDwords == 2) && !Const>
+        typename std::enable_if_t<Condition, DataType*>
+        lanes()
+        {
+            assert(!scalar);
+
+            return vecReg.template raw_ptr<DataType>();
+        }
+
+        /**
+         * the lanes that write() copies back to the VRF, i.e., the exec
+         * mask, or every lane if the instruction ignores it.
+         */
+        VectorMask
+        activeLanes() const
+        {
+            assert(_gpuDynInst);
+            assert(_gpuDynInst->wavefront());
+
+            if (_gpuDynInst->ignoreExec()) {
+                return VectorMask().set();
+            }
+
+            Wavefront *wf = _gpuDynInst->wavefront();
+
+            return _gpuDynInst->isLoad() ? _gpuDynInst->exec_mask
+                : wf->execMask();
+        }
+
         private:
           /**
            * if we determine that this operand is a scalar (reg or constant)
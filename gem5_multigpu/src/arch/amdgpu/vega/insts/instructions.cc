@@ -4287,13 +4287,38 @@ namespace VegaISA
              * needed
              */
 
+            // a write-back L1 writes the dirty lines of the workgroup back
+            // before the workgroup retires, and the kernel end release, if
+            // needed, follows
+            if (wf->computeUnit->shader->impl_wg_end_l1_rel &&
+                !wf->fastForward) {
+                setFlag(MemSync);
+                setFlag(GlobalSegment);
+                wf->setStatus(Wavefront::S_RETURNING);
+                gpuDynInst->simdId = wf->simdId;
+                gpuDynInst->wfSlotId = wf->wfSlotId;
+                gpuDynInst->wfDynId = wf->wfDynId;
+
+                DPRINTF(GPUExec, "inject L1 release for CU%d: "
+                                 "WF[%d][%d][%d]\n",
+                        wf->computeUnit->cu_id,
+                        wf->simdId, wf->wfSlotId, wf->wfDynId);
+
+                wf->computeUnit->doL1Release(gpuDynInst);
+                wf->computeUnit->stats.completedWGs++;
+
+                return;
+            }
+
             //check whether the workgroup is indicating the kernel end, i.e.,
             //the last workgroup in the kernel
             bool kernelEnd =
                 wf->computeUnit->shader->dispatcher().isReachingKernelEnd(wf);
 
+            // fast-forwarded kernels leave no dirty data to release
             bool relNeeded =
-                wf->computeUnit->shader->impl_kern_end_rel;
+                wf->computeUnit->shader->impl_kern_end_rel &&
+                !wf->fastForward;
 
             //if it is not a kernel end, then retire the workgroup directly
             if (!kernelEnd || !relNeeded) {
@@ -34283,6 +34283,7 @@ namespace VegaISA
 
         int numDstRegOperands() override { return 1; }
         int numSrcRegOperands() override { return 1; }
+        int ldsReadDWords() const override { return 2; }
 
         int
         getOperandSize(int opIdx) override
@@ -35699,6 +35700,7 @@ namespace VegaISA
 
         int numDstRegOperands() override { return 1; }
         int numSrcRegOperands() override { return 1; }
+        int ldsReadDWords() const override { return 3; }
 
         int
         getOperandSize(int opIdx) override
@@ -35733,6 +35735,7 @@ namespace VegaISA
 
         int numDstRegOperands() override { return 1; }
         int numSrcRegOperands() override { return 1; }
+        int ldsReadDWords() const override { return 4; }
 
         int
         getOperandSize(int opIdx) override
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/gpu_mem_trace/gpu_mem_trace_player.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "debug/GPUMemTracePlayer.hh"
+#include "mem/request.hh"
+#include "proto/protoio.hh"
+#include "sim/core.hh"
+#include "sim/sim_exit.hh"
+#include "sim/system.hh"
+
+GPUMemTracePlayer::GPUMemTracePlayer(const Params &p)
+    : ClockedObject(p),
+      requestorId(p.system->getRequestorId(this)),
+      numCuTokens(p.max_cu_tokens),
+      nextSeqNum(0),
+      tickEvent([this]{ tick(); }, name()),
+      sentExitSignal(false),
+      stats(this)
+{
+    int num_vector_ports = p.port_cu_vector_ports_connection_count;
+    int num_token_ports = p.port_cu_token_ports_connection_count;
+
+    fatal_if(p.trace_files.size() != (size_t)num_vector_ports,
+             "%s: %d traces given for %d vector ports\n", name(),
+             p.trace_files.size(), num_vector_ports);
+    fatal_if(num_token_ports != num_vector_ports,
+             "%s: every vector port needs a token port\n", name());
+
+    cus.resize(num_vector_ports);
+    for (int i = 0; i < num_vector_ports; ++i) {
+        Cu &cu = cus[i];
+        cu.port = new SeqPort(csprintf("%s-cuVectorPort%d", name(), i),
+                              this, i);
+        cu.tokenPort = new GMTokenPort(csprintf("%s-cuTokenPort%d",
+                                                name(), i), this, i);
+        cu.tokenManager = new TokenManager(numCuTokens);
+        cu.tokenPort->setTokenManager(cu.tokenManager);
+
+        readTrace(cu, p.trace_files[i], p.system->cacheLineSize());
+    }
+}
+
+GPUMemTracePlayer::~GPUMemTracePlayer()
+{
+    for (auto &cu : cus) {
+        delete cu.port;
+        delete cu.tokenPort;
+        delete cu.tokenManager;
+    }
+}
+
+void
+GPUMemTracePlayer::readTrace(Cu &cu, const std::string &filename,
+                             unsigned block_size)
+{
+    ProtoInputStream trace(filename);
+
+    ProtoMessage::GPUMemTraceHeader header_msg;
+    fatal_if(!trace.read(header_msg), "%s: could not read the header of "
+             "GPU memory trace %s\n", name(), filename);
+    fatal_if(header_msg.block_size() != block_size,
+             "%s: trace %s was recorded with %d byte lines, the system "
+             "uses %d byte lines\n", name(), filename,
+             header_msg.block_size(), block_size);
+
+    // The requests of an instruction are recorded as they complete, so
+    // collect them per instruction first
+    std::map<int, std::map<InstSeqNum, TraceInst>> wave_insts;
+
+    ProtoMessage::GPUMemRecord record;
+    while (trace.read(record)) {
+        TraceInst &inst = wave_insts[record.wave_id()][record.seq_num()];
+        if (inst.reqs.empty()) {
+            inst.seqNum = record.seq_num();
+            inst.hasDep = record.has_dep_seq_num();
+            inst.depSeqNum = record.dep_seq_num();
+            inst.waveDeps.assign(record.wave_dep_seq_nums().begin(),
+                                 record.wave_dep_seq_nums().end());
+            cu.waveDepTargets.insert(inst.waveDeps.begin(),
+                                     inst.waveDeps.end());
+            // Delays are recorded in the recording simulation's ticks
+            inst.delay = record.delay() * SimClock::Frequency /
+                header_msg.tick_freq();
+            inst.isSync =
+                record.type() == ProtoMessage::GPUMemRecord::INV_L1 ||
+                record.type() == ProtoMessage::GPUMemRecord::WB_L1 ||
+                record.type() == ProtoMessage::GPUMemRecord::FLUSH_L2 ||
+                record.type() == ProtoMessage::GPUMemRecord::INV_L2;
+        }
+
+        TraceReq req;
+        req.type = record.type();
+        req.addr = record.addr();
+        req.size = 0;
+        req.homeNode = record.home_node();
+        req.slc = record.slc();
+
+        if (!inst.isSync) {
+            // Replay the accessed bytes as one packet that spans from the
+            // first to the last accessed byte of the line
+            const std::string &mask = record.mask();
+            int first = -1;
+            int last = -1;
+            for (int i = 0; i < (int)mask.size() * 8; i++) {
+                if (mask[i / 8] & (1 << (i % 8))) {
+                    if (first < 0)
+                        first = i;
+                    last = i;
+                }
+            }
+            assert(first >= 0);
+            req.addr += first;
+            req.size = last - first + 1;
+
+            // Atomics cover whole words. They keep the span of their lanes
+            // so that Ruby sees their full mask, but only increment the
+            // first word
+            if (req.type == ProtoMessage::GPUMemRecord::ATOMIC ||
+                req.type == ProtoMessage::GPUMemRecord::ATOMIC_NO_RETURN) {
+                Addr end = roundUp(req.addr + req.size, sizeof(uint32_t));
+                req.addr &= ~Addr(sizeof(uint32_t) - 1);
+                req.size = end - req.addr;
+            }
+        }
+
+        inst.reqs.push_back(req);
+    }
+
+    int num_insts = 0;
+    for (auto &wave_it : wave_insts) {
+        Wave &wave = cu.waves[wave_it.first];
+        wave.waveId = wave_it.first;
+        wave.ready = false;
+        wave.readyTick = 0;
+        for (auto &inst_it : wave_it.second) {
+            wave.insts.push_back(std::move(inst_it.second));
+            num_insts++;
+        }
+    }
+
+    DPRINTF(GPUMemTracePlayer, "Read %d instructions of %d wavefronts "
+            "from %s recorded by %s\n", num_insts, cu.waves.size(),
+            filename, header_msg.obj_id());
+}
+
+void
+GPUMemTracePlayer::init()
+{
+    scheduleTick(curTick());
+}
+
+Port&
+GPUMemTracePlayer::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "cu_vector_ports") {
+        if (idx >= (int)cus.size())
+            panic("GPUMemTracePlayer: unknown cu vector port %d\n", idx);
+        return *cus[idx].port;
+    } else if (if_name == "cu_token_ports") {
+        if (idx >= (int)cus.size())
+            panic("GPUMemTracePlayer: unknown cu token port %d\n", idx);
+        return *cus[idx].tokenPort;
+    }
+
+    return ClockedObject::getPort(if_name, idx);
+}
+
+void
+GPUMemTracePlayer::scheduleTick(Tick when)
+{
+    if (!tickEvent.scheduled()) {
+        schedule(tickEvent, when);
+    } else if (when < tickEvent.when()) {
+        reschedule(tickEvent, when);
+    }
+}
+
+void
+GPUMemTracePlayer::tick()
+{
+    Tick next = MaxTick;
+
+    for (auto &cu : cus) {
+        for (auto &wave_it : cu.waves) {
+            next = std::min(next, issueWave(cu, wave_it.second));
+        }
+    }
+
+    if (next != MaxTick)
+        scheduleTick(next);
+
+    checkDone();
+}
+
+Tick
+GPUMemTracePlayer::issueWave(Cu &cu, Wave &wave)
+{
+    while (!wave.insts.empty()) {
+        // Packets rejected by the coalescer have to go first
+        if (!cu.retryPkts.empty())
+            return MaxTick;
+
+        TraceInst &inst = wave.insts.front();
+
+        if (!wave.ready) {
+            // The completion of the dependencies wakes the wavefront up
+            if (inst.hasDep && wave.pending.count(inst.depSeqNum))
+                return MaxTick;
+            for (auto dep : inst.waveDeps) {
+                if (!cu.waveDepsDone.count(dep))
+                    return MaxTick;
+            }
+
+            wave.ready = true;
+            wave.readyTick = curTick() + inst.delay;
+        }
+
+        if (curTick() < wave.readyTick)
+            return wave.readyTick;
+
+        if (!inst.isSync && !cu.tokenPort->haveTokens(inst.reqs.size())) {
+            // Tokens are returned without a callback, try again next cycle
+            stats.numTokenStalls++;
+            return clockEdge(Cycles(1));
+        }
+
+        issueInst(cu, wave, inst);
+        wave.insts.pop_front();
+        wave.ready = false;
+    }
+
+    return MaxTick;
+}
+
+void
+GPUMemTracePlayer::issueInst(Cu &cu, Wave &wave, const TraceInst &inst)
+{
+    DPRINTF(GPUMemTracePlayer, "%s: wave %d issuing inst %d with %d "
+            "packets\n", cu.port->name(), wave.waveId, inst.seqNum,
+            inst.reqs.size());
+
+    if (inst.isSync) {
+        stats.numSyncOps++;
+    } else {
+        stats.numInsts++;
+        cu.tokenPort->acquireTokens(inst.reqs.size());
+    }
+
+    wave.pending[inst.seqNum] = inst.reqs.size();
+
+    for (auto &req : inst.reqs) {
+        PacketPtr pkt = makePacket(req, nextSeqNum++);
+        pkt->senderState = new SenderState(wave.waveId, inst.seqNum);
+        stats.numPackets++;
+
+        if (!cu.retryPkts.empty() || !cu.port->sendTimingReq(pkt)) {
+            stats.numRetries++;
+            cu.retryPkts.push_back(pkt);
+        }
+    }
+}
+
+PacketPtr
+GPUMemTracePlayer::makePacket(const TraceReq &trace_req, InstSeqNum seq_num)
+{
+    RequestPtr req;
+    MemCmd cmd;
+
+    switch (trace_req.type) {
+      case ProtoMessage::GPUMemRecord::LOAD:
+      case ProtoMessage::GPUMemRecord::STORE:
+        req = std::make_shared<Request>(trace_req.addr, trace_req.size, 0,
+                                        requestorId, 0, 0);
+        cmd = trace_req.type == ProtoMessage::GPUMemRecord::LOAD ?
+            MemCmd::ReadReq : MemCmd::WriteReq;
+        break;
+      case ProtoMessage::GPUMemRecord::ATOMIC:
+      case ProtoMessage::GPUMemRecord::ATOMIC_NO_RETURN:
+        req = std::make_shared<Request>(trace_req.addr, trace_req.size,
+            trace_req.type == ProtoMessage::GPUMemRecord::ATOMIC ?
+                Request::ATOMIC_RETURN_OP : Request::ATOMIC_NO_RETURN_OP,
+            requestorId, 0, 0,
+            AtomicOpFunctorPtr(new AtomicOpInc<uint32_t>()));
+        cmd = MemCmd::SwapReq;
+        break;
+      case ProtoMessage::GPUMemRecord::INV_L1:
+      case ProtoMessage::GPUMemRecord::WB_L1:
+      case ProtoMessage::GPUMemRecord::FLUSH_L2:
+      case ProtoMessage::GPUMemRecord::INV_L2:
+        req = std::make_shared<Request>(0, 0, 0, requestorId, 0, 0);
+        if (trace_req.type == ProtoMessage::GPUMemRecord::INV_L1) {
+            req->setCacheCoherenceFlags(Request::INV_L1);
+        } else if (trace_req.type == ProtoMessage::GPUMemRecord::WB_L1) {
+            req->setCacheCoherenceFlags(Request::WB_L1);
+        } else if (trace_req.type == ProtoMessage::GPUMemRecord::FLUSH_L2) {
+            req->setCacheCoherenceFlags(Request::FLUSH_L2);
+        } else {
+            req->setCacheCoherenceFlags(Request::INV_L2);
+        }
+        cmd = MemCmd::MemSyncReq;
+        break;
+      default:
+        panic("Unexpected GPU memory trace record type %d\n",
+              trace_req.type);
+    }
+
+    req->setPaddr(cmd == MemCmd::MemSyncReq ? 0 : trace_req.addr);
+    req->setReqInstSeqNum(seq_num);
+    req->setHomeNode(trace_req.homeNode);
+    if (trace_req.slc)
+        req->setCacheCoherenceFlags(Request::SLC_BIT);
+
+    PacketPtr pkt = new Packet(req, cmd);
+    if (cmd != MemCmd::MemSyncReq) {
+        uint8_t *data = new uint8_t[trace_req.size];
+        std::fill(data, data + trace_req.size, 0);
+        pkt->dataDynamic(data);
+    }
+
+    return pkt;
+}
+
+void
+GPUMemTracePlayer::hitCallback(int cu_id, PacketPtr pkt)
+{
+    if (pkt->cmd == MemCmd::WriteCompleteResp) {
+        // The store already completed with its WriteResp, which is when
+        // the recorder considers it done as well
+        delete pkt->senderState;
+        delete pkt;
+        return;
+    }
+
+    SenderState *ss = safe_cast<SenderState *>(pkt->senderState);
+    int wave_id = ss->waveId;
+    InstSeqNum seq_num = ss->seqNum;
+
+    // The write completion packet carries the same sender state
+    if (pkt->cmd != MemCmd::WriteResp)
+        delete ss;
+    delete pkt;
+
+    Cu &cu = cus[cu_id];
+    Wave &wave = cu.waves[wave_id];
+    auto pending_it = wave.pending.find(seq_num);
+    assert(pending_it != wave.pending.end());
+    assert(pending_it->second > 0);
+
+    if (--pending_it->second == 0) {
+        DPRINTF(GPUMemTracePlayer, "cu %d: wave %d inst %d completed\n",
+                cu_id, wave_id, seq_num);
+        wave.pending.erase(pending_it);
+        if (cu.waveDepTargets.count(seq_num))
+            cu.waveDepsDone.insert(seq_num);
+        scheduleTick(curTick());
+    }
+}
+
+void
+GPUMemTracePlayer::recvReqRetry(int cu_id)
+{
+    Cu &cu = cus[cu_id];
+    while (!cu.retryPkts.empty()) {
+        if (!cu.port->sendTimingReq(cu.retryPkts.front()))
+            return;
+        cu.retryPkts.pop_front();
+    }
+
+    scheduleTick(curTick());
+}
+
+void
+GPUMemTracePlayer::checkDone()
+{
+    if (sentExitSignal)
+        return;
+
+    for (auto &cu : cus) {
+        if (!cu.retryPkts.empty())
+            return;
+        for (auto &wave_it : cu.waves) {
+            const Wave &wave = wave_it.second;
+            if (!wave.insts.empty() || !wave.pending.empty())
+                return;
+        }
+    }
+
+    inform("Replayed %d GPU memory instructions\n",
+           (uint64_t)(stats.numInsts.value() + stats.numSyncOps.value()));
+    exitSimLoop("GPU memory trace replay done");
+    sentExitSignal = true;
+}
+
+bool
+GPUMemTracePlayer::SeqPort::recvTimingResp(PacketPtr pkt)
+{
+    player->hitCallback(cuId, pkt);
+    return true;
+}
+
+void
+GPUMemTracePlayer::SeqPort::recvReqRetry()
+{
+    player->recvReqRetry(cuId);
+}
+
+GPUMemTracePlayer::PlayerStats::PlayerStats(Stats::Group *parent)
+    : Stats::Group(parent),
+      ADD_STAT(numInsts, "Number of vector memory instructions replayed"),
+      ADD_STAT(numSyncOps, "Number of memory sync ops replayed"),
+      ADD_STAT(numPackets, "Number of packets sent to the coalescers"),
+      ADD_STAT(numRetries, "Number of packets rejected by the coalescers"),
+      ADD_STAT(numTokenStalls, "Number of times a wavefront waited for "
+               "coalescer tokens")
+{
+}
+
+GPUMemTracePlayer*
+GPUMemTracePlayerParams::create() const
+{
+    return new GPUMemTracePlayer(*this);
+}
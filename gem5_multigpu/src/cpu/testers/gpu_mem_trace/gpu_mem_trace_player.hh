@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TESTERS_GPU_MEM_TRACE_GPU_MEM_TRACE_PLAYER_HH__
+#define __CPU_TESTERS_GPU_MEM_TRACE_GPU_MEM_TRACE_PLAYER_HH__
+
+/*
+ * The player replays GPU memory traces recorded by the GPU coalescers
+ * (see GPUMemTraceRecorder) into Ruby, without simulating the compute
+ * units. Each trace drives one coalescer through its vector and token
+ * ports, the same way the GPU Ruby tester does.
+ *
+ * The replay is closed-loop. The instructions of a wavefront issue in
+ * order, and each one waits for its recorded dependencies to complete and
+ * then for its recorded delay, so that a faster or slower memory system
+ * speeds up or slows down the wavefronts. The sync ops injected at kernel
+ * boundaries replay as a wavefront of their own, and wait for the
+ * wavefronts before them, which in turn wait for them.
+ */
+
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "mem/token_port.hh"
+#include "params/GPUMemTracePlayer.hh"
+#include "proto/gpu_mem_trace.pb.h"
+#include "sim/clocked_object.hh"
+
+class GPUMemTracePlayer : public ClockedObject
+{
+  public:
+    class SeqPort : public RequestPort
+    {
+      public:
+        SeqPort(const std::string &_name, GPUMemTracePlayer *_player,
+                PortID _id)
+            : RequestPort(_name, _player, _id), player(_player), cuId(_id)
+        {}
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+        void recvReqRetry() override;
+
+      private:
+        GPUMemTracePlayer *player;
+        int cuId;
+    };
+
+    class GMTokenPort : public TokenRequestPort
+    {
+      public:
+        GMTokenPort(const std::string& name, GPUMemTracePlayer *_player,
+                    PortID id = InvalidPortID)
+            : TokenRequestPort(name, _player, id)
+        {}
+        ~GMTokenPort() {}
+
+      protected:
+        bool recvTimingResp(PacketPtr) override { return false; }
+        void recvReqRetry() override {}
+    };
+
+    struct SenderState : public Packet::SenderState
+    {
+        int waveId;
+        // Sequence number of the recorded instruction
+        InstSeqNum seqNum;
+        SenderState(int _waveId, InstSeqNum _seqNum)
+            : waveId(_waveId), seqNum(_seqNum)
+        {}
+    };
+
+    typedef GPUMemTracePlayerParams Params;
+    GPUMemTracePlayer(const Params &p);
+    ~GPUMemTracePlayer();
+
+    void init() override;
+    Port& getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+  private:
+    typedef ProtoMessage::GPUMemRecord::RecordType RecordType;
+
+    // One packet of a recorded instruction
+    struct TraceReq
+    {
+        RecordType type;
+        Addr addr;
+        unsigned size;
+        int homeNode;
+        bool slc;
+    };
+
+    struct TraceInst
+    {
+        InstSeqNum seqNum;
+        bool hasDep;
+        InstSeqNum depSeqNum;
+        // Instructions of other wavefronts that must complete first
+        std::vector<InstSeqNum> waveDeps;
+        Tick delay;
+        bool isSync;
+        std::vector<TraceReq> reqs;
+    };
+
+    struct Wave
+    {
+        int waveId;
+        // Instructions that have not been issued yet, in issue order
+        std::deque<TraceInst> insts;
+        // Issued instructions that have not completed, and the number of
+        // packets each one is still waiting for
+        std::unordered_map<InstSeqNum, int> pending;
+        // Whether the next instruction's dependency has completed, and the
+        // tick it can issue at from then on
+        bool ready;
+        Tick readyTick;
+    };
+
+    struct Cu
+    {
+        SeqPort *port;
+        GMTokenPort *tokenPort;
+        TokenManager *tokenManager;
+        std::map<int, Wave> waves;
+        // Packets that the coalescer rejected, sent in order on a retry
+        std::deque<PacketPtr> retryPkts;
+        // Instructions that other wavefronts depend on, and the ones of
+        // them that completed
+        std::unordered_set<InstSeqNum> waveDepTargets;
+        std::unordered_set<InstSeqNum> waveDepsDone;
+    };
+
+    /** Read a whole trace and split it into wavefronts */
+    void readTrace(Cu &cu, const std::string &filename,
+                   unsigned block_size);
+
+    /**
+     * Issue the instructions of a wavefront that are ready. Returns the
+     * tick the wavefront needs to be looked at again, or MaxTick if it is
+     * waiting for a response.
+     */
+    Tick issueWave(Cu &cu, Wave &wave);
+    void issueInst(Cu &cu, Wave &wave, const TraceInst &inst);
+    PacketPtr makePacket(const TraceReq &req, InstSeqNum seq_num);
+
+    void tick();
+    void scheduleTick(Tick when);
+    void hitCallback(int cu_id, PacketPtr pkt);
+    void recvReqRetry(int cu_id);
+    void checkDone();
+
+    RequestorID requestorId;
+    int numCuTokens;
+
+    std::vector<Cu> cus;
+
+    // Every packet gets its own sequence number, since the coalescer
+    // expects one packet per instruction in tester mode
+    InstSeqNum nextSeqNum;
+
+    EventFunctionWrapper tickEvent;
+    bool sentExitSignal;
+
+    struct PlayerStats : public Stats::Group
+    {
+        PlayerStats(Stats::Group *parent);
+
+        Stats::Scalar numInsts;
+        Stats::Scalar numSyncOps;
+        Stats::Scalar numPackets;
+        Stats::Scalar numRetries;
+        Stats::Scalar numTokenStalls;
+    } stats;
+};
+
+#endif // __CPU_TESTERS_GPU_MEM_TRACE_GPU_MEM_TRACE_PLAYER_HH__
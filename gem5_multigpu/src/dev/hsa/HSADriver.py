@@ -40,3 +40,4 @@ class HSADriver(EmulatedDriver):
     cxx_header = 'dev/hsa/hsa_driver.hh'
     device = VectorParam.HSADevice('HSA devices controlled by this driver')
     global_scheduler = Param.GlobalScheduler('The global scheduler')
+    system = Param.System(Parent.any, 'System this driver belongs to')
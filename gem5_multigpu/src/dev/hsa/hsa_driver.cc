@@ -43,10 +43,11 @@
 #include "sim/process.hh"
 #include "sim/proxy_ptr.hh"
 #include "sim/syscall_emul_buf.hh"
+#include "sim/system.hh"
 
 HSADriver::HSADriver(const HSADriverParams &p)
     : EmulatedDriver(p), eventPage(0), eventSlotIndex(0), device(p.device),
-      queueId(0), global_scheduler(p.global_scheduler)
+      queueId(0), global_scheduler(p.global_scheduler), sys(p.system)
 {
 }
 
@@ -202,3 +203,79 @@ HSADriver::DriverWakeupEvent::process()
     // Remove events that can wake up this thread
     driver->TCEvents[tc].clearEvents();
 }
+
+void
+HSADriver::serialize(CheckpointOut &cp) const
+{
+    SERIALIZE_SCALAR(eventPage);
+    SERIALIZE_SCALAR(eventSlotIndex);
+    SERIALIZE_SCALAR(queueId);
+
+    std::vector<uint32_t> event_ids;
+    for (const auto &entry : ETable) {
+        event_ids.push_back(entry.first);
+
+        const ETEntry &ete = entry.second;
+        ContextID context_id = ete.tc ? ete.tc->contextId() :
+                                        InvalidContextID;
+        ScopedCheckpointSection sec(cp, csprintf("event%d", entry.first));
+        paramOut(cp, "mail_box_ptr", ete.mailBoxPtr);
+        paramOut(cp, "thread_waiting", ete.threadWaiting);
+        paramOut(cp, "set_event", ete.setEvent);
+        SERIALIZE_SCALAR(context_id);
+    }
+    SERIALIZE_CONTAINER(event_ids);
+
+    // Threads sleeping on events are woken up either by the events or by
+    // their timer
+    std::vector<ContextID> waiting_contexts;
+    for (const auto &tce : TCEvents) {
+        ContextID context_id = tce.first->contextId();
+        waiting_contexts.push_back(context_id);
+
+        Tick timer_tick = tce.second.timerEvent.scheduled() ?
+                          tce.second.timerEvent.when() : 0;
+        ScopedCheckpointSection sec(cp, csprintf("context%d", context_id));
+        arrayParamOut(cp, "signal_events", tce.second.signalEvents);
+        SERIALIZE_SCALAR(timer_tick);
+    }
+    SERIALIZE_CONTAINER(waiting_contexts);
+}
+
+void
+HSADriver::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_SCALAR(eventPage);
+    UNSERIALIZE_SCALAR(eventSlotIndex);
+    UNSERIALIZE_SCALAR(queueId);
+
+    std::vector<uint32_t> event_ids;
+    UNSERIALIZE_CONTAINER(event_ids);
+    ETable.clear();
+    for (auto event_id : event_ids) {
+        ETEntry &ete = ETable[event_id];
+        ContextID context_id;
+        ScopedCheckpointSection sec(cp, csprintf("event%d", event_id));
+        paramIn(cp, "mail_box_ptr", ete.mailBoxPtr);
+        paramIn(cp, "thread_waiting", ete.threadWaiting);
+        paramIn(cp, "set_event", ete.setEvent);
+        UNSERIALIZE_SCALAR(context_id);
+        ete.tc = (context_id == InvalidContextID) ? nullptr :
+                 sys->threads[context_id];
+    }
+
+    std::vector<ContextID> waiting_contexts;
+    UNSERIALIZE_CONTAINER(waiting_contexts);
+    for (auto context_id : waiting_contexts) {
+        ThreadContext *tc = sys->threads[context_id];
+        auto tce = TCEvents.emplace(std::piecewise_construct,
+                                    std::make_tuple(tc),
+                                    std::make_tuple(this, tc)).first;
+        Tick timer_tick;
+        ScopedCheckpointSection sec(cp, csprintf("context%d", context_id));
+        arrayParamIn(cp, "signal_events", tce->second.signalEvents);
+        UNSERIALIZE_SCALAR(timer_tick);
+        if (timer_tick)
+            schedule(tce->second.timerEvent, timer_tick);
+    }
+}
@@ -58,6 +58,7 @@
 struct HSADriverParams;
 class HSADevice;
 class PortProxy;
+class System;
 
 class HSADriver : public EmulatedDriver
 {
@@ -68,6 +69,10 @@ class HSADriver : public EmulatedDriver
     Addr mmap(ThreadContext *tc, Addr start, uint64_t length,
               int prot, int tgt_flags, int tgt_fd, off_t offset);
     virtual void signalWakeupEvent(uint32_t event_id);
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
     class DriverWakeupEvent : public Event
     {
       public:
@@ -153,6 +158,8 @@ class HSADriver : public EmulatedDriver
     std::vector<HSADevice *> device;
     uint32_t queueId;
     GlobalScheduler* global_scheduler;
+    // Used to find the threads waiting on events after a restore
+    System *sys;
 
     void allocateQueue(ThreadContext *tc, Addr ioc_buf);
 };
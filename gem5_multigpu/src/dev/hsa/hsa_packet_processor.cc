@@ -631,7 +631,7 @@ HSAPacketProcessor::displayQueueDescriptor(int pid, uint32_t rl_idx)
 
 AQLRingBuffer::AQLRingBuffer(uint32_t size,
                              const std::string name)
-        : _name(name), _wrIdx(0), _rdIdx(0), _dispIdx(0)
+        : _name(name), _wrIdx(0), _rdIdx(0), _dispIdx(0), _priority(7)
 {
     _aqlBuf.resize(size);
     _aqlComplete.resize(size);
@@ -662,6 +662,71 @@ AQLRingBuffer::freeEntry(void *pkt)
     return (old_rdIdx != rdIdx());
 }
 
+void
+AQLRingBuffer::serialize(CheckpointOut &cp) const
+{
+    SERIALIZE_SCALAR(_wrIdx);
+    SERIALIZE_SCALAR(_rdIdx);
+    SERIALIZE_SCALAR(_dispIdx);
+    SERIALIZE_SCALAR(_priority);
+    SERIALIZE_CONTAINER(_hostDispAddresses);
+
+    std::vector<int> aql_complete(_aqlComplete.begin(), _aqlComplete.end());
+    SERIALIZE_CONTAINER(aql_complete);
+
+    // The packets are plain structs, store them as raw bytes
+    const uint8_t *aql_buf =
+        reinterpret_cast<const uint8_t *>(_aqlBuf.data());
+    SERIALIZE_ARRAY(aql_buf, numObjs() * objSize());
+}
+
+void
+AQLRingBuffer::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_SCALAR(_wrIdx);
+    UNSERIALIZE_SCALAR(_rdIdx);
+    UNSERIALIZE_SCALAR(_dispIdx);
+    UNSERIALIZE_SCALAR(_priority);
+    UNSERIALIZE_CONTAINER(_hostDispAddresses);
+    fatal_if(_hostDispAddresses.size() != numObjs(),
+             "%s: checkpointed AQL buffer has %d entries, expected %d\n",
+             _name, _hostDispAddresses.size(), numObjs());
+
+    std::vector<int> aql_complete;
+    UNSERIALIZE_CONTAINER(aql_complete);
+    std::copy(aql_complete.begin(), aql_complete.end(),
+              _aqlComplete.begin());
+
+    uint8_t *aql_buf = reinterpret_cast<uint8_t *>(_aqlBuf.data());
+    UNSERIALIZE_ARRAY(aql_buf, numObjs() * objSize());
+}
+
+void
+HSAQueueDescriptor::serialize(CheckpointOut &cp) const
+{
+    SERIALIZE_SCALAR(basePointer);
+    SERIALIZE_SCALAR(doorbellPointer);
+    SERIALIZE_SCALAR(writeIndex);
+    SERIALIZE_SCALAR(readIndex);
+    SERIALIZE_SCALAR(numElts);
+    SERIALIZE_SCALAR(hostReadIndexPtr);
+    SERIALIZE_SCALAR(stalledOnDmaBufAvailability);
+    SERIALIZE_SCALAR(dmaInProgress);
+}
+
+void
+HSAQueueDescriptor::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_SCALAR(basePointer);
+    UNSERIALIZE_SCALAR(doorbellPointer);
+    UNSERIALIZE_SCALAR(writeIndex);
+    UNSERIALIZE_SCALAR(readIndex);
+    UNSERIALIZE_SCALAR(numElts);
+    UNSERIALIZE_SCALAR(hostReadIndexPtr);
+    UNSERIALIZE_SCALAR(stalledOnDmaBufAvailability);
+    UNSERIALIZE_SCALAR(dmaInProgress);
+}
+
 void
 HSAPacketProcessor::setDevice(HSADevice *dev)
 {
@@ -776,6 +841,53 @@ HSAPacketProcessor::registerQueueFromGlobal(uint64_t hostReadIndexPointer,
                                size);
 }
 
+void
+HSAPacketProcessor::serializeQueue(uint32_t queue_id,
+                                   CheckpointOut &cp) const
+{
+    const QCntxt &q_cntxt = hwSchdlr->activeList.at(queue_id);
+    q_cntxt.qDesc->serializeSection(cp, "desc");
+    q_cntxt.aqlBuf->serializeSection(cp, "aql");
+
+    // A mapped queue keeps its barrier bit in the registered list entry
+    int rl_idx = -1;
+    bool barrier_bit = false;
+    auto rl_iter = hwSchdlr->regdListMap.find(queue_id);
+    if (rl_iter != hwSchdlr->regdListMap.end()) {
+        rl_idx = rl_iter->second;
+        barrier_bit = regdQList[rl_idx]->getBarrierBit();
+    }
+    SERIALIZE_SCALAR(rl_idx);
+    SERIALIZE_SCALAR(barrier_bit);
+}
+
+void
+HSAPacketProcessor::unserializeQueue(uint32_t queue_id, CheckpointIn &cp)
+{
+    QCntxt &q_cntxt = hwSchdlr->activeList.at(queue_id);
+    q_cntxt.qDesc->unserializeSection(cp, "desc");
+    q_cntxt.aqlBuf->unserializeSection(cp, "aql");
+
+    hwSchdlr->eraseMultiMapAL(queue_id);
+    hwSchdlr->priority_to_al_id.insert(std::pair<uint32_t, uint32_t>
+                                       (q_cntxt.aqlBuf->priority(),
+                                        queue_id));
+
+    int rl_idx;
+    bool barrier_bit;
+    UNSERIALIZE_SCALAR(rl_idx);
+    UNSERIALIZE_SCALAR(barrier_bit);
+    if (rl_idx < 0)
+        return;
+
+    fatal_if(rl_idx >= numHWQueues, "%s: queue %d was mapped to hw queue "
+             "%d, only %d exist\n", name(), queue_id, rl_idx, numHWQueues);
+    hwSchdlr->nextRLId = rl_idx;
+    hwSchdlr->addQCntxt(queue_id, q_cntxt.aqlBuf, q_cntxt.qDesc);
+    regdQList[rl_idx]->setBarrierBit(barrier_bit);
+    hwSchdlr->updateRRVars(queue_id, rl_idx);
+}
+
 void
 HSAPacketProcessor::sendAgentDispatchCompletionSignal(
     void *pkt, hsa_signal_value_t signal)
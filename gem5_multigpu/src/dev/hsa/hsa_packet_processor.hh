@@ -44,6 +44,7 @@
 #include "dev/hsa/hsa_queue.hh"
 #include "params/HSAPacketProcessor.hh"
 #include "sim/eventq.hh"
+#include "sim/serialize.hh"
 
 #define AQL_PACKET_SIZE 64
 #define PAGE_SIZE 4096
@@ -70,7 +71,7 @@ class HWScheduler;
 class GlobalScheduler;
 
 // Our internal representation of an HSA queue
-class HSAQueueDescriptor {
+class HSAQueueDescriptor : public Serializable {
     public:
         uint64_t     basePointer;
         uint64_t     doorbellPointer;
@@ -96,6 +97,9 @@ class HSAQueueDescriptor {
         bool isFull() { return spaceRemaining() == 0; }
         bool isEmpty() { return spaceRemaining() == numElts; }
 
+        void serialize(CheckpointOut &cp) const override;
+        void unserialize(CheckpointIn &cp) override;
+
         uint64_t ptr(uint64_t ix)
         {
             // We're only using gfx8 in this, change to what's used
@@ -117,7 +121,7 @@ class HSAQueueDescriptor {
  * SUBMITTED: Packet has been submitted to the HSADevice, but has not
  *            yet completed
  */
-class AQLRingBuffer
+class AQLRingBuffer : public Serializable
 {
    private:
      std::vector<hsa_kernel_dispatch_packet_t> _aqlBuf;
@@ -226,6 +230,9 @@ class AQLRingBuffer
     void setRdIdx(uint64_t value) { _rdIdx = value; }
     void setWrIdx(uint64_t value) { _wrIdx = value; }
     void setDispIdx(uint64_t value) { _dispIdx = value; }
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
 };
 
 typedef struct QueueContext {
@@ -335,6 +342,10 @@ class HSAPacketProcessor: public DmaDevice
     void registerQueueFromGlobal(uint64_t hostReadIndexPointer,
                                  uint64_t basePointer, uint64_t queue_id,
                                  uint32_t size);
+    // Save and restore the read, write and dispatch state of a queue
+    // registered from the global scheduler, and its hardware queue slot
+    void serializeQueue(uint32_t queue_id, CheckpointOut &cp) const;
+    void unserializeQueue(uint32_t queue_id, CheckpointIn &cp);
 
     HSAQueueDescriptor*
     getQueueDesc(uint32_t queId)
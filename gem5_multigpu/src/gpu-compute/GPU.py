@@ -236,6 +236,9 @@ class Shader(ClockedObject):
                                          ruby at kernel launch""")
     impl_kern_end_rel = Param.Bool(False, """Insert rel packet into
                                          ruby at kernel end""")
+    impl_wg_end_l1_rel = Param.Bool(False, """Insert L1 write-back packet
+                                         into ruby at workgroup end, for
+                                         write-back L1 caches""")
     globalmem = Param.MemorySize('64kB', 'Memory size')
     timing = Param.Bool(False, 'timing memory accesses')
 
@@ -254,6 +257,8 @@ class GPUComputeDriver(HSADriver):
     num_gpus = Param.Int(1, 'Number of GPUs')
     isdGPU = Param.Bool(False, 'Driver is for a dGPU')
     gfxVersion = Param.GfxVersion('gfx801', 'ISA of gpu to model')
+    largePages = Param.Bool(False, 'Map the VRAM allocations up front, '
+                            'on memory the GPU TLBs can use large pages for')
 
 class GPUDispatcher(SimObject):
     type = 'GPUDispatcher'
@@ -265,6 +270,18 @@ class GPUCommandProcessor(HSADevice):
     type = 'GPUCommandProcessor'
     cxx_header = 'gpu-compute/gpu_command_processor.hh'
     dispatcher = Param.GPUDispatcher('workgroup dispatcher for the GPU')
+    sqc_prefetchers = VectorParam.GPUPrefetcher([], "Prefetchers of the "
+            "SQCs of this GPU, that the kernel code is preloaded through")
+    sqc_preload_size = Param.MemorySize("0B", "Size of the kernel code "
+            "preloaded into the SQCs at dispatch, 0 to disable")
+    scalar_prefetchers = VectorParam.GPUPrefetcher([], "Prefetchers of the "
+            "scalar caches of this GPU, that the kernel arguments are "
+            "preloaded through")
+    preload_kernargs = Param.Bool(False, "Preload the kernel arguments into "
+            "the scalar caches once the launch invalidations are done")
+    scalar_preload_size = Param.MemorySize("256B", "Size of the start of "
+            "each read-only buffer argument preloaded with the kernel "
+            "arguments, 0 to only preload the arguments")
 
 class StorageClassType(Enum): vals = [
     'SC_SPILL',
@@ -300,3 +317,15 @@ class GlobalScheduler(DmaDevice):
     num_sched_gpu = Param.Int(2, 'number of chiplets kernel is scheduled across')
     default_acq_rel = Param.Bool(False, "default acq/rel behabiour")
     num_tccs = Param.Int(8,'number of TCCs')
+    sample_kernels_after = Param.UInt32(0, "Number of instances of a "
+        "kernel (name + WG size) simulated in detail before later instances "
+        "are sampled using their runtime (0 disables kernel sampling)")
+    fast_forward_kernels = Param.UInt32(0, "Number of kernels executed "
+        "functionally before switching to detailed simulation (0 disables "
+        "fast-forwarding by kernel count)")
+    fast_forward_until = Param.String("", "Name of the first kernel to "
+        "simulate in detail, earlier kernels are executed functionally")
+    fast_forward_warmup = Param.UInt32(0, "Number of kernels simulated in "
+        "detail to warm up the caches before stats are reset. With "
+        "fast_forward_kernels these are the last of the fast-forwarded "
+        "kernels, with fast_forward_until they start at the named kernel")
@@ -44,4 +44,9 @@ class LdsState(ClockedObject):
     bankConflictPenalty = Param.Int(1, 'penalty per LDS bank conflict when '\
                                     'accessing data')
     banks = Param.Int(32, 'Number of LDS banks')
+    dwordBanks = Param.Bool(False, 'interleave the banks by DWORD instead '\
+                            'of by byte address')
+    directWideReads = Param.Bool(True, 'wide reads (ds_read_b64/b96/b128) '\
+                                 'write the VGPRs at the LDS width instead '\
+                                 'of one DWORD per lane per bus transfer')
     cuPort = ResponsePort("port that goes to the compute unit")
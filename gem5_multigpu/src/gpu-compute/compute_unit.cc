@@ -33,7 +33,9 @@
 
 #include "gpu-compute/compute_unit.hh"
 
+#include <cstring>
 #include <limits>
+#include <vector>
 
 
 #include "arch/x86/isa_traits.hh"
@@ -352,6 +354,7 @@ ComputeUnit::startWavefront(Wavefront *w, int waveId, LdsChunk *ldsChunk,
     // WG state
     w->wgId = task->globalWgId();
     w->dispatchId = task->dispatchId();
+    w->fastForward = task->fastForward();
     w->workGroupId[0] = w->wgId % task->numWg(0);
     w->workGroupId[1] = (w->wgId / task->numWg(0)) % task->numWg(1);
     w->workGroupId[2] = w->wgId / (task->numWg(0) * task->numWg(1));
@@ -433,6 +436,19 @@ ComputeUnit::doFlush(GPUDynInstPtr gpuDynInst) {
     injectGlobalMemFence(gpuDynInst, true);
 }
 
+/**
+ * trigger the write-back of the dirty L1 lines at workgroup end
+ *
+ * gpuDynInst: the end of program inst of the workgroup's last wavefront
+ */
+void
+ComputeUnit::doL1Release(GPUDynInstPtr gpuDynInst) {
+    auto req = std::make_shared<Request>(0, 0, 0, requestorId(), 0,
+                                         gpuDynInst->wfDynId);
+    req->setCacheCoherenceFlags(Request::WB_L1);
+    injectGlobalMemFence(gpuDynInst, true, req);
+}
+
 // reseting SIMD register pools
 // I couldn't think of any other place and
 // I think it is needed in my implementation
@@ -753,6 +769,10 @@ ComputeUnit::releaseWFsFromBarrier(int bar_id)
 void
 ComputeUnit::exec()
 {
+    // fast-forwarded wavefronts are done or stopped when this returns, so
+    // the pipeline only ever sees the wavefronts simulated in detail
+    execFunctional();
+
     // process reads and writes in the RFs
     for (auto &vecRegFile : vrf) {
         vecRegFile->exec();
@@ -783,6 +803,50 @@ ComputeUnit::exec()
     }
 }
 
+/**
+ * Run all of the fast-forwarded wavefronts dispatched to this CU to
+ * completion in a single cycle, without going through the pipeline.
+ * Wavefronts of kernels simulated in detail are left to the pipeline.
+ * The fast-forwarded ones are run round-robin until they end or stall at
+ * a barrier; once every wavefront of a WG has reached its barrier, the
+ * barrier is released and they are run again. Because all wavefronts of
+ * a WG are dispatched together, the fast-forwarded WGs on this CU have
+ * always completed when this returns.
+ */
+void
+ComputeUnit::execFunctional()
+{
+    bool progress = true;
+
+    while (progress) {
+        progress = false;
+
+        for (int i = 0; i < numVectorALUs; ++i) {
+            for (int j = 0; j < shader->n_wf; ++j) {
+                Wavefront *wf = wfList[i][j];
+
+                if (!wf->fastForward) {
+                    continue;
+                }
+
+                if (wf->getStatus() == Wavefront::S_BARRIER &&
+                    allAtBarrier(wf->barrierId())) {
+                    int bar_id = wf->barrierId();
+                    DPRINTF(GPUSync, "CU[%d] - All waves at barrier Id%d. "
+                            "Resetting barrier resources.\n", cu_id, bar_id);
+                    resetBarrier(bar_id);
+                    releaseWFsFromBarrier(bar_id);
+                }
+
+                if (wf->getStatus() == Wavefront::S_RUNNING) {
+                    wf->execFunctional();
+                    progress = true;
+                }
+            }
+        }
+    }
+}
+
 void
 ComputeUnit::init()
 {
@@ -886,6 +950,30 @@ ComputeUnit::DataPort::recvTimingResp(PacketPtr pkt)
         // retrieve wavefront from inst
         Wavefront *w = gpuDynInst->wavefront();
 
+        // Check if we are waiting on the L1 release of the workgroup. The
+        // last workgroup of the kernel goes on to the kernel end flush if
+        // one is needed
+        if (w->getStatus() == Wavefront::S_RETURNING &&
+            pkt->req->isWbL1()) {
+            assert(gpuDynInst->isEndOfKernel());
+            Shader *shader = computeUnit->shader;
+            if (dispatcher.isReachingKernelEnd(w) &&
+                shader->impl_kern_end_rel && shader->wbL2) {
+                shader->prepareFlush(gpuDynInst);
+            } else {
+                DPRINTF(GPUDisp, "CU%d: WF[%d][%d][wv=%d]: WG %d completed\n",
+                        computeUnit->cu_id, w->simdId, w->wfSlotId,
+                        w->wfDynId, w->wgId);
+
+                dispatcher.notifyWgCompl(w);
+                w->setStatus(Wavefront::S_STOPPED);
+            }
+
+            delete pkt->senderState;
+            delete pkt;
+            return true;
+        }
+
         // Check if we are waiting on Kernel End Flush
         if (w->getStatus() == Wavefront::S_RETURNING
             && gpuDynInst->isEndOfKernel()) {
@@ -1090,7 +1178,7 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
 
     PortID tlbPort_index = perLaneTLB ? index : 0;
 
-    if (shader->timingSim) {
+    if (shader->timingSim && !gpuDynInst->wavefront()->fastForward) {
         if (debugSegFault) {
             Process *p = shader->gpuTc->getProcessPtr();
             Addr vaddr = pkt->req->getVaddr();
@@ -1220,11 +1308,32 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
         // packet, or otherwise the memory access will have the old virtual
         // address sent in the translation packet, instead of the physical
         // address returned by the translation.
-        PacketPtr new_pkt = new Packet(pkt->req, pkt->cmd);
-        new_pkt->dataStatic(pkt->getPtr<uint8_t>());
+        PacketPtr new_pkt = nullptr;
+
+        if (pkt->isAtomicOp()) {
+            // functional accesses do not perform atomics, so read the old
+            // value into the packet's data and write back the new value
+            std::vector<uint8_t> new_val(pkt->getSize());
 
-        // Translation is done. It is safe to send the packet to memory.
-        memPort[0].sendFunctional(new_pkt);
+            new_pkt = new Packet(pkt->req, MemCmd::ReadReq);
+            new_pkt->dataStatic(pkt->getPtr<uint8_t>());
+            memPort[0].sendFunctional(new_pkt);
+            delete new_pkt;
+
+            std::memcpy(new_val.data(), pkt->getPtr<uint8_t>(),
+                        pkt->getSize());
+            (*pkt->getAtomicOp())(new_val.data());
+
+            new_pkt = new Packet(pkt->req, MemCmd::WriteReq);
+            new_pkt->dataStatic(new_val.data());
+            memPort[0].sendFunctional(new_pkt);
+        } else {
+            new_pkt = new Packet(pkt->req, pkt->cmd);
+            new_pkt->dataStatic(pkt->getPtr<uint8_t>());
+
+            // Translation is done. It is safe to send the packet to memory.
+            memPort[0].sendFunctional(new_pkt);
+        }
 
         DPRINTF(GPUMem, "Functional sendRequest\n");
         DPRINTF(GPUMem, "CU%d: WF[%d][%d]: index %d: addr %#x\n", cu_id,
@@ -1247,6 +1356,13 @@ ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
 {
     assert(pkt->isWrite() || pkt->isRead());
 
+    if (!shader->timingSim || gpuDynInst->wavefront()->fastForward) {
+        shader->AccessMem(pkt->req->getVaddr(), pkt->getPtr<uint8_t>(),
+                          pkt->getSize(), cu_id, pkt->cmd, false);
+        delete pkt;
+        return;
+    }
+
     BaseTLB::Mode tlb_mode = pkt->isRead() ? BaseTLB::Read : BaseTLB::Write;
 
     pkt->senderState =
@@ -1354,6 +1470,25 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
                 fflush(stdout);
                 schedule(mem_req_event, curTick() + req_tick_latency);
             }
+        } else if (req->isWbL1()) {
+          // workgroup end write-back of a write-back L1
+          assert(shader->impl_wg_end_l1_rel);
+          assert(gpuDynInst->isEndOfKernel());
+
+          req->setReqInstSeqNum(gpuDynInst->seqNum());
+          req->setFlags(Request::KERNEL);
+          pkt = new Packet(req, MemCmd::MemSyncReq);
+          pkt->pushSenderState(
+             new ComputeUnit::DataPort::SenderState(gpuDynInst, 0, nullptr));
+
+          EventFunctionWrapper *mem_req_event =
+            memPort[0].createMemReqEvent(pkt);
+
+          DPRINTF(GPUPort, "CU%d: WF[%d][%d]: index %d, addr %#x scheduling "
+                  "an L1 release\n", cu_id, gpuDynInst->simdId,
+                  gpuDynInst->wfSlotId, 0, pkt->req->getPaddr());
+
+          schedule(mem_req_event, curTick() + req_tick_latency);
         } else {
           // kernel end flush of GL2 cache may be quiesced by Ruby if the
           // GL2 is a read-only cache
@@ -1682,7 +1817,7 @@ ComputeUnit::DataPort::processMemReqEvent(PacketPtr pkt)
                 "req sent!\n", compute_unit->cu_id, gpuDynInst->simdId,
                 gpuDynInst->wfSlotId, gpuDynInst->seqNum(), id,
                 pkt->req->getPaddr());
-        if ((pkt->cmd == MemCmd::MemSyncReq) && !(pkt->req->isInvL1() || pkt->req->isGL2CacheInv() || (pkt->req->isGL2CacheFlush() && !compute_unit->shader->impl_kern_end_rel))) {
+        if ((pkt->cmd == MemCmd::MemSyncReq) && !(pkt->req->isInvL1() || pkt->req->isWbL1() || pkt->req->isGL2CacheInv() || (pkt->req->isGL2CacheFlush() && !compute_unit->shader->impl_kern_end_rel))) {
            Wavefront *wf = gpuDynInst->wavefront();
            bool kernelEnd =
                wf->computeUnit->shader->dispatcher().isReachingKernelEnd(wf);
@@ -2322,6 +2457,8 @@ ComputeUnit::ComputeUnitStats::ComputeUnitStats(Stats::Group *parent, int n_wf)
       ADD_STAT(ldsBankAccesses, "Total number of LDS bank accesses"),
       ADD_STAT(ldsBankConflictDist,
                "Number of bank conflicts per LDS memory packet"),
+      ADD_STAT(ldsWideReads, "Number of LDS reads of more than one DWORD "
+               "per lane"),
       ADD_STAT(pageDivergenceDist,
                "pages touched per wf (over all mem. instr.)"),
       ADD_STAT(dynamicGMemInstrCnt,
@@ -2334,6 +2471,8 @@ ComputeUnit::ComputeUnitStats::ComputeUnitStats(Stats::Group *parent, int n_wf)
       ADD_STAT(wgBlockedDueLdsAllocation,
                "Workgroup blocked due to LDS capacity"),
       ADD_STAT(numInstrExecuted, "number of instructions executed"),
+      ADD_STAT(numInstrFastForwarded, "number of instructions executed "
+               "functionally while fast-forwarding"),
       ADD_STAT(execRateDist, "Instruction Execution Rate: Number of executed "
                "vector instructions per cycle"),
       ADD_STAT(numVecOpsExecuted,
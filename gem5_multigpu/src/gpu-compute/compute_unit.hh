@@ -395,6 +395,7 @@ class ComputeUnit : public ClockedObject
     int wfSize() const { return wavefrontSize; }
 
     void exec();
+    void execFunctional();
     void initiateFetch(Wavefront *wavefront);
     void fetch(PacketPtr pkt, Wavefront *wavefront);
     void fillKernelState(Wavefront *w, HSAQueueEntry *task);
@@ -406,6 +407,7 @@ class ComputeUnit : public ClockedObject
     void doInvalidate(RequestPtr req, int queue_id, int kernel_id, int local_kernID);
     void doFlush(RequestPtr req, int queue_id, int kernel_id, int local_kernID);
     void doFlush(GPUDynInstPtr gpuDynInst);
+    void doL1Release(GPUDynInstPtr gpuDynInst);
 
     void dispWorkgroup(HSAQueueEntry *task, int num_wfs_in_wg);
     bool hasDispResources(HSAQueueEntry *task, int &num_wfs_in_wg);
@@ -1018,6 +1020,7 @@ class ComputeUnit : public ClockedObject
 
         Stats::Scalar ldsBankAccesses;
         Stats::Distribution ldsBankConflictDist;
+        Stats::Scalar ldsWideReads;
 
         // over all memory instructions executed over all wavefronts
         // how many touched 0-4 pages, 4-8, ..., 60-64 pages
@@ -1034,6 +1037,9 @@ class ComputeUnit : public ClockedObject
         // active when the instruction is committed, this number is still
         // incremented by 1
         Stats::Scalar numInstrExecuted;
+        // Number of instructions executed functionally while kernels are
+        // fast-forwarded, these are not counted in numInstrExecuted
+        Stats::Scalar numInstrFastForwarded;
         // Number of cycles among successive instruction executions across all
         // wavefronts of the same CU
         Stats::Distribution execRateDist;
@@ -265,3 +265,60 @@ void CpCoh::printcpcohTable()
 		// std::cout << std::endl;
 	}
 }
+
+// Checkpoint the table so that a restored run sees the same sharing state
+void CpCoh::serialize(CheckpointOut &cp) const
+{
+	SERIALIZE_SCALAR(m_capacity);
+
+	std::vector<uint32_t> dsids;
+	std::vector<uint32_t> indices;
+	for (auto const &entry : dsid_map)
+	{
+		dsids.push_back(entry.first);
+		indices.push_back(entry.second);
+	}
+	SERIALIZE_CONTAINER(dsids);
+	SERIALIZE_CONTAINER(indices);
+
+	for (uint32_t i = 0; i < NUM_CHIPLET; i++)
+	{
+		std::vector<unsigned long> states;
+		for (auto const &state : chiplet_cache[i])
+			states.push_back(state.to_ulong());
+		arrayParamOut(cp, csprintf("chiplet%d", i), states);
+	}
+
+	unsigned long flush = flush_queue.to_ulong();
+	unsigned long invalidate = invalidate_queue.to_ulong();
+	SERIALIZE_SCALAR(flush);
+	SERIALIZE_SCALAR(invalidate);
+}
+
+void CpCoh::unserialize(CheckpointIn &cp)
+{
+	cpcohReset();
+	UNSERIALIZE_SCALAR(m_capacity);
+
+	std::vector<uint32_t> dsids;
+	std::vector<uint32_t> indices;
+	UNSERIALIZE_CONTAINER(dsids);
+	UNSERIALIZE_CONTAINER(indices);
+	for (uint32_t i = 0; i < dsids.size(); i++)
+		dsid_map[dsids[i]] = indices[i];
+
+	for (uint32_t i = 0; i < NUM_CHIPLET; i++)
+	{
+		std::vector<unsigned long> states;
+		arrayParamIn(cp, csprintf("chiplet%d", i), states);
+		for (auto state : states)
+			chiplet_cache[i].push_back(bitVector(state));
+	}
+
+	unsigned long flush;
+	unsigned long invalidate;
+	UNSERIALIZE_SCALAR(flush);
+	UNSERIALIZE_SCALAR(invalidate);
+	flush_queue = chipletID(flush);
+	invalidate_queue = chipletID(invalidate);
+}
@@ -13,6 +13,8 @@
 #include <array>
 #include <tuple>
 
+#include "sim/serialize.hh"
+
 using namespace std;
 
 // Sizes
@@ -34,7 +36,7 @@ typedef vector<tuple<uint32_t, chipletVector, chipletVector, bool>> schedulerVec
 typedef std::bitset<NUM_CHIPLET> chipletID;
 
 // Class that defines the CPCoh table
-class CpCoh
+class CpCoh : public Serializable
 {
 private:
     uint32_t m_capacity;                                           // Maximum number of entries in the CpCoh
@@ -63,6 +65,10 @@ public:
 
     /* Debug */
     void printcpcohTable(); // Function to display contents of cache
+
+    /* Checkpointing */
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
 };
 
 #endif
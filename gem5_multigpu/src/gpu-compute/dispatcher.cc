@@ -206,6 +206,32 @@ GPUDispatcher::exec()
             continue;
         }
 
+        /**
+         * sampled kernels execute their WGs functionally, so the memory
+         * state seen by later kernels is the same as with detailed
+         * simulation, but they hold the chiplet for their estimated
+         * runtime
+         */
+        if (global_scheduler->isSampledKernel(task->globalQId(),
+                                              task->globalKernId()) &&
+            sampledEndTicks.find(exec_id) == sampledEndTicks.end()) {
+            sampleKernel(task);
+        }
+
+        // the mode is carried by the dispatch, so the WGs of kernels that
+        // are still running are not switched when a later one is sent
+        if (global_scheduler->isFastForwardedKernel(task->globalQId(),
+                                                    task->globalKernId())) {
+            task->markFastForward();
+        }
+
+        // the chiplet's caches no longer hold stale lines of the kernel's
+        // arguments, so they can be preloaded into the scalar caches
+        if (!task->argsPreloaded()) {
+            gpuCmdProc->preloadArgs(task);
+            task->markArgsPreloaded();
+        }
+
         // kernel invalidate is done, start workgroup dispatch
         while (!task->dispComplete()) {
             // update the thread context
@@ -233,6 +259,7 @@ GPUDispatcher::exec()
             } else if (!launched) {
                 launched = true;
                 disp_count++;
+                kernStartTicks.emplace(exec_id, curTick());
                 DPRINTF(GPUKernelInfo, "Launched kernel %d\n", exec_id);
             }
         }
@@ -338,39 +365,25 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
                                      task->globalKernId(),
                                      wf->wgId);
 
+    auto sampled_end = sampledEndTicks.find(kern_id);
+
     if (task->numWgCompleted() == task->numWgChipletTotal() ) {
-        // Notify the HSA PP that this kernel is complete
-        gpuCmdProc->hsaPacketProc()
-            .finishPkt(task->dispPktPtr(), task->queueId());
-        if (task->completionSignal() && task->getChipletId() == 1) {
-            /**
-            * HACK: The semantics of the HSA signal is to decrement
-            * the current signal value. We cheat here and read out
-            * he value from main memory using functional access and
-            * then just DMA the decremented value.
-            */
-            uint64_t signal_value =
-                gpuCmdProc->functionalReadHsaSignal(task->completionSignal());
-
-            DPRINTF(GPUDisp, "HSA AQL Kernel Complete with completion "
-                    "signal! Addr: %d the signal value is %d and numWGCompleted is %d and chiplet ID is %d\n", task->completionSignal(), signal_value, task->numWgCompleted() , task->getChipletId());
-
-            gpuCmdProc->updateHsaSignal(task->completionSignal(),
-                                        signal_value - 1);
-        } else {
-            DPRINTF(GPUDisp, "HSA AQL Kernel Complete! No completion "
-                "signal\n");
+        auto start = kernStartTicks.find(kern_id);
+        if (start != kernStartTicks.end()) {
+            global_scheduler->recordKernelRuntime(task->globalQId(),
+                task->globalKernId(), curTick() - start->second);
+            kernStartTicks.erase(start);
         }
 
-        DPRINTF(GPUWgLatency, "Kernel Complete ticks:%d kernel:%d\n",
-                curTick(), kern_id);
-        DPRINTF(GPUKernelInfo, "Completed kernel %d\n", kern_id);
-
-        DPRINTF(GlobalScheduler, "Queue[%d] Kernel[%d] complete.\n",
-                task->globalQId(), task->globalKernId());
-        global_scheduler->kernelComplete(task->globalQId(),
-                                         task->globalKernId());
-    } else if (task->numWgCompleted() == int(task->numWgChipletTotal()*gsThreshold)) {
+        if (sampled_end != sampledEndTicks.end()) {
+            Tick end_tick = sampled_end->second;
+            sampledEndTicks.erase(sampled_end);
+            finishSampledKernel(task, end_tick);
+        } else {
+            finishKernel(task);
+        }
+    } else if (sampled_end == sampledEndTicks.end() &&
+               task->numWgCompleted() == int(task->numWgChipletTotal()*gsThreshold)) {
         // Notify scheduler we will need more work soon
         // May need to model delay? Not sure
         DPRINTF(GlobalScheduler, "Queue[%d] Kernel[%d] almost done "
@@ -392,6 +405,90 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
     }
 }
 
+/**
+ * Once every WG of a task on this chiplet is done, the HSA PP is
+ * notified, the completion signal is rung and the global scheduler is
+ * told that the kernel completed on this chiplet.
+ */
+void
+GPUDispatcher::finishKernel(HSAQueueEntry *task)
+{
+    int kern_id = task->dispatchId();
+
+    // Notify the HSA PP that this kernel is complete
+    gpuCmdProc->hsaPacketProc()
+        .finishPkt(task->dispPktPtr(), task->queueId());
+    if (task->completionSignal() && task->getChipletId() == 1) {
+        /**
+        * HACK: The semantics of the HSA signal is to decrement
+        * the current signal value. We cheat here and read out
+        * he value from main memory using functional access and
+        * then just DMA the decremented value.
+        */
+        uint64_t signal_value =
+            gpuCmdProc->functionalReadHsaSignal(task->completionSignal());
+
+        DPRINTF(GPUDisp, "HSA AQL Kernel Complete with completion "
+                "signal! Addr: %d the signal value is %d and numWGCompleted is %d and chiplet ID is %d\n", task->completionSignal(), signal_value, task->numWgCompleted() , task->getChipletId());
+
+        gpuCmdProc->updateHsaSignal(task->completionSignal(),
+                                    signal_value - 1);
+    } else {
+        DPRINTF(GPUDisp, "HSA AQL Kernel Complete! No completion "
+            "signal\n");
+    }
+
+    DPRINTF(GPUWgLatency, "Kernel Complete ticks:%d kernel:%d\n",
+            curTick(), kern_id);
+    DPRINTF(GPUKernelInfo, "Completed kernel %d\n", kern_id);
+
+    DPRINTF(GlobalScheduler, "Queue[%d] Kernel[%d] complete.\n",
+            task->globalQId(), task->globalKernId());
+    global_scheduler->kernelComplete(task->globalQId(),
+                                     task->globalKernId());
+}
+
+/**
+ * A sampled kernel is charged the estimated runtime of the detailed
+ * instances of the same kernel. Its WGs are still dispatched, and
+ * executed functionally, so that the data it writes is in memory.
+ */
+void
+GPUDispatcher::sampleKernel(HSAQueueEntry *task)
+{
+    Tick runtime = global_scheduler->sampledKernelRuntime(task->globalQId(),
+        task->globalKernId());
+
+    DPRINTF(GPUDisp, "kernel %d sampled, completing in %d ticks\n",
+            task->dispatchId(), runtime);
+
+    task->markFastForward();
+    sampledEndTicks.emplace(task->dispatchId(), curTick() + runtime);
+}
+
+/**
+ * The WGs of a sampled kernel are done, it completes once its estimated
+ * runtime has elapsed.
+ */
+void
+GPUDispatcher::finishSampledKernel(HSAQueueEntry *task, Tick end_tick)
+{
+    if (end_tick <= curTick()) {
+        finishKernel(task);
+        return;
+    }
+
+    auto *event = new EventFunctionWrapper([this, task]{
+        finishKernel(task);
+
+        if (!tickEvent.scheduled()) {
+            schedule(&tickEvent, curTick() + shader->clockPeriod());
+        }
+    }, "GPU Dispatcher sampled kernel", true);
+
+    schedule(event, end_tick);
+}
+
 void
 GPUDispatcher::scheduleDispatch()
 {
@@ -98,6 +98,9 @@ class GPUDispatcher : public SimObject
     bool updateWbCounter(int kern_id, int val=-1);
     int getOutstandingWbs(int kern_id);
     void notifyWgCompl(Wavefront *wf);
+    void finishKernel(HSAQueueEntry *task);
+    void sampleKernel(HSAQueueEntry *task);
+    void finishSampledKernel(HSAQueueEntry *task, Tick end_tick);
     void scheduleDispatch();
     void dispatch(HSAQueueEntry *task);
     int getGPUID(){return gpu_id;}
@@ -109,6 +112,11 @@ class GPUDispatcher : public SimObject
     GPUCommandProcessor *gpuCmdProc;
     EventFunctionWrapper tickEvent;
     std::unordered_map<int, HSAQueueEntry*> hsaQueueEntries;
+    // tick at which the first WG of each detailed kernel was dispatched
+    std::unordered_map<int, Tick> kernStartTicks;
+    // tick at which each sampled kernel completes, whatever the time its
+    // functionally executed WGs take
+    std::unordered_map<int, Tick> sampledEndTicks;
     // list of kernel_ids to launch
     std::queue<int> execIds;
     // list of kernel_ids that have finished
@@ -136,6 +136,16 @@ FetchUnit::initiateFetch(Wavefront *wavefront)
 {
     assert(fetchBuf.at(wavefront->wfSlotId).hasFreeSpace());
 
+    /**
+     * an empty fetch buffer starts a new fetch stream, at the start of
+     * the wavefront or after a branch. the SQC may prefetch the lines
+     * that follow the first line of the stream.
+     */
+    Request::Flags flags = Request::INST_FETCH;
+    if (!fetchBuf.at(wavefront->wfSlotId).bufferedAndReservedLines()) {
+        flags.set(Request::FETCH_STREAM_START);
+    }
+
     /**
      * calculate the virtual address to fetch from the SQC. the fetch
      * buffer holds a configurable number of cache lines. we start
@@ -162,7 +172,7 @@ FetchUnit::initiateFetch(Wavefront *wavefront)
 
     // set up virtual request
     RequestPtr req = std::make_shared<Request>(
-        vaddr, computeUnit.cacheLineSize(), Request::INST_FETCH,
+        vaddr, computeUnit.cacheLineSize(), flags,
         computeUnit.requestorId(), 0, 0, nullptr);
 
     PacketPtr pkt = new Packet(req, MemCmd::ReadReq);
@@ -309,6 +319,31 @@ FetchUnit::processFetchReturn(PacketPtr pkt)
     delete pkt;
 }
 
+/**
+ * Fetch and decode the instruction at the wavefront's PC directly from
+ * functional memory. This is used when kernels are fast-forwarded and
+ * the fetch buffer is bypassed.
+ */
+GPUDynInstPtr
+FetchUnit::fetchFunctional(Wavefront *wavefront)
+{
+    TheGpuISA::RawMachInst raw_inst = 0;
+    computeUnit.shader->ReadMem(wavefront->pc(), &raw_inst, sizeof(raw_inst),
+                                computeUnit.cu_id, true);
+
+    GPUStaticInst *gpu_static_inst = decoder.decode(
+        reinterpret_cast<TheGpuISA::MachInst>(&raw_inst));
+
+    DPRINTF(GPUFetch, "CU%d: WF[%d][%d]: Id%d functionally fetched %s "
+            "from pc: %#x\n", computeUnit.cu_id, wavefront->simdId,
+            wavefront->wfSlotId, wavefront->wfDynId,
+            gpu_static_inst->disassemble(), wavefront->pc());
+
+    return std::make_shared<GPUDynInst>(&computeUnit, wavefront,
+                                        gpu_static_inst,
+                                        computeUnit.getAndIncSeqNum());
+}
+
 void
 FetchUnit::flushBuf(int wfSlotId)
 {
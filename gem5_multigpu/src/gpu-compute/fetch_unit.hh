@@ -44,6 +44,7 @@
 #include "arch/gpu_decoder.hh"
 #include "base/types.hh"
 #include "config/the_gpu_isa.hh"
+#include "gpu-compute/misc.hh"
 #include "gpu-compute/scheduler.hh"
 #include "mem/packet.hh"
 
@@ -61,6 +62,7 @@ class FetchUnit
     void initiateFetch(Wavefront *wavefront);
     void fetch(PacketPtr pkt, Wavefront *wavefront);
     void processFetchReturn(PacketPtr pkt);
+    GPUDynInstPtr fetchFunctional(Wavefront *wavefront);
     void flushBuf(int wfSlotId);
     static uint32_t globalFetchUnitID;
 
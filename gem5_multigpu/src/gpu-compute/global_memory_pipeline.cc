@@ -274,6 +274,26 @@ void
 GlobalMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
 {
     Wavefront *wf = gpuDynInst->wavefront();
+    if (wf->fastForward) {
+        // fast-forwarded accesses complete as soon as they issue, so
+        // there is nothing for a memory sync to order
+        if (!gpuDynInst->isMemSync()) {
+            gpuDynInst->initiateAcc(gpuDynInst);
+            gpuDynInst->completeAcc(gpuDynInst);
+        }
+
+        wf->releaseGmResource(gpuDynInst);
+        if (gpuDynInst->isFlat()) {
+            wf->decLGKMInstsIssued();
+        }
+        wf->decVMemInstsIssued();
+        if (gpuDynInst->isStore() && gpuDynInst->isGlobalSeg()) {
+            wf->decExpInstsIssued();
+        }
+        wf->validateRequestCounters();
+        return;
+    }
+
     if (gpuDynInst->isLoad()) {
         wf->rdGmReqsInPipe--;
         wf->outstandingReqsRdGm++;
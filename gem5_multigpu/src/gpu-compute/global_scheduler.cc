@@ -1,6 +1,7 @@
 #include "gpu-compute/global_scheduler.hh"
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 
 #include "base/chunk_generator.hh"
@@ -20,6 +21,7 @@
 #include "mem/packet_access.hh"
 #include "sim/process.hh"
 #include "sim/proxy_ptr.hh"
+#include "sim/stat_control.hh"
 #include "sim/syscall_emul_buf.hh"
 #include "sim/system.hh"
 
@@ -44,8 +46,18 @@ GlobalScheduler::GlobalScheduler(const GlobalSchedulerParams &p)
       gpu_cmd_proc(p.device), dispatcher(p.dispatcher), driver(nullptr),
       n_cu(p.n_cu), n_wf(p.n_wf), num_SIMDs(p.num_SIMDs), wf_size(p.wf_size),
       pioAddr(p.pioAddr), pioDelay(p.pioDelay),
-      policy(GSPolicyFactory::makePolicy(p.sched_policy)), num_sched_gpu(p.num_sched_gpu), default_acq_rel(p.default_acq_rel), num_tccs(p.num_tccs)
+      policy(GSPolicyFactory::makePolicy(p.sched_policy)), num_sched_gpu(p.num_sched_gpu), default_acq_rel(p.default_acq_rel), num_tccs(p.num_tccs),
+      sampleKernelsAfter(p.sample_kernels_after),
+      fastForwardKernels(p.fast_forward_kernels),
+      fastForwardUntil(p.fast_forward_until),
+      fastForwardWarmup(p.fast_forward_warmup),
+      fastForwarding(p.fast_forward_kernels || !p.fast_forward_until.empty()),
+      warmingUp(false), warmupKernelsLeft(0), numKernelsLaunched(0),
+      numSendsInFlight(0), stats(this)
 {
+    fatal_if(fastForwardKernels && !fastForwardUntil.empty(),
+             "Cannot fast-forward based both on the number of kernels and "
+             "on a kernel name\n");
     of = std::ofstream(p.outdir+"/gs_con_test.txt");
     of << "event,tick,gpu,queue,kern_id,kern_name,kern_hash\n";
     of.flush();
@@ -89,34 +101,49 @@ GlobalScheduler::write(Packet *pkt)
 {
     Addr db_offset = (Addr) ((pkt->getAddr() - pioAddr) % 4096);
     uint32_t queue_id = dbMapGlobal[db_offset];
-    uint32_t num_kernels = pkt->getLE<uint32_t>() - qInfo[queue_id]->dmaIdx;
+    uint32_t db_value = pkt->getLE<uint32_t>();
+
+    DPRINTF(HSAPacketProcessor, "db_offset = 0x%x queue_id = %d\n",
+            db_offset, queue_id);
+
+    if (drainState() == DrainState::Draining) {
+        // Don't fetch new kernels while draining, the doorbell value
+        // covers all packets written so far
+        DPRINTF(GlobalScheduler, "Q[%d]: deferring doorbell %d while "
+                "draining\n", queue_id, db_value);
+        deferredDoorbells[queue_id] = db_value;
+    } else {
+        processDoorbell(queue_id, db_value);
+    }
+
+    pkt->makeAtomicResponse();
+    return pioDelay;
+}
+
+void
+GlobalScheduler::processDoorbell(uint32_t queue_id, uint32_t db_value)
+{
+    uint32_t num_kernels = db_value - qInfo[queue_id]->dmaIdx;
     assert(num_kernels <= qInfo[queue_id]->aqlBuf->numObjs());
 
-    DPRINTF(HSAPacketProcessor,
-                "db_offset = 0x%x queue_id = %d num_kernels = %d\n",
-                db_offset, queue_id, num_kernels);
+    DPRINTF(HSAPacketProcessor, "queue_id = %d num_kernels = %d\n",
+            queue_id, num_kernels);
     qInfo[queue_id]->aqlBuf->allocEntry(num_kernels);
     assert(!qInfo[queue_id]->qDesc->dmaInProgress);
     qInfo[queue_id]->qDesc->dmaInProgress = true;
     qInfo[queue_id]->kernelsDmaing = num_kernels;
 
     int kernels_to_dma = num_kernels;
-    doorbell_reg[queue_id] = pkt->getLE<uint32_t>();
+    doorbell_reg[queue_id] = db_value;
     while (kernels_to_dma > 0) {
         int space = qInfo[queue_id]->aqlBuf->numObjs() -
             (qInfo[queue_id]->dmaIdx % qInfo[queue_id]->aqlBuf->numObjs());
         space = (space < kernels_to_dma) ? space : kernels_to_dma;
         void* aql_buf = qInfo[queue_id]->aqlBuf->ptr(qInfo[queue_id]->dmaIdx);
 
-        Packet* pkt_pass = Packet::createWrite(pkt->req);
-        pkt_pass->dataDynamic<uint32_t>(&(doorbell_reg[queue_id]));
-        pkt_pass->setAddr(pkt->getAddr());
-        DPRINTF(HSAPacketProcessor,
-                    "num packets = %d old address = 0x%x new address = 0x%x\n",
-                    space, pkt->getAddr(),
-                    pkt_pass->getAddr());
+        DPRINTF(HSAPacketProcessor, "num packets = %d\n", space);
 
-        GSDmaEvent *dmaEvent = new GSDmaEvent(this, pkt_pass,
+        GSDmaEvent *dmaEvent = new GSDmaEvent(this, db_value,
                                               queue_id, space, aql_buf);
 
         dmaReadVirt(qInfo[queue_id]->qDesc->ptr(qInfo[queue_id]->dmaIdx),
@@ -127,8 +154,6 @@ GlobalScheduler::write(Packet *pkt)
         kernels_to_dma -= space;
         //update read index here
     }
-    pkt->makeAtomicResponse();
-    return pioDelay;
 }
 
 void
@@ -219,10 +244,10 @@ GlobalScheduler::RRPlan(uint32_t queue_id, uint32_t num_kernels)
 
 
 GlobalScheduler::GSDmaEvent::
-GSDmaEvent(GlobalScheduler* _global_scheduler, Packet* _pkt_pass,
+GSDmaEvent(GlobalScheduler* _global_scheduler, uint32_t _db_value,
            uint32_t _queue_id, uint32_t _num_kernels, void* _data)
     : Event(Default_Pri, AutoDelete), glb_schdlr(_global_scheduler),
-      pkt_pass(_pkt_pass), queue_id(_queue_id), num_kernels(_num_kernels),
+      db_value(_db_value), queue_id(_queue_id), num_kernels(_num_kernels),
       data(_data)
 {
     setFlags(AutoDelete);
@@ -338,8 +363,7 @@ GlobalScheduler::GSDmaEvent::process()
         }
         glb_schdlr->qInfo[queue_id]->pktIdx = curPkt;
 
-        uint32_t doorbell_reg = pkt_pass->getLE<uint32_t>();
-        assert(doorbell_reg <= 1024);
+        assert(db_value <= 1024);
 
         //make scheduling decision
         DPRINTF(GlobalScheduler, "Got a new pkt and will make a new scheduling decision\n");
@@ -347,6 +371,7 @@ GlobalScheduler::GSDmaEvent::process()
         glb_schdlr->makeSchedulingDecision(queue_id, isVendorPkt, false,
                                            vendorPkt);
     }
+    glb_schdlr->checkDrained();
 }
 
 void
@@ -449,6 +474,7 @@ GlobalScheduler::GSReceiveEvent::process()
         DPRINTF(GlobalScheduler, "Returned kernel (%d) wasn't kernel "
                 "dispatch packet.\n", kern_id);
     }
+    glb_schdlr->checkDrained();
 }
 
 GlobalScheduler::GSSendKernelEvent::
@@ -460,11 +486,14 @@ GSSendKernelEvent(GlobalScheduler* _global_scheduler, uint32_t _gpu_id,
       readIndex(_readIndex), dispIndex(_dispIndex), isVendor(isVendor)
 {
     setFlags(AutoDelete);
+    glb_schdlr->numSendsInFlight++;
 }
 
 void
 GlobalScheduler::GSSendKernelEvent::process()
 {
+    assert(glb_schdlr->numSendsInFlight > 0);
+    glb_schdlr->numSendsInFlight--;
     glb_schdlr->recordSchedulingEvent(EVENTS::DISP, queue_id,
                                       gpu_id - STARTING_GPU_ID, dispIndex);
 
@@ -477,6 +506,8 @@ GlobalScheduler::GSSendKernelEvent::process()
     }
     else
     {
+        glb_schdlr->decideFastForward(queue_id, readIndex);
+        glb_schdlr->decideKernelSampling(queue_id, readIndex);
          glb_schdlr->prepareCPCohArgs(glb_schdlr->qInfo[queue_id]->dispKernels[readIndex].chiplets, queue_id, readIndex, addKernelIdx); //CPCOH needs to know the dispatch index as well
         for (auto i = glb_schdlr->qInfo[queue_id]->dispKernels[readIndex].chiplets.begin(); i != glb_schdlr->qInfo[queue_id]->dispKernels[readIndex].chiplets.end(); i++)
         {
@@ -507,7 +538,7 @@ GlobalScheduler::GSDecideKernelEvent::process()
     }
     glb_schdlr->qInfo[queue_id]->scheduled = false;
     DPRINTF(GlobalScheduler, "Schedule set to false\n");
-
+    glb_schdlr->checkDrained();
 }
 
 void
@@ -546,6 +577,18 @@ void GlobalScheduler::prepareCPCohArgs(std::set<uint32_t> chiplets, uint32_t que
         schedV[*i - STARTING_GPU_ID] = bitset<2>(1);
         //Creating the scheduling wherever the chiplet is scheduled is marked as 01
     }
+
+    // Remember the read-only buffers, no chiplet writes them while the
+    // kernel runs
+    auto &read_only_args = qInfo[queue_id]->dispKernels[kernel_id].readOnlyArgs;
+    read_only_args.clear();
+    if (cpcoh_dispKernIdx > 0 &&
+        cpcoh_dispKernIdx <= incomingKernelArgs.size()) {
+        for (const auto &arg : incomingKernelArgs[cpcoh_dispKernIdx - 1]) {
+            if (get<1>(arg) == 0)
+                read_only_args.push_back(get<0>(arg));
+        }
+    }
     if(default_acq_rel){
     chipletID FlushVec = std::bitset<NUM_CHIPLET>{0xf};
     qInfo[queue_id]->dispKernels[kernel_id].invalidate_flush_control = std::make_pair(FlushVec, FlushVec);
@@ -705,10 +748,147 @@ GlobalScheduler::kernelWgFinish(uint32_t queue_id, uint32_t kern_id,
 void
 GlobalScheduler::updateRuntimeEstimate(uint32_t queue_id, uint32_t kern_id)
 {
+    // Sampled and fast-forwarded kernels ran their WGs functionally,
+    // don't pollute the estimate
+    if (isSampledKernel(queue_id, kern_id) ||
+        isFastForwardedKernel(queue_id, kern_id))
+        return;
+
     kernelInfo->updateTime(qInfo[queue_id]->getKernKey(kern_id),
                            qInfo[queue_id]->getWGRuntimes(kern_id));
 }
 
+/**
+ * Decide whether a kernel that is about to be sent to the chiplets is
+ * simulated in detail or sampled. Once sampleKernelsAfter instances of
+ * a KernelKey have been launched in detail, and at least one of them
+ * has reported its runtime, later instances are sampled. The CpCoh
+ * arguments of sampled kernels are still prepared, the
+ * invalidate/flush operations they require are still performed by the
+ * dispatcher and their WGs are executed functionally, so the coherence
+ * and memory state seen by later kernels is the same as with detailed
+ * simulation.
+ */
+void
+GlobalScheduler::decideKernelSampling(uint32_t queue_id, uint32_t kern_id)
+{
+    if (!sampleKernelsAfter || !qInfo[queue_id]->isDispatchedKern(kern_id) ||
+        isFastForwardedKernel(queue_id, kern_id))
+        return;
+
+    KernelQInfo &kern = qInfo[queue_id]->dispKernels[kern_id];
+    KernelSample &sample = kernelInfo->getKernelSample(kern.kernKey);
+
+    if (sample.numLaunched >= sampleKernelsAfter && sample.numSamples > 0) {
+        DPRINTF(GlobalScheduler, "Q[%d] Kern[%d](%s): sampled, estimated "
+                "runtime %d ticks\n", queue_id, kern_id,
+                kern.kernKey.kernelName, (Tick)sample.mean);
+        kern.sampled = true;
+        stats.numSampledKernels++;
+    } else {
+        sample.numLaunched++;
+        stats.numDetailedKernels++;
+    }
+}
+
+bool
+GlobalScheduler::isSampledKernel(uint32_t queue_id, uint32_t kern_id)
+{
+    return qInfo[queue_id]->isDispatchedKern(kern_id) &&
+           qInfo[queue_id]->dispKernels[kern_id].sampled;
+}
+
+/**
+ * Runtime a sampled kernel is charged on each chiplet it was scheduled
+ * on. This is the mean of the per-chiplet runtimes of the detailed
+ * instances of the same KernelKey.
+ */
+Tick
+GlobalScheduler::sampledKernelRuntime(uint32_t queue_id, uint32_t kern_id)
+{
+    KernelSample &sample = kernelInfo->getKernelSample(
+        qInfo[queue_id]->getKernKey(kern_id));
+
+    stats.sampledTicks += sample.mean;
+    stats.sampledTicksErrorBound += sample.errorBound();
+
+    return (Tick)sample.mean;
+}
+
+void
+GlobalScheduler::recordKernelRuntime(uint32_t queue_id, uint32_t kern_id,
+                                     Tick runtime)
+{
+    // the WGs of sampled kernels ran functionally
+    if (isSampledKernel(queue_id, kern_id) ||
+        isFastForwardedKernel(queue_id, kern_id))
+        return;
+
+    kernelInfo->recordKernelTime(qInfo[queue_id]->getKernKey(kern_id),
+                                 runtime);
+}
+
+/**
+ * Decide whether a kernel that is about to be sent to the chiplets is
+ * fast-forwarded, i.e., executed functionally by the CUs, or simulated
+ * in detail. The dispatcher passes the decision on to the WGs of the
+ * kernel, so kernels still running keep their own mode. Once the switch
+ * point is reached all later kernels are simulated in detail. After the
+ * warmup kernels have been launched the stats are dumped and reset, so
+ * that they only cover the detailed region of interest.
+ */
+void
+GlobalScheduler::decideFastForward(uint32_t queue_id, uint32_t kern_id)
+{
+    if ((!fastForwarding && !warmingUp) ||
+        !qInfo[queue_id]->isDispatchedKern(kern_id))
+        return;
+
+    KernelQInfo &kern = qInfo[queue_id]->dispKernels[kern_id];
+    uint32_t kern_num = numKernelsLaunched++;
+
+    if (fastForwarding) {
+        bool detailed = fastForwardUntil.empty() ?
+            kern_num + fastForwardWarmup >= fastForwardKernels :
+            kern.kernKey.kernelName == fastForwardUntil;
+
+        if (!detailed) {
+            DPRINTF(GlobalScheduler, "Q[%d] Kern[%d](%s): fast-forwarded\n",
+                    queue_id, kern_id, kern.kernKey.kernelName);
+            kern.fastForwarded = true;
+            stats.numFastForwardedKernels++;
+            return;
+        }
+
+        inform("Switching the GPU to detailed simulation at kernel %d "
+               "(%s)\n", kern_num, kern.kernKey.kernelName);
+        fastForwarding = false;
+        warmingUp = true;
+        warmupKernelsLeft = fastForwardUntil.empty() ?
+            fastForwardKernels - kern_num : fastForwardWarmup;
+    }
+
+    if (warmupKernelsLeft) {
+        DPRINTF(GlobalScheduler, "Q[%d] Kern[%d](%s): warmup, %d warmup "
+                "kernels left\n", queue_id, kern_id,
+                kern.kernKey.kernelName, warmupKernelsLeft);
+        warmupKernelsLeft--;
+        return;
+    }
+
+    inform("GPU fast-forward done, resetting stats at kernel %d (%s)\n",
+           kern_num, kern.kernKey.kernelName);
+    warmingUp = false;
+    Stats::schedStatEvent(true, true, curTick(), 0);
+}
+
+bool
+GlobalScheduler::isFastForwardedKernel(uint32_t queue_id, uint32_t kern_id)
+{
+    return qInfo[queue_id]->isDispatchedKern(kern_id) &&
+           qInfo[queue_id]->dispKernels[kern_id].fastForwarded;
+}
+
 Tick
 GlobalScheduler::estimateKernelRuntime(uint32_t queue_id, uint32_t kern_id,
                                        uint32_t gpu_id)
@@ -934,4 +1114,369 @@ GlobalScheduler::getHomeNode(Addr address, int gpu_id, int cu_id)
         fflush(stdout);
    }
    return homeNodeMap[(address >> 12)];
-}
\ No newline at end of file
+}
+
+bool
+GlobalScheduler::isIdle() const
+{
+    if (numSendsInFlight)
+        return false;
+
+    for (const auto &q : qInfo) {
+        if (!q.second->isIdle())
+            return false;
+    }
+    return true;
+}
+
+void
+GlobalScheduler::checkDrained()
+{
+    if (drainState() == DrainState::Draining && isIdle()) {
+        DPRINTF(GlobalScheduler, "All kernels complete, drained\n");
+        signalDrainDone();
+    }
+}
+
+DrainState
+GlobalScheduler::drain()
+{
+    if (isIdle())
+        return DrainState::Drained;
+
+    DPRINTF(GlobalScheduler, "Draining, waiting for fetched kernels to "
+            "complete\n");
+    return DrainState::Draining;
+}
+
+void
+GlobalScheduler::drainResume()
+{
+    std::map<uint32_t, uint32_t> doorbells;
+    doorbells.swap(deferredDoorbells);
+    for (const auto &db : doorbells) {
+        DPRINTF(GlobalScheduler, "Q[%d]: processing deferred doorbell %d\n",
+                db.first, db.second);
+        processDoorbell(db.first, db.second);
+    }
+}
+
+void
+GlobalScheduler::serialize(CheckpointOut &cp) const
+{
+    std::vector<uint32_t> queue_ids;
+    std::vector<uint32_t> doorbells;
+    for (const auto &q : qInfo) {
+        queue_ids.push_back(q.first);
+        doorbells.push_back(doorbell_reg[q.first]);
+        q.second->serializeSection(cp, csprintf("queue%d", q.first));
+        for (int j = 0; j < num_gpus; j++) {
+            ScopedCheckpointSection sec(cp,
+                csprintf("queue%d.hsapp%d", q.first, j));
+            hsapp[j]->serializeQueue(q.first, cp);
+        }
+    }
+    SERIALIZE_CONTAINER(queue_ids);
+    SERIALIZE_CONTAINER(doorbells);
+
+    std::vector<uint32_t> deferred_queues;
+    std::vector<uint32_t> deferred_doorbells;
+    for (const auto &db : deferredDoorbells) {
+        deferred_queues.push_back(db.first);
+        deferred_doorbells.push_back(db.second);
+    }
+    SERIALIZE_CONTAINER(deferred_queues);
+    SERIALIZE_CONTAINER(deferred_doorbells);
+
+    std::vector<Addr> home_pages;
+    std::vector<int> home_nodes;
+    for (const auto &home : homeNodeMap) {
+        home_pages.push_back(home.first);
+        home_nodes.push_back(home.second);
+    }
+    SERIALIZE_CONTAINER(home_pages);
+    SERIALIZE_CONTAINER(home_nodes);
+
+    // Kernel arguments are registered by the host ahead of the launch
+    std::vector<uint32_t> arg_kernels;
+    for (uint32_t i = 0; i < incomingKernelArgs.size(); i++) {
+        if (incomingKernelArgs[i].empty())
+            continue;
+        arg_kernels.push_back(i);
+
+        std::vector<Addr> addrs;
+        std::vector<unsigned long> modes;
+        std::vector<int> same_pattern;
+        for (const auto &arg : incomingKernelArgs[i]) {
+            addrs.push_back(std::get<0>(arg));
+            modes.push_back(std::get<1>(arg).to_ulong());
+            same_pattern.push_back(std::get<2>(arg));
+        }
+        ScopedCheckpointSection sec(cp, csprintf("kernel_args%d", i));
+        SERIALIZE_CONTAINER(addrs);
+        SERIALIZE_CONTAINER(modes);
+        SERIALIZE_CONTAINER(same_pattern);
+    }
+    SERIALIZE_CONTAINER(arg_kernels);
+
+    SERIALIZE_CONTAINER(availableWFs);
+    SERIALIZE_SCALAR(num_sched_gpu);
+    uint32_t add_kernel_idx = addKernelIdx;
+    SERIALIZE_SCALAR(add_kernel_idx);
+
+    SERIALIZE_SCALAR(fastForwarding);
+    SERIALIZE_SCALAR(warmingUp);
+    SERIALIZE_SCALAR(warmupKernelsLeft);
+    SERIALIZE_SCALAR(numKernelsLaunched);
+
+    {
+        ScopedCheckpointSection sec(cp, "kernel_info");
+        kernelInfo->serialize(cp);
+    }
+    cpcohTable->serializeSection(cp, "cpcoh");
+}
+
+void
+GlobalScheduler::unserialize(CheckpointIn &cp)
+{
+    std::vector<uint32_t> queue_ids;
+    std::vector<uint32_t> doorbells;
+    UNSERIALIZE_CONTAINER(queue_ids);
+    UNSERIALIZE_CONTAINER(doorbells);
+
+    for (uint32_t i = 0; i < queue_ids.size(); i++) {
+        uint32_t queue_id = queue_ids[i];
+        fatal_if(qInfo.count(queue_id), "Restoring queue %d, which already "
+                 "exists\n", queue_id);
+
+        QInfo *q = new QInfo(0, 0, 0, 0, 0);
+        q->unserializeSection(cp, csprintf("queue%d", queue_id));
+        qInfo[queue_id] = q;
+        dbMapGlobal[q->qDesc->doorbellPointer] = queue_id;
+        doorbell_reg[queue_id] = doorbells[i];
+
+        // Register the queue with every packet processor again, then
+        // restore their own view of its indices and hw queue slot
+        for (int j = 0; j < num_gpus; j++) {
+            hsapp[j]->registerQueueFromGlobal(q->qDesc->hostReadIndexPtr,
+                                              q->qDesc->basePointer,
+                                              queue_id,
+                                              q->qDesc->numElts);
+            ScopedCheckpointSection sec(cp,
+                csprintf("queue%d.hsapp%d", queue_id, j));
+            hsapp[j]->unserializeQueue(queue_id, cp);
+        }
+    }
+
+    std::vector<uint32_t> deferred_queues;
+    std::vector<uint32_t> deferred_doorbells;
+    UNSERIALIZE_CONTAINER(deferred_queues);
+    UNSERIALIZE_CONTAINER(deferred_doorbells);
+    for (uint32_t i = 0; i < deferred_queues.size(); i++)
+        deferredDoorbells[deferred_queues[i]] = deferred_doorbells[i];
+
+    std::vector<Addr> home_pages;
+    std::vector<int> home_nodes;
+    UNSERIALIZE_CONTAINER(home_pages);
+    UNSERIALIZE_CONTAINER(home_nodes);
+    homeNodeMap.clear();
+    for (uint32_t i = 0; i < home_pages.size(); i++)
+        homeNodeMap[home_pages[i]] = home_nodes[i];
+
+    std::vector<uint32_t> arg_kernels;
+    UNSERIALIZE_CONTAINER(arg_kernels);
+    for (auto kern : arg_kernels) {
+        std::vector<Addr> addrs;
+        std::vector<unsigned long> modes;
+        std::vector<int> same_pattern;
+        ScopedCheckpointSection sec(cp, csprintf("kernel_args%d", kern));
+        UNSERIALIZE_CONTAINER(addrs);
+        UNSERIALIZE_CONTAINER(modes);
+        UNSERIALIZE_CONTAINER(same_pattern);
+
+        if (kern >= incomingKernelArgs.size())
+            incomingKernelArgs.resize(kern + 1);
+        incomingKernelArgs[kern].clear();
+        for (uint32_t i = 0; i < addrs.size(); i++) {
+            incomingKernelArgs[kern].push_back(std::make_tuple(addrs[i],
+                std::bitset<2>(modes[i]), (bool)same_pattern[i]));
+        }
+    }
+
+    UNSERIALIZE_CONTAINER(availableWFs);
+    UNSERIALIZE_SCALAR(num_sched_gpu);
+    uint32_t add_kernel_idx;
+    UNSERIALIZE_SCALAR(add_kernel_idx);
+    addKernelIdx = add_kernel_idx;
+
+    UNSERIALIZE_SCALAR(fastForwarding);
+    UNSERIALIZE_SCALAR(warmingUp);
+    UNSERIALIZE_SCALAR(warmupKernelsLeft);
+    UNSERIALIZE_SCALAR(numKernelsLaunched);
+
+    {
+        ScopedCheckpointSection sec(cp, "kernel_info");
+        kernelInfo->unserialize(cp);
+    }
+    cpcohTable->unserializeSection(cp, "cpcoh");
+}
+
+void
+QInfo::serialize(CheckpointOut &cp) const
+{
+    panic_if(!isIdle(), "Checkpointing a queue with outstanding kernels\n");
+
+    SERIALIZE_SCALAR(numKernels);
+    SERIALIZE_SCALAR(jobStart);
+    SERIALIZE_SCALAR(dispatched);
+    SERIALIZE_SCALAR(pktIdx);
+    SERIALIZE_SCALAR(dmaIdx);
+    SERIALIZE_SCALAR(dispGpu);
+    SERIALIZE_SCALAR(priority);
+
+    // Barrier packets point into the AQL buffer, so only keep their index
+    std::vector<uint32_t> barrier_idxs;
+    for (const auto &barrier : barriers)
+        barrier_idxs.push_back(barrier.barrierIdx);
+    SERIALIZE_CONTAINER(barrier_idxs);
+
+    qDesc->serializeSection(cp, "qdesc");
+    aqlBuf->serializeSection(cp, "aql_buf");
+}
+
+void
+QInfo::unserialize(CheckpointIn &cp)
+{
+    UNSERIALIZE_SCALAR(numKernels);
+    UNSERIALIZE_SCALAR(jobStart);
+    UNSERIALIZE_SCALAR(dispatched);
+    UNSERIALIZE_SCALAR(pktIdx);
+    UNSERIALIZE_SCALAR(dmaIdx);
+    UNSERIALIZE_SCALAR(dispGpu);
+    UNSERIALIZE_SCALAR(priority);
+    kernelsDmaing = 0;
+    scheduled = false;
+
+    qDesc->unserializeSection(cp, "qdesc");
+    aqlBuf->unserializeSection(cp, "aql_buf");
+
+    std::vector<uint32_t> barrier_idxs;
+    UNSERIALIZE_CONTAINER(barrier_idxs);
+    barriers.clear();
+    for (auto idx : barrier_idxs) {
+        setBarrier((_hsa_barrier_and_packet_t *)aqlBuf->ptr(idx), idx);
+    }
+}
+
+void
+KernelInfo::serialize(CheckpointOut &cp) const
+{
+    std::set<KernelKey> keys;
+    for (const auto &est : kernTimeEst)
+        keys.insert(est.first);
+    for (const auto &sample : kernSamples)
+        keys.insert(sample.first);
+
+    uint32_t num_kernels = keys.size();
+    SERIALIZE_SCALAR(num_kernels);
+
+    uint32_t idx = 0;
+    for (const auto &key : keys) {
+        Serializable::ScopedCheckpointSection sec(cp,
+            csprintf("kernel%d", idx++));
+        paramOut(cp, "name", key.kernelName);
+        paramOut(cp, "wg_size_x", key.wgSizeX);
+        paramOut(cp, "wg_size_y", key.wgSizeY);
+        paramOut(cp, "wg_size_z", key.wgSizeZ);
+
+        auto est = kernTimeEst.find(key);
+        bool has_estimate = est != kernTimeEst.end();
+        SERIALIZE_SCALAR(has_estimate);
+        if (has_estimate) {
+            paramOut(cp, "average_time", est->second.averageTime);
+            paramOut(cp, "num_wgs_executed", est->second.numWGsExecuted);
+        }
+
+        auto sample = kernSamples.find(key);
+        bool has_sample = sample != kernSamples.end();
+        SERIALIZE_SCALAR(has_sample);
+        if (has_sample) {
+            // Store the raw bits so the running mean and variance are
+            // restored exactly
+            uint64_t mean;
+            uint64_t m2;
+            std::memcpy(&mean, &sample->second.mean, sizeof(mean));
+            std::memcpy(&m2, &sample->second.m2, sizeof(m2));
+            paramOut(cp, "num_launched", sample->second.numLaunched);
+            paramOut(cp, "num_samples", sample->second.numSamples);
+            SERIALIZE_SCALAR(mean);
+            SERIALIZE_SCALAR(m2);
+        }
+    }
+}
+
+void
+KernelInfo::unserialize(CheckpointIn &cp)
+{
+    kernTimeEst.clear();
+    kernSamples.clear();
+
+    uint32_t num_kernels;
+    UNSERIALIZE_SCALAR(num_kernels);
+
+    for (uint32_t idx = 0; idx < num_kernels; idx++) {
+        Serializable::ScopedCheckpointSection sec(cp,
+            csprintf("kernel%d", idx));
+        std::string name;
+        uint32_t wg_size_x, wg_size_y, wg_size_z;
+        paramIn(cp, "name", name);
+        paramIn(cp, "wg_size_x", wg_size_x);
+        paramIn(cp, "wg_size_y", wg_size_y);
+        paramIn(cp, "wg_size_z", wg_size_z);
+        KernelKey key(name, wg_size_x, wg_size_y, wg_size_z);
+
+        bool has_estimate;
+        UNSERIALIZE_SCALAR(has_estimate);
+        if (has_estimate) {
+            WGTime &est = kernTimeEst[key];
+            paramIn(cp, "average_time", est.averageTime);
+            paramIn(cp, "num_wgs_executed", est.numWGsExecuted);
+        }
+
+        bool has_sample;
+        UNSERIALIZE_SCALAR(has_sample);
+        if (has_sample) {
+            KernelSample &sample = kernSamples[key];
+            uint64_t mean;
+            uint64_t m2;
+            paramIn(cp, "num_launched", sample.numLaunched);
+            paramIn(cp, "num_samples", sample.numSamples);
+            UNSERIALIZE_SCALAR(mean);
+            UNSERIALIZE_SCALAR(m2);
+            std::memcpy(&sample.mean, &mean, sizeof(mean));
+            std::memcpy(&sample.m2, &m2, sizeof(m2));
+        }
+    }
+}
+
+GlobalScheduler::GlobalSchedulerStats::GlobalSchedulerStats(
+    Stats::Group *parent)
+    : Stats::Group(parent),
+      ADD_STAT(numDetailedKernels, "number of kernels simulated in detail"),
+      ADD_STAT(numSampledKernels, "number of kernels sampled using the "
+               "runtime of earlier instances of the same kernel"),
+      ADD_STAT(sampledTicks, "estimated ticks charged to sampled kernels "
+               "(summed over chiplets)"),
+      ADD_STAT(sampledTicksErrorBound, "95% confidence bound on the error "
+               "of sampledTicks"),
+      ADD_STAT(sampledRelErrorBound, "relative 95% confidence bound on the "
+               "error of sampledTicks"),
+      ADD_STAT(numFastForwardedKernels, "number of kernels executed "
+               "functionally while fast-forwarding")
+{
+    // no bound until a kernel has been sampled
+    sampledRelErrorBound.functor([this]() -> Stats::Result {
+        return sampledTicks.value() ?
+            sampledTicksErrorBound.value() / sampledTicks.value() : 0;
+    });
+}
@@ -1,6 +1,7 @@
 #ifndef __GLOBAL_SCHEDULER_HH__
 #define __GLOBAL_SCHEDULER_HH__
 
+#include <cmath>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -13,6 +14,8 @@
 
 #include "base/intmath.hh"
 #include "base/logging.hh"
+#include "base/statistics.hh"
+#include "base/stats/group.hh"
 #include "debug/GlobalScheduler.hh"
 #include "dev/dma_device.hh"
 #include "dev/hsa/hsa_packet.hh"
@@ -103,16 +106,25 @@ struct KernelQInfo {
     uint32_t dispGpu;
     std::set <uint32_t> chiplets;
     std::pair<chipletID, chipletID> invalidate_flush_control;
+    // The read-only buffer arguments, which the CPs may preload into
+    // the scalar caches
+    std::vector<Addr> readOnlyArgs;
     uint32_t kernelNum;
     KernelKey kernKey;
     uint32_t numWFs;
     uint32_t num_gpus;
     uint32_t gpuDispatchedID;
+    // Sampled kernels are not simulated in detail, they complete after
+    // the estimated runtime of their KernelKey
+    bool sampled;
+    // Fast-forwarded kernels are executed functionally
+    bool fastForwarded;
 
     KernelQInfo(std::string _kernelName, _hsa_dispatch_packet_t *pkt,
               uint32_t _kernelNum, uint32_t num_gpus)
         : dispStatus(NOT_DISP), dispGpu(0), kernelNum(_kernelNum),
-          kernKey(_kernelName, pkt), num_gpus(num_gpus), gpuDispatchedID(0)
+          kernKey(_kernelName, pkt), num_gpus(num_gpus), gpuDispatchedID(0),
+          sampled(false), fastForwarded(false)
     {
         numWGs = divCeil(pkt->grid_size_x, pkt->workgroup_size_x)
                  * divCeil(pkt->grid_size_y, pkt->workgroup_size_y)
@@ -124,7 +136,7 @@ struct KernelQInfo {
         wgRunTime = std::vector<Tick>(numWGs, 0);
     }
 
-    KernelQInfo() {}
+    KernelQInfo() : sampled(false), fastForwarded(false) {}
 
 };
 
@@ -146,6 +158,43 @@ struct WGTime {
     }
 };
 
+/**
+ * Runtime of the detailed instances of a kernel on a single chiplet.
+ * Mean and variance are kept with Welford's online algorithm so that
+ * sampled instances can report a confidence interval on the runtime
+ * they were assigned.
+ */
+struct KernelSample {
+    uint32_t numLaunched;
+    uint32_t numSamples;
+    double mean;
+    double m2;
+
+    KernelSample() : numLaunched(0), numSamples(0), mean(0), m2(0)
+    {}
+
+    void addSample(Tick runtime)
+    {
+        numSamples++;
+        double delta = (double)runtime - mean;
+        mean += delta / numSamples;
+        m2 += delta * ((double)runtime - mean);
+    }
+
+    double variance() const
+    {
+        return (numSamples > 1) ? m2 / (numSamples - 1) : 0;
+    }
+
+    // Half-width of the 95% confidence interval of the mean runtime
+    double errorBound() const
+    {
+        if (numSamples == 0)
+            return 0;
+        return 1.96 * std::sqrt(variance() / numSamples);
+    }
+};
+
 class KernelInfo {
   public:
     KernelInfo(uint32_t _maxNumKerns) : maxNumKerns(_maxNumKerns) {}
@@ -191,8 +240,24 @@ class KernelInfo {
         }
     }
 
+    void recordKernelTime(KernelKey kernel, Tick runtime)
+    {
+        DPRINTF(GlobalScheduler, "Kernel %s ran for %d ticks in detail.\n",
+                kernel.kernelName, runtime);
+        kernSamples[kernel].addSample(runtime);
+    }
+
+    KernelSample &getKernelSample(KernelKey kernel)
+    {
+        return kernSamples[kernel];
+    }
+
+    void serialize(CheckpointOut &cp) const;
+    void unserialize(CheckpointIn &cp);
+
   private:
     std::map<KernelKey, WGTime> kernTimeEst;
+    std::map<KernelKey, KernelSample> kernSamples;
     uint32_t maxNumKerns;
 };
 
@@ -203,7 +268,7 @@ struct BarrierPacket {
         barrier(b), barrierIdx(idx) {}
 };
 
-class QInfo {
+class QInfo : public Serializable {
   public:
     // Should be monotonically increasing
     uint32_t numKernels;
@@ -504,6 +569,17 @@ class QInfo {
     {
         return priority;
     }
+
+    // Queues are only checkpointed at kernel boundaries, so there are no
+    // fetched or dispatched kernels to save
+    bool isIdle() const
+    {
+        return !qDesc->dmaInProgress && !scheduled && kernels.empty() &&
+               dispKernels.empty();
+    }
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
 };
 
 class GlobalScheduler : public DmaDevice
@@ -525,6 +601,13 @@ class GlobalScheduler : public DmaDevice
     typedef GlobalSchedulerParams Params;
     GlobalScheduler(const Params &p);
 
+    // Draining waits for all fetched kernels to complete so that
+    // checkpoints are taken at a kernel boundary
+    DrainState drain() override;
+    void drainResume() override;
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
     //void moveQueue(uint32_t queue_id, uint32_t gpu_id1, uint32_t gpu_id2);
     //void RRPlan(uint32_t queue_id, uint32_t num_packets);
     void createQueue(uint64_t hostReadIndexPointer,
@@ -534,6 +617,7 @@ class GlobalScheduler : public DmaDevice
                      uint32_t gpu_id);
     void destroyQueue(uint32_t queue_id);
     void updateQueue(uint32_t queue_id, uint32_t queue_priority);
+    void processDoorbell(uint32_t queue_id, uint32_t db_value);
     void sendVendor(uint32_t queue_id, uint32_t pkt_id);
     void sendKernel(uint32_t queue_id);
     void makeSchedulingDecision(uint32_t queue_id, bool isVendorPkt,
@@ -546,6 +630,13 @@ class GlobalScheduler : public DmaDevice
     void kernelWgStart(uint32_t queue_id, uint32_t kern_id, uint32_t wg_id);
     void kernelWgFinish(uint32_t queue_id, uint32_t kern_id, uint32_t wg_id);
     void updateRuntimeEstimate(uint32_t queue_id, uint32_t kern_id);
+    void decideKernelSampling(uint32_t queue_id, uint32_t kern_id);
+    bool isSampledKernel(uint32_t queue_id, uint32_t kern_id);
+    Tick sampledKernelRuntime(uint32_t queue_id, uint32_t kern_id);
+    void recordKernelRuntime(uint32_t queue_id, uint32_t kern_id,
+                             Tick runtime);
+    void decideFastForward(uint32_t queue_id, uint32_t kern_id);
+    bool isFastForwardedKernel(uint32_t queue_id, uint32_t kern_id);
     Tick estimateKernelRuntime(uint32_t queue_id, uint32_t kern_id,
                                uint32_t gpu_id);
     void processBarrier(uint32_t queue_id);
@@ -568,6 +659,8 @@ class GlobalScheduler : public DmaDevice
     bool isInvL2Done(int kernel_id, int queue_id);
     bool isFlushL2Done(int kernel_id, int queue_id);
     int getHomeNode(Addr address, int gpu_id, int cu_id);
+    bool isIdle() const;
+    void checkDrained();
 
     //Scheduling Information
     std::vector<int32_t> availableWFs;
@@ -586,13 +679,13 @@ class GlobalScheduler : public DmaDevice
     {
       protected:
         GlobalScheduler* glb_schdlr;
-        Packet* pkt_pass;
+        uint32_t db_value;
         uint32_t queue_id;
         uint32_t num_kernels;
         void* data;
 
       public:
-        GSDmaEvent(GlobalScheduler *_global_scheduler, Packet *_pkt_pass,
+        GSDmaEvent(GlobalScheduler *_global_scheduler, uint32_t _db_value,
                    uint32_t _queue_id, uint32_t _num_kernels, void* _data);
         virtual void process();
         virtual const char *description() const;
@@ -670,7 +763,38 @@ class GlobalScheduler : public DmaDevice
     uint32_t num_sched_gpu;
     bool default_acq_rel;
     uint32_t num_tccs;
+    // Number of detailed instances of a KernelKey to simulate before
+    // later instances are sampled (0 disables sampling)
+    uint32_t sampleKernelsAfter;
+    // Kernels are executed functionally until fastForwardKernels have
+    // been launched, or until the first launch of fastForwardUntil.
+    // fastForwardWarmup kernels are then simulated in detail before the
+    // stats are reset
+    uint32_t fastForwardKernels;
+    std::string fastForwardUntil;
+    uint32_t fastForwardWarmup;
+    bool fastForwarding;
+    bool warmingUp;
+    uint32_t warmupKernelsLeft;
+    uint32_t numKernelsLaunched;
+    // Kernel launch events that have been scheduled but not processed
+    uint32_t numSendsInFlight;
+    // Doorbell writes received while draining, per queue. They are
+    // processed when the simulation resumes
+    std::map<uint32_t, uint32_t> deferredDoorbells;
+
+  protected:
+    struct GlobalSchedulerStats : public Stats::Group
+    {
+        GlobalSchedulerStats(Stats::Group *parent);
 
+        Stats::Scalar numDetailedKernels;
+        Stats::Scalar numSampledKernels;
+        Stats::Scalar sampledTicks;
+        Stats::Scalar sampledTicksErrorBound;
+        Stats::Value sampledRelErrorBound;
+        Stats::Scalar numFastForwardedKernels;
+    } stats;
 };
 
 #endif
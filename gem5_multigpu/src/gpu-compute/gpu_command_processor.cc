@@ -33,17 +33,26 @@
 
 #include "gpu-compute/gpu_command_processor.hh"
 
+#include "base/intmath.hh"
 #include "debug/GPUCommandProc.hh"
 #include "debug/GPUKernelInfo.hh"
 #include "gpu-compute/dispatcher.hh"
 #include "gpu-compute/global_scheduler.hh"
+#include "mem/page_table.hh"
+#include "mem/ruby/structures/GPUPrefetcher.hh"
 #include "params/GPUCommandProcessor.hh"
 #include "sim/process.hh"
 #include "sim/proxy_ptr.hh"
 #include "sim/syscall_emul_buf.hh"
 
+int GPUCommandProcessor::dynamicTaskId = 0;
+
 GPUCommandProcessor::GPUCommandProcessor(const Params &p)
-    : HSADevice(p), dispatcher(*p.dispatcher), driver(nullptr)
+    : HSADevice(p), dispatcher(*p.dispatcher), driver(nullptr),
+      sqcPrefetchers(p.sqc_prefetchers), sqcPreloadSize(p.sqc_preload_size),
+      scalarPrefetchers(p.scalar_prefetchers),
+      preloadKernargs(p.preload_kernargs),
+      scalarPreloadSize(p.scalar_preload_size)
 {
     dispatcher.setCommandProcessor(this);
 }
@@ -85,7 +94,6 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
                                        uint32_t global_kern_id,
                                        uint32_t priority)
 {
-    static int dynamic_task_id = 0;
     _hsa_dispatch_packet_t *disp_pkt = (_hsa_dispatch_packet_t*)raw_pkt;
 
     /**
@@ -145,12 +153,12 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
     DPRINTF(GPUKernelInfo, "Kernel name: %s\n", kernel_name.c_str());
     int chiplet_id = ++global_scheduler->qInfo[global_qid]->dispKernels[global_kern_id].gpuDispatchedID;
     HSAQueueEntry *task = new HSAQueueEntry(kernel_name, queue_id,
-        dynamic_task_id, raw_pkt, &akc, host_pkt_addr, machine_code_addr,
+        dynamicTaskId, raw_pkt, &akc, host_pkt_addr, machine_code_addr,
         global_qid, global_kern_id, priority, chiplet_id, global_scheduler->qInfo[global_qid]->dispKernels[global_kern_id].num_gpus);
 
     DPRINTF(GPUCommandProc, "Task ID: %i Got AQL: wg size (%dx%dx%d), "
         "grid size (%dx%dx%d) kernarg addr: %#x, completion "
-        "signal addr:%#x chiplet ID is %d and num_gpus is %d\n", dynamic_task_id, disp_pkt->workgroup_size_x,
+        "signal addr:%#x chiplet ID is %d and num_gpus is %d\n", dynamicTaskId, disp_pkt->workgroup_size_x,
         disp_pkt->workgroup_size_y, disp_pkt->workgroup_size_z,
         disp_pkt->grid_size_x, disp_pkt->grid_size_y,
         disp_pkt->grid_size_z, disp_pkt->kernarg_address,
@@ -162,7 +170,7 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
         task->numScalarRegs(), task->codeAddr(), 0, 0);
 
     initABI(task);
-    ++dynamic_task_id;
+    ++dynamicTaskId;
 }
 
 uint64_t
@@ -297,9 +305,72 @@ GPUCommandProcessor::submitAgentDispatchPkt(void *raw_pkt, uint32_t queue_id,
 void
 GPUCommandProcessor::dispatchPkt(HSAQueueEntry *task)
 {
+    preloadCode(task);
     dispatcher.dispatch(task);
 }
 
+void
+GPUCommandProcessor::preloadCode(HSAQueueEntry *task)
+{
+    if (!sqcPreloadSize || sqcPrefetchers.empty())
+        return;
+
+    DPRINTF(GPUCommandProc, "Preloading code %#x-%#x of task %d into %d "
+            "SQCs\n", task->codeAddr(), task->codeAddr() + sqcPreloadSize,
+            task->dispatchId(), sqcPrefetchers.size());
+
+    // The code may end before the preload size does
+    preloadLines(sqcPrefetchers, task->codeAddr(),
+                 task->codeAddr() + sqcPreloadSize);
+}
+
+void
+GPUCommandProcessor::preloadArgs(HSAQueueEntry *task)
+{
+    if (!preloadKernargs || scalarPrefetchers.empty())
+        return;
+
+    DPRINTF(GPUCommandProc, "Preloading kernel args %#x-%#x of task %d "
+            "into %d scalar caches\n", task->kernargAddr(),
+            task->kernargAddr() + task->kernargSize(), task->dispatchId(),
+            scalarPrefetchers.size());
+
+    preloadLines(scalarPrefetchers, task->kernargAddr(),
+                 task->kernargAddr() + task->kernargSize());
+
+    if (!scalarPreloadSize)
+        return;
+
+    // The buffer sizes are not known, so only preload the start of each
+    // read-only buffer, where the scalar loads of constants usually are
+    const auto &read_only_args = global_scheduler->qInfo[task->globalQId()]
+        ->dispKernels[task->globalKernId()].readOnlyArgs;
+    for (Addr buf : read_only_args) {
+        DPRINTF(GPUCommandProc, "Preloading read-only buffer %#x-%#x of "
+                "task %d\n", buf, buf + scalarPreloadSize,
+                task->dispatchId());
+        preloadLines(scalarPrefetchers, buf, buf + scalarPreloadSize);
+    }
+}
+
+void
+GPUCommandProcessor::preloadLines(
+    const std::vector<GPUPrefetcher*> &prefetchers, Addr start, Addr end)
+{
+    auto process = sys->threads[0]->getProcessPtr();
+    Addr line_size = sys->cacheLineSize();
+
+    for (Addr vaddr = roundDown(start, line_size); vaddr < end;
+         vaddr += line_size) {
+        Addr paddr;
+        if (!process->pTable->translate(vaddr, paddr))
+            break;
+        for (auto *prefetcher : prefetchers) {
+            prefetcher->preload(paddr);
+        }
+    }
+}
+
 void
 GPUCommandProcessor::signalWakeupEvent(uint32_t event_id)
 {
@@ -350,6 +421,23 @@ GPUCommandProcessor::shader()
     return _shader;
 }
 
+void
+GPUCommandProcessor::serialize(CheckpointOut &cp) const
+{
+    // Every command processor holds the same value, which keeps the task
+    // IDs of kernels launched after a restore unique
+    int dynamic_task_id = dynamicTaskId;
+    SERIALIZE_SCALAR(dynamic_task_id);
+}
+
+void
+GPUCommandProcessor::unserialize(CheckpointIn &cp)
+{
+    int dynamic_task_id;
+    UNSERIALIZE_SCALAR(dynamic_task_id);
+    dynamicTaskId = dynamic_task_id;
+}
+
 void
 GPUCommandProcessor::attachGlobalScheduler(GlobalScheduler* glb_scheduler) {
     global_scheduler = glb_scheduler;
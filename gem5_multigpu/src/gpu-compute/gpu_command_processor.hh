@@ -45,6 +45,8 @@
 #ifndef __DEV_HSA_GPU_COMMAND_PROCESSOR_HH__
 #define __DEV_HSA_GPU_COMMAND_PROCESSOR_HH__
 
+#include <vector>
+
 #include "dev/hsa/hsa_device.hh"
 #include "dev/hsa/hsa_signal.hh"
 #include "gpu-compute/gpu_compute_driver.hh"
@@ -52,6 +54,7 @@
 
 struct GPUCommandProcessorParams;
 class GPUDispatcher;
+class GPUPrefetcher;
 class Shader;
 class GlobalScheduler;
 
@@ -83,8 +86,19 @@ class GPUCommandProcessor : public HSADevice
                          Addr host_pkt_addr) override;
     void attachDriver(HSADriver *driver) override;
     void dispatchPkt(HSAQueueEntry *task);
+
+    /**
+     * Preload the kernel arguments and the start of the read-only buffers
+     * they point to into the scalar caches. The dispatcher calls this once
+     * the invalidations of the kernel launch are done, so the preloads do
+     * not read lines that the launch invalidates.
+     */
+    void preloadArgs(HSAQueueEntry *task);
     void signalWakeupEvent(uint32_t event_id);
 
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
     Tick write(PacketPtr pkt) override { return 0; }
     Tick read(PacketPtr pkt) override { return 0; }
     AddrRangeList getAddrRanges() const override;
@@ -111,12 +125,37 @@ class GPUCommandProcessor : public HSADevice
     }
 
   private:
+    // Task IDs are unique across all the command processors
+    static int dynamicTaskId;
+
     Shader *_shader;
     GPUDispatcher &dispatcher;
     HSADriver *driver;
 
+    // The SQC prefetchers of this GPU, and how much kernel code to
+    // preload through them
+    std::vector<GPUPrefetcher*> sqcPrefetchers;
+    Addr sqcPreloadSize;
+
+    // The scalar cache prefetchers of this GPU, and how much of each
+    // read-only buffer to preload through them with the kernel arguments
+    std::vector<GPUPrefetcher*> scalarPrefetchers;
+    bool preloadKernargs;
+    Addr scalarPreloadSize;
+
     void initABI(HSAQueueEntry *task);
 
+    /**
+     * Preload the start of the kernel's code into the SQCs, so that the
+     * CUs do not all miss on the same lines when the kernel starts.
+     */
+    void preloadCode(HSAQueueEntry *task);
+
+    // Preload the lines of [start, end) through each of the prefetchers,
+    // stopping at the first unmapped line
+    void preloadLines(const std::vector<GPUPrefetcher*> &prefetchers,
+                      Addr start, Addr end);
+
     /**
      * Perform a DMA read of the read_dispatch_id_field_base_byte_offset
      * field, which follows directly after the read_dispatch_id (the read
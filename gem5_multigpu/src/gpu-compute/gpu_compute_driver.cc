@@ -39,12 +39,15 @@
 #include "dev/hsa/hsa_packet_processor.hh"
 #include "dev/hsa/kfd_event_defines.h"
 #include "dev/hsa/kfd_ioctl.h"
+#include "mem/page_table.hh"
 #include "params/GPUComputeDriver.hh"
 #include "sim/process.hh"
 #include "sim/syscall_emul_buf.hh"
+#include "sim/system.hh"
 
 GPUComputeDriver::GPUComputeDriver(const Params &p)
-    : HSADriver(p), num_gpus(p.num_gpus), isdGPU(p.isdGPU), gfxVersion(p.gfxVersion)
+    : HSADriver(p), num_gpus(p.num_gpus), isdGPU(p.isdGPU),
+      gfxVersion(p.gfxVersion), largePages(p.largePages)
 {
     for (int i=0; i<num_gpus; i++) {
         device[i]->attachDriver(this);
@@ -449,6 +452,8 @@ GPUComputeDriver::ioctl(ThreadContext *tc, unsigned req, Addr ioc_buf)
                 // physical address space with different memory controllers
                 // yet.  This is where we will explicitly add the PT maps to
                 // dGPU memory in the future.
+                if (largePages)
+                    mapOnLargePages(tc, args->va_addr, args->size);
             } else if (KFD_IOC_ALLOC_MEM_FLAGS_USERPTR & args->flags) {
                 DPRINTF(GPUDriver, "amdkfd allocation type: USERPTR\n");
                 mmap_offset = args->mmap_offset;
@@ -667,6 +672,36 @@ GPUComputeDriver::sleepCPU(ThreadContext *tc, uint32_t milliSecTimeout)
             "CPU %d is put to sleep\n", tc->cpuId());
 }
 
+void
+GPUComputeDriver::mapOnLargePages(ThreadContext *tc, Addr vaddr, Addr size)
+{
+    EmulationPageTable *page_table = tc->getProcessPtr()->pTable;
+    System *sys = tc->getSystemPtr();
+    const Addr page_size = page_table->pageSize();
+    const Addr large_page_size =
+        Addr(1) << EmulationPageTable::LargePageShift;
+    size = roundUp(size, page_size);
+
+    // Anything already mapped in the range is left to the lazy allocator
+    if (!page_table->isUnmapped(vaddr, size)) {
+        DPRINTF(GPUDriver, "VRAM allocation %#x-%#x is partly mapped, not "
+                "mapping it on large pages\n", vaddr, vaddr + size);
+        return;
+    }
+
+    // Skip physical pages up to the offset of vaddr in a large page
+    Addr skip = (vaddr - sys->allocPhysPages(0)) & (large_page_size - 1);
+    if (skip)
+        sys->allocPhysPages(skip / page_size);
+
+    Addr paddr = sys->allocPhysPages(size / page_size);
+    assert(((vaddr ^ paddr) & (large_page_size - 1)) == 0);
+
+    DPRINTF(GPUDriver, "Mapping VRAM allocation %#x-%#x to %#x on large "
+            "pages\n", vaddr, vaddr + size, paddr);
+    page_table->map(vaddr, paddr, size);
+}
+
 Addr
 GPUComputeDriver::gpuVmApeBase(int gpuNum) const
 {
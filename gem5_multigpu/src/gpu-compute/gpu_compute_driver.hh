@@ -60,6 +60,14 @@ class GPUComputeDriver final : public HSADriver
   private:
     bool isdGPU;
     GfxVersion gfxVersion;
+    bool largePages;
+
+    /**
+     * Map a VRAM allocation up front, on physical memory that is aligned
+     * like its virtual address within a large page, so that the page
+     * table can translate the allocation with large pages.
+     */
+    void mapOnLargePages(ThreadContext *tc, Addr vaddr, Addr size);
     /**
      * The aperture (APE) base/limit pairs are set
      * statically at startup by the real KFD. AMD
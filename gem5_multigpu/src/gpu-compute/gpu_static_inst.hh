@@ -104,6 +104,12 @@ class GPUStaticInst : public GPUStaticInstFlags
 
     virtual int coalescerTokenCount() const { return 0; }
 
+    /**
+     * The number of consecutive DWORDs each lane reads from the LDS, a
+     * wide read takes that many banks per lane.
+     */
+    virtual int ldsReadDWords() const { return 1; }
+
     bool isALU() const { return _flags[ALU]; }
     bool isBranch() const { return _flags[Branch]; }
     bool isCondBranch() const { return _flags[CondBranch]; }
@@ -77,6 +77,7 @@ class HSAQueueEntry
                             ->completion_signal),
           codeAddress(code_addr),
           kernargAddress(((_hsa_dispatch_packet_t*)disp_pkt)->kernarg_address),
+          _kernargSize(akc->kernarg_segment_byte_size),
           _outstandingInvs(-1), _outstandingWbs(-1),
           _ldsSize((int)((_hsa_dispatch_packet_t*)disp_pkt)->
                    group_segment_size),
@@ -84,7 +85,8 @@ class HSAQueueEntry
                          private_segment_size),
           _contextId(0), _wgId{{ 0, 0, 0 }},
           _numWgTotal(1), numWgArrivedAtBarrier(0), _numWgCompleted(0),
-          _globalWgId(0), dispatchComplete(false),
+          _globalWgId(0), dispatchComplete(false), _argsPreloaded(false),
+          _fastForward(false),
           global_qid(_global_qid), global_kern_id(_global_kern_id),
           priority(_priority), chiplet_id(_chiplet_id), num_gpus(_num_gpus)
     {
@@ -204,6 +206,12 @@ class HSAQueueEntry
         return kernargAddress;
     }
 
+    Addr
+    kernargSize() const
+    {
+        return _kernargSize;
+    }
+
     int
     ldsSize() const
     {
@@ -224,6 +232,30 @@ class HSAQueueEntry
         return dispatchComplete;
     }
 
+    bool
+    argsPreloaded() const
+    {
+        return _argsPreloaded;
+    }
+
+    void
+    markArgsPreloaded()
+    {
+        _argsPreloaded = true;
+    }
+
+    bool
+    fastForward() const
+    {
+        return _fastForward;
+    }
+
+    void
+    markFastForward()
+    {
+        _fastForward = true;
+    }
+
     int
     wgId(int dim) const
     {
@@ -515,6 +547,8 @@ class HSAQueueEntry
     Addr codeAddress;
     // base address of the kernel args
     Addr kernargAddress;
+    // size of the kernel args
+    Addr _kernargSize;
     /**
      * Number of outstanding invs for the kernel.
      * values:
@@ -545,6 +579,10 @@ class HSAQueueEntry
     int _globalWgId;
     int _globalWgIdend;
     bool dispatchComplete;
+    // whether the CP preloaded the kernel args into the scalar caches
+    bool _argsPreloaded;
+    // whether the WGs of this kernel are executed functionally
+    bool _fastForward;
 
     std::bitset<NumVectorInitFields> initialVgprState;
     std::bitset<NumScalarInitFields> initialSgprState;
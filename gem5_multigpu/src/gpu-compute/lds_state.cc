@@ -33,9 +33,11 @@
 
 #include "gpu-compute/lds_state.hh"
 
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include "gpu-compute/compute_unit.hh"
 #include "gpu-compute/gpu_dyn_inst.hh"
@@ -51,7 +53,9 @@ LdsState::LdsState(const Params &params) :
     maximumSize(params.size),
     range(params.range),
     bankConflictPenalty(params.bankConflictPenalty),
-    banks(params.banks)
+    banks(params.banks),
+    dwordBanks(params.dwordBanks),
+    directWideReads(params.directWideReads)
 {
     fatal_if(params.banks <= 0,
              "Number of LDS banks should be positive number");
@@ -61,6 +65,9 @@ LdsState::LdsState(const Params &params) :
              "cannot allocate an LDS with a size less than 1");
     fatal_if(params.size % 2,
           "the LDS should be an even number");
+
+    store.resize(maximumSize, 0);
+    bankCounts.resize(banks, 0);
 }
 
 /**
@@ -78,6 +85,90 @@ LdsState::setParent(ComputeUnit *x_parent)
     _name = x_parent->name() + ".LdsState";
 }
 
+/**
+ * give a workgroup its chunk of the LDS
+ */
+LdsChunk *
+LdsState::reserveSpace(const uint32_t dispatchId, const uint32_t wgId,
+                       const uint32_t size)
+{
+    panic_if(findSlot(dispatchId, wgId) >= 0,
+             "duplicate workgroup ID asking for space in the LDS "
+             "did[%d] wgid[%d]", dispatchId, wgId);
+
+    if (!canReserve(size)) {
+        return nullptr;
+    }
+
+    // reuse the slot of a workgroup that has finished
+    WgSlot *slot = nullptr;
+    for (auto &s : slots) {
+        if (!s.valid) {
+            slot = &s;
+            break;
+        }
+    }
+    if (!slot) {
+        slots.emplace_back();
+        slot = &slots.back();
+    }
+
+    uint32_t offset = findSpace(size);
+    // the LDS a workgroup gets starts out as zeros
+    std::fill_n(store.begin() + offset, size, 0);
+    bytesAllocated += size;
+
+    slot->valid = true;
+    slot->dispatchId = dispatchId;
+    slot->wgId = wgId;
+    slot->refCount = 0;
+    slot->chunk = LdsChunk(store.data() + offset, size);
+
+    return &slot->chunk;
+}
+
+uint32_t
+LdsState::findSpace(const uint32_t size)
+{
+    std::vector<LdsChunk *> chunks;
+    for (auto &slot : slots) {
+        if (slot.valid && slot.chunk.size()) {
+            chunks.push_back(&slot.chunk);
+        }
+    }
+    std::sort(chunks.begin(), chunks.end(),
+              [](const LdsChunk *a, const LdsChunk *b)
+              { return a->base < b->base; });
+
+    // the first gap the chunk fits in
+    uint32_t free_start = 0;
+    for (auto *chunk : chunks) {
+        uint32_t offset = chunk->base - store.data();
+        if (offset - free_start >= size) {
+            return free_start;
+        }
+        free_start = offset + chunk->size();
+    }
+    if (maximumSize - free_start >= size) {
+        return free_start;
+    }
+
+    // there is enough space, but not in one piece, so move the chunks
+    // down to the start of the store. The wavefronts point to the chunks,
+    // not to their data, so they see the data where it moved to
+    free_start = 0;
+    for (auto *chunk : chunks) {
+        uint8_t *dest = store.data() + free_start;
+        if (chunk->base != dest) {
+            std::memmove(dest, chunk->base, chunk->size());
+            chunk->base = dest;
+        }
+        free_start += chunk->size();
+    }
+    assert(maximumSize - free_start >= size);
+    return free_start;
+}
+
 /**
  * derive the gpu mem packet from the packet and then count the bank conflicts
  */
@@ -99,65 +190,75 @@ LdsState::countBankConflicts(PacketPtr packet, unsigned *bankAccesses)
     return countBankConflicts(gpuDynInst, bankAccesses);
 }
 
+int
+LdsState::laneDWords(GPUDynInstPtr gpuDynInst)
+{
+    return gpuDynInst->isLoad() ?
+        std::max(gpuDynInst->staticInstruction()->ldsReadDWords(), 1) : 1;
+}
+
 // Count the total number of bank conflicts for the local memory packet
 unsigned
 LdsState::countBankConflicts(GPUDynInstPtr gpuDynInst,
                              unsigned *numBankAccesses)
 {
-    int bank_conflicts = 0;
-    std::vector<int> bank;
-    // the number of LDS banks being touched by the memory instruction
-    int numBanks = std::min(parent->wfSize(), banks);
-    // if the wavefront size is larger than the number of LDS banks, we
-    // need to iterate over all work items to calculate the total
-    // number of bank conflicts
-    int groups = (parent->wfSize() > numBanks) ?
-        (parent->wfSize() / numBanks) : 1;
-    for (int i = 0; i < groups; i++) {
-        // Address Array holding all the work item addresses of an instruction
-        std::vector<Addr> addr_array;
-        addr_array.resize(numBanks, 0);
-        bank.clear();
-        bank.resize(banks, 0);
-        int max_bank = 0;
-
-        // populate the address array for all active work items
-        for (int j = 0; j < numBanks; j++) {
-            if (gpuDynInst->exec_mask[(i*numBanks)+j]) {
-                addr_array[j] = gpuDynInst->addr[(i*numBanks)+j];
-            } else {
-                addr_array[j] = std::numeric_limits<Addr>::max();
-            }
-        }
+    const int wf_size = parent->wfSize();
+    const int lane_dwords = laneDWords(gpuDynInst);
+    // each lane of a wide read takes a bank for each of its DWORDs, so
+    // the LDS serves fewer of its lanes at once
+    const int lanes_per_pass =
+        std::max(1, std::min(wf_size, banks / lane_dwords));
+    // identical addresses are read or written once
+    const bool merge = gpuDynInst->isLoad() || gpuDynInst->isStore();
+    // the banks are interleaved by DWORD, or by byte address as in the
+    // original model
+    const Addr bank_unit = dwordBanks ? sizeof(uint32_t) : 1;
+    const Addr dword_units = sizeof(uint32_t) / bank_unit;
+
+    if (passDWords.size() < (size_t)(lanes_per_pass * lane_dwords)) {
+        passDWords.resize(lanes_per_pass * lane_dwords);
+    }
 
-        if (gpuDynInst->isLoad() || gpuDynInst->isStore()) {
-            // mask identical addresses
-            for (int j = 0; j < numBanks; ++j) {
-                for (int j0 = 0; j0 < j; j0++) {
-                    if (addr_array[j] != std::numeric_limits<Addr>::max()
-                                    && addr_array[j] == addr_array[j0]) {
-                        addr_array[j] = std::numeric_limits<Addr>::max();
-                    }
+    unsigned bank_conflicts = 0;
+    for (int first = 0; first < wf_size; first += lanes_per_pass) {
+        const int last = std::min(first + lanes_per_pass, wf_size);
+
+        // the bank addresses of the DWORDs the active lanes of this pass
+        // access
+        int num_dwords = 0;
+        for (int lane = first; lane < last; ++lane) {
+            if (gpuDynInst->exec_mask[lane]) {
+                Addr dword = gpuDynInst->addr[lane] / bank_unit;
+                for (int i = 0; i < lane_dwords; ++i) {
+                    passDWords[num_dwords++] = dword + i * dword_units;
                 }
             }
         }
-        // calculate bank conflicts
-        for (int j = 0; j < numBanks; ++j) {
-            if (addr_array[j] != std::numeric_limits<Addr>::max()) {
-                int bankId = addr_array[j] % banks;
-                bank[bankId]++;
-                max_bank = std::max(max_bank, bank[bankId]);
-                // Count the number of LDS banks accessed.
-                // Since we have masked identical addresses all remaining
-                // accesses will need to be serialized if they access
-                // the same bank (bank conflict).
-                (*numBankAccesses)++;
-            }
+        if (!num_dwords) {
+            continue;
+        }
+
+        auto dwords_end = passDWords.begin() + num_dwords;
+        if (merge) {
+            std::sort(passDWords.begin(), dwords_end);
+            dwords_end = std::unique(passDWords.begin(), dwords_end);
         }
-        bank_conflicts += max_bank;
+
+        // the accesses left need to be serialized if they are to the
+        // same bank, so the pass takes as long as its busiest bank
+        std::fill(bankCounts.begin(), bankCounts.end(), 0);
+        for (auto it = passDWords.begin(); it != dwords_end; ++it) {
+            bankCounts[*it % banks]++;
+        }
+        bank_conflicts += *std::max_element(bankCounts.begin(),
+                                            bankCounts.end());
+        // Count the number of LDS banks accessed.
+        (*numBankAccesses) += dwords_end - passDWords.begin();
     }
-    panic_if(bank_conflicts > parent->wfSize(),
-             "Max bank conflicts should match num of work items per instr");
+    // with fewer banks than a lane reads DWORDs, a pass of one lane can
+    // take up to lane_dwords cycles
+    panic_if(bank_conflicts > (unsigned)(wf_size * lane_dwords),
+             "Max bank conflicts should match num of DWORDs per instr");
     return bank_conflicts;
 }
 
@@ -199,6 +300,15 @@ LdsState::processPacket(PacketPtr packet)
     int busLength = (dynInst->isLoad()) ? parent->loadBusLength() :
         (dynInst->isStore()) ? parent->storeBusLength() :
         parent->loadBusLength();
+    int lane_dwords = laneDWords(dynInst);
+    if (lane_dwords > 1) {
+        parent->stats.ldsWideReads++;
+        // without the direct path to the VGPRs, a wide read returns one
+        // DWORD per lane at a time over the return bus
+        if (!directWideReads) {
+            busLength *= lane_dwords;
+        }
+    }
     // delay for accessing the LDS
     Tick processingTime =
         parent->cyclesToTicks(Cycles(bankConflicts * bankConflictPenalty)) +
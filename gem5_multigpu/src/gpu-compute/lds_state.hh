@@ -35,9 +35,9 @@
 #define __LDS_STATE_HH__
 
 #include <array>
+#include <deque>
 #include <queue>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -50,13 +50,14 @@ class ComputeUnit;
 
 /**
  * this represents a slice of the overall LDS, intended to be associated with
- * an individual workgroup
+ * an individual workgroup. The data lives in the LDS's store, the chunk
+ * only points to the part of it that belongs to the workgroup.
  */
 class LdsChunk
 {
   public:
-    LdsChunk(const uint32_t x_size):
-        chunk(x_size)
+    LdsChunk(uint8_t *x_base, const uint32_t x_size):
+        base(x_base), chunkSize(x_size)
     {
     }
 
@@ -73,11 +74,11 @@ class LdsChunk
          * For reads that are outside the bounds of the LDS
          * chunk allocated to this WG we return 0.
          */
-        if (index >= chunk.size()) {
+        if (!inBounds<T>(index)) {
             return (T)0;
         }
 
-        T *p0 = (T *) (&(chunk.at(index)));
+        T *p0 = (T *) (base + index);
         return *p0;
     }
 
@@ -92,11 +93,11 @@ class LdsChunk
          * Writes that are outside the bounds of the LDS
          * chunk allocated to this WG are dropped.
          */
-        if (index >= chunk.size()) {
+        if (!inBounds<T>(index)) {
             return;
         }
 
-        T *p0 = (T *) (&(chunk.at(index)));
+        T *p0 = (T *) (base + index);
         *p0 = value;
     }
 
@@ -111,10 +112,10 @@ class LdsChunk
          * Atomics that are outside the bounds of the LDS
          * chunk allocated to this WG are dropped.
          */
-        if (index >= chunk.size()) {
+        if (!inBounds<T>(index)) {
             return (T)0;
         }
-        T *p0 = (T *) (&(chunk.at(index)));
+        T *p0 = (T *) (base + index);
         T tmp = *p0;
 
        (*amoOp)((uint8_t *)p0);
@@ -124,15 +125,31 @@ class LdsChunk
     /**
      * get the size of this chunk
      */
-    std::vector<uint8_t>::size_type
+    std::size_t
     size() const
     {
-        return chunk.size();
+        return chunkSize;
     }
 
   protected:
-    // the actual data store for this slice of the LDS
-    std::vector<uint8_t> chunk;
+    friend class LdsState;
+
+    /**
+     * whether all of the T at this index is in the chunk. The chunks of
+     * the workgroups are next to each other in the LDS, so an access that
+     * only starts in the chunk would reach into the next one.
+     */
+    template<class T>
+    bool
+    inBounds(const uint32_t index) const
+    {
+        return index < chunkSize && sizeof(T) <= chunkSize - index;
+    }
+
+    // the start of this slice in the LDS's store
+    uint8_t *base = nullptr;
+    // the number of bytes in this slice
+    uint32_t chunkSize = 0;
 };
 
 // Local Data Share (LDS) State per Wavefront (contents of the LDS region
@@ -236,21 +253,41 @@ class LdsState: public ClockedObject
   protected:
 
     /**
-     * the lds reference counter
-     * The key is the workgroup ID and dispatch ID
-     * The value is the number of wavefronts that reference this LDS, as
-     * wavefronts are launched, the counter goes up for that workgroup and when
-     * they return it decreases, once it reaches 0 then this chunk of the LDS
-     * is returned to the available pool. However,it is deallocated on the 1->0
-     * transition, not whenever the counter is 0 as it always starts with 0
-     * when the workgroup asks for space
+     * the slot of a workgroup that has space in the LDS
+     */
+    struct WgSlot
+    {
+        bool valid = false;
+        uint32_t dispatchId = 0;
+        uint32_t wgId = 0;
+        /**
+         * the number of wavefronts that reference this LDS, as
+         * wavefronts are launched, the counter goes up for that workgroup
+         * and when they return it decreases, once it reaches 0 then this
+         * chunk of the LDS is returned to the available pool. However, it
+         * is deallocated on the 1->0 transition, not whenever the counter
+         * is 0 as it always starts with 0 when the workgroup asks for space
+         */
+        int32_t refCount = 0;
+        LdsChunk chunk;
+    };
+
+    // the data of all of the workgroups on the CU, each one's chunk is a
+    // contiguous part of it
+    std::vector<uint8_t> store;
+
+    /**
+     * the slots of the workgroups, found by the dispatch ID and workgroup
+     * ID. There are only as many as the workgroups that were on the CU at
+     * once, so searching them is cheaper than hashing. A deque so that the
+     * chunks do not move when a slot is added, the wavefronts point to them
      */
-    std::unordered_map<uint32_t,
-                       std::unordered_map<uint32_t, int32_t>> refCounter;
+    std::deque<WgSlot> slots;
 
-    // the map that allows workgroups to access their own chunk of the LDS
-    std::unordered_map<uint32_t,
-                       std::unordered_map<uint32_t, LdsChunk>> chunkMap;
+    // scratch space for counting the bank conflicts, kept to not
+    // allocate it for every packet
+    std::vector<Addr> passDWords;
+    std::vector<unsigned> bankCounts;
 
     // an event to allow the LDS to wake up at a specified time
     TickEvent tickEvent;
@@ -279,6 +316,47 @@ class LdsState: public ClockedObject
     countBankConflicts(GPUDynInstPtr gpuDynInst,
                        unsigned *numBankAccesses);
 
+    /**
+     * the number of consecutive DWORDs each lane of this instruction
+     * accesses, which wide reads take from as many consecutive banks
+     */
+    int laneDWords(GPUDynInstPtr gpuDynInst);
+
+    /**
+     * the index of the slot of this workgroup, or -1 if it has none
+     */
+    int
+    findSlot(const uint32_t dispatchId, const uint32_t wgId) const
+    {
+        for (int i = 0; i < (int)slots.size(); ++i) {
+            const WgSlot &slot = slots[i];
+            if (slot.valid && slot.dispatchId == dispatchId &&
+                slot.wgId == wgId) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * the slot of this workgroup, which must have one
+     */
+    WgSlot &
+    getSlot(const uint32_t dispatchId, const uint32_t wgId)
+    {
+        int idx = findSlot(dispatchId, wgId);
+        fatal_if(idx < 0, "could not find this workgroup id within this "
+                 "dispatch id did[%d] wgid[%d]", dispatchId, wgId);
+        return slots[idx];
+    }
+
+    /**
+     * find where a chunk of this size fits in the store, compacting the
+     * chunks if the free space is only there in pieces
+     */
+    uint32_t
+    findSpace(const uint32_t size);
+
   public:
     typedef LdsStateParams Params;
 
@@ -320,10 +398,10 @@ class LdsState: public ClockedObject
     int
     increaseRefCounter(const uint32_t dispatchId, const uint32_t wgId)
     {
-        int refCount = getRefCounter(dispatchId, wgId);
-        fatal_if(refCount < 0,
+        WgSlot &slot = getSlot(dispatchId, wgId);
+        fatal_if(slot.refCount < 0,
                  "reference count should not be below zero");
-        return ++refCounter[dispatchId][wgId];
+        return ++slot.refCount;
     }
 
     /**
@@ -333,19 +411,19 @@ class LdsState: public ClockedObject
     int
     decreaseRefCounter(const uint32_t dispatchId, const uint32_t wgId)
     {
-      int refCount = getRefCounter(dispatchId, wgId);
+      WgSlot &slot = getSlot(dispatchId, wgId);
 
-      fatal_if(refCount <= 0,
+      fatal_if(slot.refCount <= 0,
               "reference count should not be below zero or at zero to"
               "decrement");
 
-      refCounter[dispatchId][wgId]--;
+      slot.refCount--;
 
-      if (refCounter[dispatchId][wgId] == 0) {
+      if (slot.refCount == 0) {
         releaseSpace(dispatchId, wgId);
         return 0;
       } else {
-        return refCounter[dispatchId][wgId];
+        return slot.refCount;
       }
     }
 
@@ -355,30 +433,12 @@ class LdsState: public ClockedObject
     int
     getRefCounter(const uint32_t dispatchId, const uint32_t wgId) const
     {
-      auto dispatchIter = chunkMap.find(dispatchId);
-      fatal_if(dispatchIter == chunkMap.end(),
-               "could not locate this dispatch id [%d]", dispatchId);
-
-      auto workgroup = dispatchIter->second.find(wgId);
-      fatal_if(workgroup == dispatchIter->second.end(),
+      int idx = findSlot(dispatchId, wgId);
+      fatal_if(idx < 0,
                "could not find this workgroup id within this dispatch id"
                " did[%d] wgid[%d]", dispatchId, wgId);
 
-      auto refCountIter = refCounter.find(dispatchId);
-      if (refCountIter == refCounter.end()) {
-        fatal("could not locate this dispatch id [%d]", dispatchId);
-      } else {
-        auto workgroup = refCountIter->second.find(wgId);
-        if (workgroup == refCountIter->second.end()) {
-          fatal("could not find this workgroup id within this dispatch id"
-                  " did[%d] wgid[%d]", dispatchId, wgId);
-        } else {
-          return refCounter.at(dispatchId).at(wgId);
-        }
-      }
-
-      fatal("should not reach this point");
-      return 0;
+      return slots[idx].refCount;
     }
 
     /**
@@ -387,29 +447,7 @@ class LdsState: public ClockedObject
      */
     LdsChunk *
     reserveSpace(const uint32_t dispatchId, const uint32_t wgId,
-            const uint32_t size)
-    {
-        if (chunkMap.find(dispatchId) != chunkMap.end()) {
-            panic_if(
-                chunkMap[dispatchId].find(wgId) != chunkMap[dispatchId].end(),
-                "duplicate workgroup ID asking for space in the LDS "
-                "did[%d] wgid[%d]", dispatchId, wgId);
-        }
-
-        if (bytesAllocated + size > maximumSize) {
-            return nullptr;
-        } else {
-            bytesAllocated += size;
-
-            auto value = chunkMap[dispatchId].emplace(wgId, LdsChunk(size));
-            panic_if(!value.second, "was unable to allocate a new chunkMap");
-
-            // make an entry for this workgroup
-            refCounter[dispatchId][wgId] = 0;
-
-            return &chunkMap[dispatchId][wgId];
-        }
-    }
+            const uint32_t size);
 
     /*
      * return pointer to lds chunk for wgid
@@ -417,14 +455,12 @@ class LdsState: public ClockedObject
     LdsChunk *
     getLdsChunk(const uint32_t dispatchId, const uint32_t wgId)
     {
-      fatal_if(chunkMap.find(dispatchId) == chunkMap.end(),
-          "fetch for unknown dispatch ID did[%d]", dispatchId);
-
-      fatal_if(chunkMap[dispatchId].find(wgId) == chunkMap[dispatchId].end(),
+      int idx = findSlot(dispatchId, wgId);
+      fatal_if(idx < 0,
           "fetch for unknown workgroup ID wgid[%d] in dispatch ID did[%d]",
           wgId, dispatchId);
 
-      return &chunkMap[dispatchId][wgId];
+      return &slots[idx].chunk;
     }
 
     bool
@@ -475,9 +511,9 @@ class LdsState: public ClockedObject
      * get the allocated size for this workgroup
      */
     std::size_t
-    ldsSize(const uint32_t x_wgId)
+    ldsSize(const uint32_t dispatchId, const uint32_t wgId)
     {
-        return chunkMap[x_wgId].size();
+        return getLdsChunk(dispatchId, wgId)->size();
     }
 
     AddrRange
@@ -513,23 +549,17 @@ class LdsState: public ClockedObject
     bool
     releaseSpace(const uint32_t x_dispatchId, const uint32_t x_wgId)
     {
-        auto dispatchIter = chunkMap.find(x_dispatchId);
+        int idx = findSlot(x_dispatchId, x_wgId);
+        fatal_if(idx < 0, "workgroup id [%d] not found in dispatch id [%d]",
+                 x_wgId, x_dispatchId);
 
-        if (dispatchIter == chunkMap.end()) {
-          fatal("dispatch id not found [%d]", x_dispatchId);
-        } else {
-          auto workgroupIter = dispatchIter->second.find(x_wgId);
-          if (workgroupIter == dispatchIter->second.end()) {
-            fatal("workgroup id [%d] not found in dispatch id [%d]",
-                    x_wgId, x_dispatchId);
-          }
-        }
-
-        fatal_if(bytesAllocated < chunkMap[x_dispatchId][x_wgId].size(),
+        WgSlot &slot = slots[idx];
+        fatal_if(bytesAllocated < (int)slot.chunk.size(),
                  "releasing more space than was allocated");
 
-        bytesAllocated -= chunkMap[x_dispatchId][x_wgId].size();
-        chunkMap[x_dispatchId].erase(chunkMap[x_dispatchId].find(x_wgId));
+        bytesAllocated -= slot.chunk.size();
+        slot.valid = false;
+        slot.chunk = LdsChunk();
         return true;
     }
 
@@ -554,6 +584,13 @@ class LdsState: public ClockedObject
 
     // the number of banks in the LDS underlying data store
     int banks = 0;
+
+    // whether the banks are interleaved by DWORD instead of by byte address
+    bool dwordBanks = false;
+
+    // whether wide reads go to the VGPRs at the LDS width, rather than
+    // over the return bus one DWORD per lane at a time
+    bool directWideReads = true;
 };
 
 #endif // __LDS_STATE_HH__
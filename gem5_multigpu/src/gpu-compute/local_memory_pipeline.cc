@@ -121,6 +121,17 @@ void
 LocalMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
 {
     Wavefront *wf = gpuDynInst->wavefront();
+    if (wf->fastForward) {
+        // fast-forwarded LDS accesses complete as soon as they issue
+        gpuDynInst->initiateAcc(gpuDynInst);
+        gpuDynInst->completeAcc(gpuDynInst);
+
+        wf->releaseLmResource(gpuDynInst);
+        wf->decLGKMInstsIssued();
+        wf->validateRequestCounters();
+        return;
+    }
+
     if (gpuDynInst->isLoad()) {
         wf->rdLmReqsInPipe--;
         wf->outstandingReqsRdLm++;
@@ -145,6 +145,19 @@ void
 ScalarMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
 {
     Wavefront *wf = gpuDynInst->wavefront();
+    if (wf->fastForward) {
+        // fast-forwarded accesses complete as soon as they issue, so
+        // there is nothing for a memory sync to order
+        if (!gpuDynInst->isMemSync()) {
+            gpuDynInst->initiateAcc(gpuDynInst);
+            gpuDynInst->completeAcc(gpuDynInst);
+        }
+
+        wf->releaseGmResource(gpuDynInst);
+        wf->decLGKMInstsIssued();
+        return;
+    }
+
     if (gpuDynInst->isLoad()) {
         wf->scalarRdGmReqsInPipe--;
         wf->scalarOutstandingReqsRdGm++;
@@ -136,17 +136,7 @@ ScheduleStage::exec()
             wf->stats.schCycles++;
             stats.addToSchListStalls[j]++;
         } else {
-            if (gpu_dyn_inst->isScalar() || gpu_dyn_inst->isGroupSeg()) {
-                wf->incLGKMInstsIssued();
-            } else {
-                wf->incVMemInstsIssued();
-                if (gpu_dyn_inst->isFlat()) {
-                    wf->incLGKMInstsIssued();
-                }
-            }
-            if (gpu_dyn_inst->isStore() && gpu_dyn_inst->isGlobalSeg()) {
-                wf->incExpInstsIssued();
-            }
+            wf->incMemInstsIssued(gpu_dyn_inst);
         }
     }
 
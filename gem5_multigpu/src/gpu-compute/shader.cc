@@ -65,6 +65,7 @@ Shader::Shader(const Params &p) : ClockedObject(p),
     timingSim(p.timing), hsail_mode(SIMT),
     impl_kern_launch_acq(p.impl_kern_launch_acq),
     impl_kern_end_rel(p.impl_kern_end_rel),
+    impl_wg_end_l1_rel(p.impl_wg_end_l1_rel),
     coissue_return(1),
     trace_vgpr_all(1), n_cu((p.CUs).size()), n_wf(p.n_wf),
     globalMemSize(p.globalmem),
@@ -199,6 +199,8 @@ class Shader : public ClockedObject
     int impl_kern_launch_acq;
     // If set, issue rel packet @ kernel end
     int impl_kern_end_rel;
+    // If set, write the dirty L1 lines back @ workgroup end
+    int impl_wg_end_l1_rel;
     // If set, fetch returns may be coissued with instructions
     int coissue_return;
     // If set, always dump all 64 gprs to trace
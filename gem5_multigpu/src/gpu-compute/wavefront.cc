@@ -81,6 +81,7 @@ Wavefront::Wavefront(const Params &p)
 
     pendingFetch = false;
     dropFetch = false;
+    fastForward = false;
     maxVgprs = 0;
     maxSgprs = 0;
 
@@ -594,6 +595,50 @@ Wavefront::start(uint64_t _wf_dyn_id, Addr init_pc)
     vecReads.resize(maxVgprs, 0);
 }
 
+/**
+ * Execute this wavefront functionally, one instruction after another,
+ * until it either ends or stalls at a barrier. Memory instructions
+ * complete as soon as they are issued, so waitcnts and sleeps are
+ * no-ops. Memory instructions are still counted as issued, as the SCH
+ * stage would, because their execute and the memory pipelines release
+ * them as usual.
+ */
+void
+Wavefront::execFunctional()
+{
+    while (status == S_RUNNING) {
+        GPUDynInstPtr ii =
+            computeUnit->fetchStage.fetchUnit(simdId).fetchFunctional(this);
+        instructionBuffer.push_back(ii);
+
+        const Addr old_pc = pc();
+        DPRINTF(GPUExec, "CU%d: WF[%d][%d]: wave[%d] Functionally executing "
+                "inst: %s (pc: %#x)\n", computeUnit->cu_id, simdId,
+                wfSlotId, wfDynId, ii->disassemble(), old_pc);
+
+        if (ii->isBarrier() && hasBarrier()) {
+            setStatus(S_BARRIER);
+        }
+
+        if (ii->isFlat() || ii->isGlobalMem() || ii->isLocalMem() ||
+            ii->isPrivateSeg()) {
+            reserveResources();
+            incMemInstsIssued(ii);
+        }
+
+        if (!ii->isWaitcnt() && !ii->isSleep()) {
+            ii->execute(ii);
+        }
+
+        computeUnit->stats.numInstrFastForwarded++;
+
+        if (pc() == old_pc) {
+            _gpuISA.advancePC(ii);
+        }
+        instructionBuffer.clear();
+    }
+}
+
 bool
 Wavefront::isGmInstruction(GPUDynInstPtr ii)
 {
@@ -836,6 +881,49 @@ Wavefront::reserveLmResource(GPUDynInstPtr ii)
     execUnitId = localMem;
 }
 
+void
+Wavefront::releaseGmResource(GPUDynInstPtr ii)
+{
+    if (!ii->isScalar()) {
+        if (ii->isLoad()) {
+            rdGmReqsInPipe--;
+        } else if (ii->isStore()) {
+            wrGmReqsInPipe--;
+        } else if (ii->isAtomic() || ii->isMemSync()) {
+            rdGmReqsInPipe--;
+            wrGmReqsInPipe--;
+        } else {
+            panic("Invalid memory operation!\n");
+        }
+    } else {
+        if (ii->isLoad()) {
+            scalarRdGmReqsInPipe--;
+        } else if (ii->isStore()) {
+            scalarWrGmReqsInPipe--;
+        } else if (ii->isAtomic() || ii->isMemSync()) {
+            scalarWrGmReqsInPipe--;
+            scalarRdGmReqsInPipe--;
+        } else {
+            panic("Invalid memory operation!\n");
+        }
+    }
+}
+
+void
+Wavefront::releaseLmResource(GPUDynInstPtr ii)
+{
+    if (ii->isLoad()) {
+        rdLmReqsInPipe--;
+    } else if (ii->isStore()) {
+        wrLmReqsInPipe--;
+    } else if (ii->isAtomic() || ii->isMemSync()) {
+        wrLmReqsInPipe--;
+        rdLmReqsInPipe--;
+    } else {
+        panic("Invalid memory operation!\n");
+    }
+}
+
 std::vector<int>
 Wavefront::reserveResources()
 {
@@ -1373,6 +1461,26 @@ Wavefront::incLGKMInstsIssued()
     ++lgkmInstsIssued;
 }
 
+/**
+ * Count a memory instruction the SCH stage has picked, the memory
+ * pipelines decrement the counts when the access completes.
+ */
+void
+Wavefront::incMemInstsIssued(GPUDynInstPtr ii)
+{
+    if (ii->isScalar() || ii->isGroupSeg()) {
+        incLGKMInstsIssued();
+    } else {
+        incVMemInstsIssued();
+        if (ii->isFlat()) {
+            incLGKMInstsIssued();
+        }
+    }
+    if (ii->isStore() && ii->isGlobalSeg()) {
+        incExpInstsIssued();
+    }
+}
+
 void
 Wavefront::decVMemInstsIssued()
 {
@@ -165,6 +165,9 @@ class Wavefront : public SimObject
     uint32_t wfId;
     uint32_t maxDynWaveId;
     uint32_t dispatchId;
+    // is the kernel of this wavefront fast-forwarded? if so, it executes
+    // functionally, bypassing the CU pipeline and the memory timing
+    bool fastForward;
     // vector and scalar memory requests pending in memory system
     int outstandingReqs;
     // outstanding global memory write requests
@@ -253,8 +256,12 @@ class Wavefront : public SimObject
     void validateRequestCounters();
     void start(uint64_t _wfDynId, uint64_t _base_ptr);
     void exec();
+    void execFunctional();
     // called by SCH stage to reserve
     std::vector<int> reserveResources();
+    // called by the memory pipelines when a fast-forwarded access is done
+    void releaseGmResource(GPUDynInstPtr ii);
+    void releaseLmResource(GPUDynInstPtr ii);
     bool stopFetch();
 
     Addr pc() const;
@@ -276,6 +283,7 @@ class Wavefront : public SimObject
     void decVMemInstsIssued();
     void decExpInstsIssued();
     void decLGKMInstsIssued();
+    void incMemInstsIssued(GPUDynInstPtr ii);
 
     /** Freeing VRF space */
     void freeRegisterFile();
@@ -40,6 +40,8 @@
 
 #include "mem/mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -49,6 +51,106 @@
 #include "mem/mem_interface.hh"
 #include "sim/system.hh"
 
+void
+MemPacketQueue::push_back(MemPacket *pkt)
+{
+    pkt->queueSeq = nextSeq++;
+    packets.push_back(pkt);
+    if (pkt->isDram())
+        addToBank(pkt);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator it)
+{
+    if ((*it)->isDram())
+        removeFromBank(*it);
+    return packets.erase(it);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::find(const MemPacket *pkt)
+{
+    // The packets are in the order of their position
+    auto it = std::lower_bound(packets.begin(), packets.end(), pkt,
+        [](const MemPacket *a, const MemPacket *b)
+        { return a->queueSeq < b->queueSeq; });
+    assert(it != packets.end() && *it == pkt);
+    return it;
+}
+
+unsigned
+MemPacketQueue::rowCount(uint16_t bank_id, uint32_t row) const
+{
+    if (bank_id >= banks.size())
+        return 0;
+    auto it = banks[bank_id].rows.find(row);
+    return it == banks[bank_id].rows.end() ? 0 : it->second.size();
+}
+
+MemPacket *
+MemPacketQueue::oldestInRow(uint16_t bank_id, uint32_t row) const
+{
+    if (bank_id >= banks.size())
+        return nullptr;
+    auto it = banks[bank_id].rows.find(row);
+    return it == banks[bank_id].rows.end() ? nullptr : it->second.front();
+}
+
+MemPacket *
+MemPacketQueue::oldestNotInRow(uint16_t bank_id, uint32_t row) const
+{
+    if (bank_id >= banks.size())
+        return nullptr;
+
+    // Only the oldest row can be the one to skip
+    const BankPackets &bank = banks[bank_id];
+    for (const auto &entry : bank.rowOrder) {
+        if (entry.second != row)
+            return bank.rows.at(entry.second).front();
+    }
+    return nullptr;
+}
+
+void
+MemPacketQueue::addToBank(MemPacket *pkt)
+{
+    if (pkt->bankId >= banks.size())
+        banks.resize(pkt->bankId + 1);
+
+    BankPackets &bank = banks[pkt->bankId];
+    std::deque<MemPacket*> &row = bank.rows[pkt->row];
+    if (row.empty())
+        bank.rowOrder.emplace(pkt->queueSeq, pkt->row);
+    row.push_back(pkt);
+    ++bank.count;
+}
+
+void
+MemPacketQueue::removeFromBank(MemPacket *pkt)
+{
+    BankPackets &bank = banks[pkt->bankId];
+    auto row_it = bank.rows.find(pkt->row);
+    assert(row_it != bank.rows.end());
+    std::deque<MemPacket*> &row = row_it->second;
+
+    if (row.front() == pkt) {
+        bank.rowOrder.erase(std::make_pair(pkt->queueSeq, pkt->row));
+        row.pop_front();
+        if (row.empty())
+            bank.rows.erase(row_it);
+        else
+            bank.rowOrder.emplace(row.front()->queueSeq, pkt->row);
+    } else {
+        auto it = std::lower_bound(row.begin(), row.end(), pkt,
+            [](const MemPacket *a, const MemPacket *b)
+            { return a->queueSeq < b->queueSeq; });
+        assert(it != row.end() && *it == pkt);
+        row.erase(it);
+    }
+    --bank.count;
+}
+
 MemCtrl::MemCtrl(const MemCtrlParams &p) :
     QoS::MemCtrl(p),
     port(name() + ".port", *this), isTimingMode(false),
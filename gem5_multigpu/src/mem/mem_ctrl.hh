@@ -47,7 +47,9 @@
 #define __MEM_CTRL_HH__
 
 #include <deque>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -141,6 +143,12 @@ class MemPacket
      */
     BurstHelper* burstHelper;
 
+    /**
+     * Position of the packet in the queue it is in, set when it is
+     * added to the queue
+     */
+    uint64_t queueSeq;
+
     /**
      * QoS value of the encapsulated packet read at queuing time
      */
@@ -200,14 +208,79 @@ class MemPacket
           _requestorId(pkt->requestorId()),
           read(is_read), dram(is_dram), rank(_rank), bank(_bank), row(_row),
           bankId(bank_id), addr(_addr), size(_size), burstHelper(NULL),
-          _qosValue(_pkt->qosValue())
+          queueSeq(0), _qosValue(_pkt->qosValue())
     { }
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * A queue of memory packets, in the order they were added, that also
+ * keeps its DRAM packets by bank and by row. This lets the FR-FCFS
+ * scheduler find the oldest row hit and the oldest row miss of each bank
+ * without going through the whole queue.
+ *
+ * The memory packets are stored in one such queue per QoS priority.
+ */
+class MemPacketQueue
+{
+  private:
+    typedef std::deque<MemPacket*> Packets;
+
+    /** The DRAM packets to a bank */
+    struct BankPackets
+    {
+        /** The packets to each row, oldest first */
+        std::unordered_map<uint32_t, std::deque<MemPacket*>> rows;
+
+        /** The rows, by the position of their oldest packet */
+        std::set<std::pair<uint64_t, uint32_t>> rowOrder;
+
+        unsigned count = 0;
+    };
+
+    Packets packets;
+    std::vector<BankPackets> banks;
+    uint64_t nextSeq;
+
+    void addToBank(MemPacket *pkt);
+    void removeFromBank(MemPacket *pkt);
+
+  public:
+    typedef Packets::iterator iterator;
+    typedef Packets::const_iterator const_iterator;
+
+    MemPacketQueue() : nextSeq(0) { }
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    size_t size() const { return packets.size(); }
+    bool empty() const { return packets.empty(); }
+
+    void push_back(MemPacket *pkt);
+    iterator erase(iterator it);
+
+    /** Get the position of a packet in the queue */
+    iterator find(const MemPacket *pkt);
+
+    /** Number of DRAM packets to a bank */
+    unsigned
+    bankCount(uint16_t bank_id) const
+    {
+        return bank_id < banks.size() ? banks[bank_id].count : 0;
+    }
+
+    /** Number of DRAM packets to a row of a bank */
+    unsigned rowCount(uint16_t bank_id, uint32_t row) const;
+
+    /** Get the oldest DRAM packet to a row of a bank, or nullptr */
+    MemPacket *oldestInRow(uint16_t bank_id, uint32_t row) const;
+
+    /** Get the oldest DRAM packet to a bank not to a row, or nullptr */
+    MemPacket *oldestNotInRow(uint16_t bank_id, uint32_t row) const;
+};
 
 
 /**
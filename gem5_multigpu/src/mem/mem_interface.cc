@@ -168,116 +168,97 @@ MemInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
-
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
+    // The queue keeps the packets of every bank by row, so rather than
+    // going through the queue this looks at the oldest row hit and the
+    // oldest row miss of every bank, and picks the packet a scan of the
+    // queue in order would:
+    // 1) the oldest row hit that can issue seamlessly
+    // 2) else the oldest packet to one of the first available banks, if
+    //    that bank can be prepared 'behind the scenes'
+    // 3) else the oldest prepped row hit, not seamless, but ready
+    // 4) else the oldest packet to one of the first available banks
+    // Going for closed rows first enables more open row possibilities in
+    // future selections
+    MemPacket *seamless_pkt = nullptr;
+    MemPacket *prepped_pkt = nullptr;
+
+    // the oldest row miss of each bank that is available
+    std::vector<MemPacket*> miss_pkts;
+
+    for (uint16_t bank_id = 0; bank_id < ranksPerChannel * banksPerRank;
+         ++bank_id) {
+        if (!queue.bankCount(bank_id))
+            continue;
+
+        const Rank &rank = *ranks[bank_id / banksPerRank];
+        const Bank &bank = rank.banks[bank_id % banksPerRank];
+
+        // check if rank is not doing a refresh and thus is available,
+        // if not, jump to the next bank
+        if (!rank.inRefIdleState()) {
+            DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
+                    bank_id % banksPerRank, bank_id / banksPerRank);
+            continue;
+        }
 
-        // select optimal DRAM packet in Q
-        if (pkt->isDram()) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
+        MemPacket *hit = bank.openRow == Bank::NO_ROW ? nullptr :
+                         queue.oldestInRow(bank_id, bank.openRow);
+        if (hit) {
+            const Tick col_allowed_at = hit->isRead() ? bank.rdAllowedAt :
                                                         bank.wrAllowedAt;
+            // no additional rank-to-rank or same bank-group delays, or
+            // we switched read/write and might as well go for the row
+            // hit
+            MemPacket *&found = col_allowed_at <= min_col_at ?
+                                seamless_pkt : prepped_pkt;
+            if (!found || hit->queueSeq < found->queueSeq)
+                found = hit;
+        }
 
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+        MemPacket *miss = queue.oldestNotInRow(bank_id, bank.openRow);
+        if (miss)
+            miss_pkts.push_back(miss);
+    }
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
-                }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
+    MemPacket *selected_pkt = seamless_pkt;
+    if (selected_pkt) {
+        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
+    } else {
+        // determine the earliest packet to the earliest banks
+        MemPacket *earliest_pkt = nullptr;
+        bool hidden_bank_prep = false;
+        if (!miss_pkts.empty()) {
+            std::vector<uint32_t> earliest_banks;
+            std::tie(earliest_banks, hidden_bank_prep) =
+                minBankPrep(queue, min_col_at);
+
+            for (MemPacket *pkt : miss_pkts) {
+                if (bits(earliest_banks[pkt->rank], pkt->bank, pkt->bank) &&
+                    (!earliest_pkt || pkt->queueSeq < earliest_pkt->queueSeq))
+                    earliest_pkt = pkt;
             }
         }
+
+        // give priority to packets that can issue bank commands 'behind
+        // the scenes', any additional delay if any will be due to
+        // col-to-col command requirements
+        if (earliest_pkt && (hidden_bank_prep || !prepped_pkt)) {
+            selected_pkt = earliest_pkt;
+        } else if (prepped_pkt) {
+            DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
+            selected_pkt = prepped_pkt;
+        }
     }
 
-    if (selected_pkt_it == queue.end()) {
+    if (!selected_pkt) {
         DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        return std::make_pair(queue.end(), MaxTick);
     }
 
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    const Bank &bank = ranks[selected_pkt->rank]->banks[selected_pkt->bank];
+    return std::make_pair(queue.find(selected_pkt),
+                          selected_pkt->isRead() ? bank.rdAllowedAt :
+                                                   bank.wrAllowedAt);
 }
 
 void
@@ -608,34 +589,22 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         // page, but closes it only if there are no row hits in the queue.
         // In this case, only force an auto precharge when there
         // are no same page hits in the queue
-        bool got_more_hits = false;
-        bool got_bank_conflict = false;
-
+        // 1) if a hit is found, then both open and close adaptive
+        //    policies keep the page open
+        // 2) if no hit is found, got_bank_conflict is set to true if a
+        //    bank conflict request is waiting in the queue
+        // 3) make sure we are not considering the packet that we are
+        //    currently dealing with, it is still in its queue
+        unsigned row_pkts = 0;
+        unsigned bank_pkts = 0;
         for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
-            // keep on looking until we find a hit or reach the end of the
-            // queue
-            // 1) if a hit is found, then both open and close adaptive
-            //    policies keep the page open
-            // 2) if no hit is found, got_bank_conflict is set to true if a
-            //    bank conflict request is waiting in the queue
-            // 3) make sure we are not considering the packet that we are
-            //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
-
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
-                }
-                ++p;
-            }
-
-            if (got_more_hits)
-                break;
+            row_pkts += queue[i].rowCount(mem_pkt->bankId, mem_pkt->row);
+            bank_pkts += queue[i].bankCount(mem_pkt->bankId);
         }
+        assert(row_pkts > 0);
+
+        bool got_more_hits = row_pkts > 1;
+        bool got_bank_conflict = bank_pkts > row_pkts;
 
         // auto pre-charge when either
         // 1) open_adaptive policy, we have not got any more hits, and
@@ -1054,9 +1023,10 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
+    for (uint16_t bank_id = 0; bank_id < got_waiting.size(); ++bank_id) {
+        if (queue.bankCount(bank_id) &&
+            ranks[bank_id / banksPerRank]->inRefIdleState())
+            got_waiting[bank_id] = true;
     }
 
     // Find command with optimal bank timing
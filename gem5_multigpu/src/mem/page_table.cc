@@ -50,6 +50,10 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
+    if (clobber)
+        dropLargePages(vaddr, size);
+    recordLargePages(vaddr, paddr, size);
+
     while (size > 0) {
         auto it = pTable.find(vaddr);
         if (it != pTable.end()) {
@@ -77,6 +81,8 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
+    dropLargePages(vaddr, size);
+
     while (size > 0) {
         M5_VAR_USED auto new_it = pTable.find(new_vaddr);
         auto old_it = pTable.find(vaddr);
@@ -104,6 +110,8 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
+    dropLargePages(vaddr, size);
+
     while (size > 0) {
         auto it = pTable.find(vaddr);
         assert(it != pTable.end());
@@ -113,6 +121,51 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
     }
 }
 
+void
+EmulationPageTable::recordLargePages(Addr vaddr, Addr paddr, int64_t size)
+{
+    for (unsigned shift : {LargePageShift, HugePageShift}) {
+        const Addr page_size = Addr(1) << shift;
+        // The physical region must be aligned like the virtual one
+        if ((vaddr ^ paddr) & (page_size - 1))
+            continue;
+
+        auto &pages = shift == HugePageShift ? hugePages : largePages;
+        for (Addr page = roundUp(vaddr, page_size);
+             page + page_size <= vaddr + size; page += page_size) {
+            DPRINTF(MMU, "Mapped %#x-%#x as a large page\n", page,
+                    page + page_size);
+            pages.insert(page);
+        }
+    }
+}
+
+void
+EmulationPageTable::dropLargePages(Addr vaddr, int64_t size)
+{
+    for (unsigned shift : {LargePageShift, HugePageShift}) {
+        auto &pages = shift == HugePageShift ? hugePages : largePages;
+        if (pages.empty())
+            continue;
+
+        const Addr page_size = Addr(1) << shift;
+        for (Addr page = roundDown(vaddr, page_size); page < vaddr + size;
+             page += page_size) {
+            pages.erase(page);
+        }
+    }
+}
+
+unsigned
+EmulationPageTable::pageShiftAt(Addr vaddr) const
+{
+    if (hugePages.count(roundDown(vaddr, Addr(1) << HugePageShift)))
+        return HugePageShift;
+    if (largePages.count(roundDown(vaddr, Addr(1) << LargePageShift)))
+        return LargePageShift;
+    return floorLog2(_pageSize);
+}
+
 bool
 EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
 {
@@ -37,6 +37,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
@@ -63,6 +64,18 @@ class EmulationPageTable : public Serializable
     typedef PTable::iterator PTableItr;
     PTable pTable;
 
+    /**
+     * The naturally aligned 2MB and 1GB regions that one map() call
+     * mapped to a physically contiguous and equally aligned region with
+     * the same flags, so they can be translated as one large page. A
+     * region is dropped when any page of it is mapped again or unmapped.
+     */
+    std::unordered_set<Addr> largePages;
+    std::unordered_set<Addr> hugePages;
+
+    void recordLargePages(Addr vaddr, Addr paddr, int64_t size);
+    void dropLargePages(Addr vaddr, int64_t size);
+
     const Addr _pageSize;
     const Addr offsetMask;
 
@@ -109,6 +122,15 @@ class EmulationPageTable : public Serializable
     // ignore that for now.
     Addr pageSize()   { return _pageSize; }
 
+    static const unsigned LargePageShift = 21;
+    static const unsigned HugePageShift = 30;
+
+    /**
+     * Get the log2 of the size of the largest page a mapped address can
+     * be translated with, which is at least the base page size.
+     */
+    unsigned pageShiftAt(Addr vaddr) const;
+
     /**
      * Maps a virtual memory region to a physical memory region.
      * @param vaddr The starting virtual address of the region.
@@ -173,6 +173,13 @@ class Request
           */
         KERNEL                      = 0x00001000,
 
+        /**
+         * The instruction fetch starts a new fetch stream of a
+         * wavefront, and the instruction cache may prefetch the lines
+         * that follow it.
+         */
+        FETCH_STREAM_START          = 0x00002000,
+
         /** The request targets the secure memory space. */
         SECURE                      = 0x10000000,
         /** The request is a page table walk */
@@ -269,12 +276,14 @@ class Request
      * See the AMD GCN3 ISA Architecture Manual for more details.
      *
      * INV_L1: L1 cache invalidation
+     * WB_L1: L1 cache write-back of the dirty lines
      * FLUSH_L2: L2 cache flush
      * INV_L2: L2 cache invalidation
      *
      * Invalidation means to simply discard all cache contents. This can be
      * done in the L1 since it is implemented as a write-through cache and
-     * there are other copies elsewhere in the hierarchy.
+     * there are other copies elsewhere in the hierarchy. A write-back L1
+     * writes its dirty bytes back before it invalidates them.
      *
      * For flush the contents of the cache need to be written back to memory
      * when dirty and can be discarded otherwise. This operation is more
@@ -294,6 +303,7 @@ class Request
     enum : CacheCoherenceFlagsType {
         /** mem_sync_op flags */
         INV_L1                  = 0x00000001,
+        WB_L1                   = 0x00000002,
         FLUSH_L2                = 0x00000020,
         INV_L2                  = 0x00000040,
         /** user-policy flags */
@@ -966,6 +976,11 @@ class Request
     bool isPTWalk() const { return _flags.isSet(PT_WALK); }
     bool isRelease() const { return _flags.isSet(RELEASE); }
     bool isKernel() const { return _flags.isSet(KERNEL); }
+    bool
+    isFetchStreamStart() const
+    {
+        return _flags.isSet(FETCH_STREAM_START);
+    }
     bool isAtomicReturn() const { return _flags.isSet(ATOMIC_RETURN_OP); }
     bool isAtomicNoReturn() const { return _flags.isSet(ATOMIC_NO_RETURN_OP); }
     // hardware transactional memory
@@ -1007,6 +1022,8 @@ class Request
      */
     bool isInvL1() const { return _cacheCoherenceFlags.isSet(INV_L1); }
 
+    bool isWbL1() const { return _cacheCoherenceFlags.isSet(WB_L1); }
+
     bool
     isGL2CacheFlush() const
     {
@@ -1019,6 +1036,9 @@ class Request
         return _cacheCoherenceFlags.isSet(INV_L2);
     }
 
+    /** Whether the access is system-scope (system level coherent). */
+    bool isSLC() const { return _cacheCoherenceFlags.isSet(SLC_BIT); }
+
     /**
      * Accessor functions to determine whether this request is part of
      * a cache maintenance operation. At the moment three operations
@@ -52,7 +52,9 @@
 using m5::stl_helpers::operator<<;
 
 MessageBuffer::MessageBuffer(const Params &p)
-    : SimObject(p), m_stall_map_size(0), m_max_size(p.buffer_size),
+    : SimObject(p), m_sorted_fifo(p.sorted_fifo),
+    m_hashed_stall_map(p.hashed_stall_map),
+    m_stall_map_size(0), m_max_size(p.buffer_size),
     m_max_dequeue_rate(p.max_dequeue_rate), m_dequeues_this_cy(0),
     m_time_last_time_size_checked(0),
     m_time_last_time_enqueue(0), m_time_last_time_pop(0),
@@ -76,6 +78,7 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_priority_rank = 0;
 
     m_stall_msg_map.clear();
+    m_stall_msg_hash.clear();
     m_input_link_id = 0;
     m_vnet_id = 0;
 
@@ -112,7 +115,7 @@ MessageBuffer::getSize(Tick curTime)
 {
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = numMsgs();
     }
 
     return m_size_last_time_size_checked;
@@ -136,7 +139,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 
     if (m_time_last_time_pop < current_time) {
         // no pops this cycle - heap and stall queue size is correct
-        current_size = m_prio_heap.size();
+        current_size = numMsgs();
         current_stall_size = m_stall_map_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
@@ -159,7 +162,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
         DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
                 "m_max_size: %d\n",
                 n, current_size + current_stall_size,
-                m_prio_heap.size(), m_max_size);
+                numMsgs(), m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -169,7 +172,7 @@ const Message*
 MessageBuffer::peek() const
 {
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = peekMsgPtr().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -253,13 +256,12 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     msg_ptr->setMsgCounter(m_msg_counter);
 
     // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    pushMsg(message);
     // Increment the number of messages statistic
     m_buf_msgs++;
 
     assert((m_max_size == 0) ||
-           ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
+           ((numMsgs() + m_stall_map_size) <= m_max_size));
 
     DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
             arrival_time, *(message.get()));
@@ -277,7 +279,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     assert(isReady(current_time));
 
     // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = peekMsgPtr();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -288,15 +290,14 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = numMsgs();
         m_stalled_at_cycle_start = m_stall_map_size;
         m_time_last_time_pop = current_time;
         m_dequeues_this_cy = 0;
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
+    popMsg();
     if (decrement_messages) {
         // If the message will be removed from the queue, decrement the
         // number of message in the queue.
@@ -308,6 +309,14 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
         m_dequeue_callback();
     }
 
+    // Stalled messages still take up their slot, so only a message that
+    // leaves the buffer frees one for the waiting consumers
+    if (decrement_messages && !m_dequeue_waiters.empty()) {
+        for (Consumer *consumer : m_dequeue_waiters)
+            consumer->scheduleEvent(Cycles(1));
+        m_dequeue_waiters.clear();
+    }
+
     return delay;
 }
 
@@ -323,10 +332,59 @@ MessageBuffer::unregisterDequeueCallback()
     m_dequeue_callback = nullptr;
 }
 
+void
+MessageBuffer::wakeOnDequeue(Consumer *consumer, Tick current_time)
+{
+    // A dequeue earlier in this cycle already freed a slot that the
+    // consumer cannot see yet
+    if (m_time_last_time_pop >= current_time) {
+        consumer->scheduleEvent(Cycles(1));
+        return;
+    }
+
+    if (std::find(m_dequeue_waiters.begin(), m_dequeue_waiters.end(),
+                  consumer) == m_dequeue_waiters.end()) {
+        m_dequeue_waiters.push_back(consumer);
+    }
+}
+
+void
+MessageBuffer::pushMsg(const MsgPtr &message)
+{
+    if (!m_sorted_fifo) {
+        m_prio_heap.push_back(message);
+        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
+                  std::greater<MsgPtr>());
+    } else if (m_fifo.empty() || message > m_fifo.back()) {
+        m_fifo.push_back(message);
+    } else if (m_fifo.front() > message) {
+        m_fifo.push_front(message);
+    } else {
+        // Keep the FIFO sorted, the same way the heap orders messages
+        auto it = std::upper_bound(m_fifo.begin(), m_fifo.end(), message,
+            [](const MsgPtr &lhs, const MsgPtr &rhs) { return rhs > lhs; });
+        m_fifo.insert(it, message);
+    }
+}
+
+void
+MessageBuffer::popMsg()
+{
+    if (m_sorted_fifo) {
+        m_fifo.pop_front();
+    } else {
+        pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
+                 std::greater<MsgPtr>());
+        m_prio_heap.pop_back();
+    }
+}
+
 void
 MessageBuffer::clear()
 {
     m_prio_heap.clear();
+    m_fifo.clear();
+    m_dequeue_waiters.clear();
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -341,41 +399,59 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    MsgPtr node = peekMsgPtr();
+    popMsg();
 
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    pushMsg(node);
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
+template <typename MsgList>
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::reanalyzeList(MsgList &lt, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
+    for (const MsgPtr &m : lt) {
         assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
+        pushMsg(m);
 
         m_consumer->scheduleEventAbsolute(schdTick);
 
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
-
-        lt.pop_front();
     }
+    lt.clear();
+}
+
+std::vector<Addr>
+MessageBuffer::sortedStallAddrs() const
+{
+    std::vector<Addr> addrs;
+    addrs.reserve(m_stall_msg_hash.size());
+    for (const auto &stalled : m_stall_msg_hash)
+        addrs.push_back(stalled.first);
+    std::sort(addrs.begin(), addrs.end());
+    return addrs;
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
+
+    if (m_hashed_stall_map) {
+        auto it = m_stall_msg_hash.find(addr);
+        assert(it != m_stall_msg_hash.end());
+        m_stall_map_size -= it->second.size();
+        assert(m_stall_map_size >= 0);
+        reanalyzeList(it->second, current_time);
+        m_stall_msg_hash.erase(it);
+        return;
+    }
+
     assert(m_stall_msg_map.count(addr) > 0);
 
     //
@@ -401,6 +477,17 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
+    if (m_hashed_stall_map) {
+        for (Addr addr : sortedStallAddrs()) {
+            std::vector<MsgPtr> &stalled = m_stall_msg_hash[addr];
+            m_stall_map_size -= stalled.size();
+            assert(m_stall_map_size >= 0);
+            reanalyzeList(stalled, current_time);
+        }
+        m_stall_msg_hash.clear();
+        return;
+    }
+
     for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
          map_iter != m_stall_msg_map.end(); ++map_iter) {
         m_stall_map_size -= map_iter->second.size();
@@ -416,7 +503,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
     assert(getOffset(addr) == 0);
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = peekMsgPtr();
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
@@ -427,7 +514,10 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    if (m_hashed_stall_map)
+        m_stall_msg_hash[addr].push_back(message);
+    else
+        (m_stall_msg_map[addr]).push_back(message);
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -435,6 +525,8 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 bool
 MessageBuffer::hasStalledMsg(Addr addr) const
 {
+    if (m_hashed_stall_map)
+        return m_stall_msg_hash.count(addr) != 0;
     return (m_stall_msg_map.count(addr) != 0);
 }
 
@@ -476,8 +568,13 @@ MessageBuffer::print(std::ostream& out) const
         ccprintf(out, " consumer-yes ");
     }
 
-    std::vector<MsgPtr> copy(m_prio_heap);
-    std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
+    std::vector<MsgPtr> copy;
+    if (m_sorted_fifo) {
+        copy.assign(m_fifo.begin(), m_fifo.end());
+    } else {
+        copy = m_prio_heap;
+        std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
+    }
     ccprintf(out, "%s] %s", copy, name());
 }
 
@@ -488,8 +585,8 @@ MessageBuffer::isReady(Tick current_time) const
     bool can_dequeue = (m_max_dequeue_rate == 0) ||
                        (m_time_last_time_pop < current_time) ||
                        (m_dequeues_this_cy < m_max_dequeue_rate);
-    bool is_ready = (m_prio_heap.size() > 0) &&
-                   (m_prio_heap.front()->getLastEnqueueTime() <= current_time);
+    bool is_ready = (numMsgs() > 0) &&
+                   (peekMsgPtr()->getLastEnqueueTime() <= current_time);
     if (!can_dequeue && is_ready) {
         // Make sure the Consumer executes next cycle to dequeue the ready msg
         m_consumer->scheduleEvent(Cycles(1));
@@ -507,14 +604,26 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read)
 
     // Check the priority heap and write any messages that may
     // correspond to the address in the packet.
-    for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
+    for (unsigned int i = 0; i < numMsgs(); ++i) {
+        Message *msg = m_sorted_fifo ? m_fifo[i].get() : m_prio_heap[i].get();
         if (is_read && msg->functionalRead(pkt))
             return 1;
         else if (!is_read && msg->functionalWrite(pkt))
             num_functional_accesses++;
     }
 
+    if (m_hashed_stall_map) {
+        for (Addr addr : sortedStallAddrs()) {
+            for (const MsgPtr &stalled : m_stall_msg_hash[addr]) {
+                Message *msg = stalled.get();
+                if (is_read && msg->functionalRead(pkt))
+                    return 1;
+                else if (!is_read && msg->functionalWrite(pkt))
+                    num_functional_accesses++;
+            }
+        }
+    }
+
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
     for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
@@ -48,8 +48,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <functional>
 #include <iostream>
+#include <list>
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -83,10 +86,8 @@ class MessageBuffer : public SimObject
     void
     delayHead(Tick current_time, Tick delta)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
+        MsgPtr m = peekMsgPtr();
+        popMsg();
         enqueue(m, current_time, delta);
     }
 
@@ -112,7 +113,11 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &
+    peekMsgPtr() const
+    {
+        return m_sorted_fifo ? m_fifo.front() : m_prio_heap.front();
+    }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta);
 
@@ -135,10 +140,24 @@ class MessageBuffer : public SimObject
     void registerDequeueCallback(std::function<void()> callback);
     void unregisterDequeueCallback();
 
+    //! Wake a consumer that is waiting for slots in this buffer up in the
+    //! cycle after the next dequeue, when the freed slot becomes visible
+    void wakeOnDequeue(Consumer *consumer, Tick current_time);
+
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
-    bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
-    unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
+    bool isEmpty() const { return numMsgs() == 0; }
+    bool
+    isStallMapEmpty()
+    {
+        return m_hashed_stall_map ? m_stall_msg_hash.empty() :
+            m_stall_msg_map.empty();
+    }
+    unsigned int
+    getStallMapSize()
+    {
+        return m_hashed_stall_map ? m_stall_msg_hash.size() :
+            m_stall_msg_map.size();
+    }
 
     unsigned int getSize(Tick curTime);
 
@@ -173,7 +192,20 @@ class MessageBuffer : public SimObject
     }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    template <typename MsgList>
+    void reanalyzeList(MsgList &, Tick);
+
+    // Number of messages waiting in the buffer, not counting stalled ones
+    unsigned int
+    numMsgs() const
+    {
+        return m_sorted_fifo ? m_fifo.size() : m_prio_heap.size();
+    }
+    void pushMsg(const MsgPtr &message);
+    void popMsg();
+
+    // Addresses in the hashed stall map, in ascending order
+    std::vector<Addr> sortedStallAddrs() const;
 
     uint32_t functionalAccess(Packet *pkt, bool is_read);
 
@@ -183,7 +215,20 @@ class MessageBuffer : public SimObject
     Consumer* m_consumer;
     std::vector<MsgPtr> m_prio_heap;
 
+    /**
+     * With m_sorted_fifo, messages are kept in m_fifo, sorted by arrival
+     * time and enqueue order, instead of in m_prio_heap. Messages on
+     * fixed-latency links arrive in the order they are enqueued, so they
+     * are appended at the back and dequeued from the front in constant
+     * time. Messages that arrive out of order are inserted with a binary
+     * search. Both containers dequeue messages in the same order.
+     */
+    const bool m_sorted_fifo;
+    std::deque<MsgPtr> m_fifo;
+
     std::function<void()> m_dequeue_callback;
+    //! Consumers waiting for slots, see wakeOnDequeue()
+    std::vector<Consumer*> m_dequeue_waiters;
 
     // use a std::map for the stalled messages as this container is
     // sorted and ensures a well-defined iteration order
@@ -204,6 +249,17 @@ class MessageBuffer : public SimObject
      */
     StallMsgMapType m_stall_msg_map;
 
+    /**
+     * With m_hashed_stall_map, stalled messages are kept in this hash map
+     * instead of m_stall_msg_map, so that stalling a message and checking
+     * for stalled messages do not walk a tree. Operations over all the
+     * stalled messages visit the addresses in sorted order, the same way
+     * as with m_stall_msg_map.
+     */
+    const bool m_hashed_stall_map;
+    typedef std::unordered_map<Addr, std::vector<MsgPtr>> StallMsgHashType;
+    StallMsgHashType m_stall_msg_hash;
+
     /**
      * A map from line addresses to corresponding vectors of messages that
      * are deferred for enqueueing. Messages in this map are waiting to be
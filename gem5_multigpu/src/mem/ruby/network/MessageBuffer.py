@@ -69,3 +69,8 @@ class MessageBuffer(SimObject):
     max_dequeue_rate = Param.Unsigned(0, "Maximum number of messages that can \
                                           be dequeued per cycle \
                                     (0 allows dequeueing all ready messages)")
+    sorted_fifo = Param.Bool(False, "Keep messages in a sorted FIFO instead \
+                                     of a heap. Faster when messages mostly \
+                                     arrive in the order they are enqueued")
+    hashed_stall_map = Param.Bool(False, "Keep stalled messages in a hash \
+                                          map instead of a tree")
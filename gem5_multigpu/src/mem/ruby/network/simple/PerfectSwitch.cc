@@ -141,9 +141,10 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
     MsgPtr msg_ptr;
     Message *net_msg_ptr = NULL;
 
-    // temporary vectors to store the routing results
-    std::vector<LinkID> output_links;
-    std::vector<NetDest> output_link_destinations;
+    // vectors to store the routing results
+    std::vector<LinkID> &output_links = m_output_links;
+    std::vector<NetDest> &output_link_destinations =
+        m_output_link_destinations;
     Tick current_time = m_switch->clockEdge();
 
     while (buffer->isReady(current_time)) {
@@ -165,6 +166,9 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
         assert(m_link_order.size() == m_routing_table.size());
         assert(m_link_order.size() == m_out.size());
 
+        // Whether the links are looked at in their default order
+        bool default_order = true;
+
         if (m_network_ptr->getAdaptiveRouting()) {
             if (m_network_ptr->isVNetOrdered(vnet)) {
                 // Don't adaptively route
@@ -188,13 +192,24 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
 
                 // Look at the most empty link first
                 sort(m_link_order.begin(), m_link_order.end());
+                default_order = false;
             }
         }
 
-        for (int i = 0; i < m_routing_table.size(); i++) {
+        if (default_order && msg_dsts.count() == 1) {
+            // A message with a single destination takes the link
+            // precomputed for it
+            output_links.push_back(
+                destinationLink(msg_dsts.smallestElement()));
+            output_link_destinations.push_back(msg_dsts);
+            msg_dsts.clear();
+        }
+
+        for (int i = 0; i < m_routing_table.size() && !msg_dsts.isEmpty();
+             i++) {
             // pick the next link to look at
             int link = m_link_order[i].m_link;
-            NetDest dst = m_routing_table[link];
+            const NetDest &dst = m_routing_table[link];
             DPRINTF(RubyNetwork, "dst: %s\n", dst);
 
             if (!msg_dsts.intersectionIsNotEmpty(dst))
@@ -280,6 +295,33 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int incoming,
     }
 }
 
+int
+PerfectSwitch::destinationLink(MachineID dest)
+{
+    if (m_destination_links.empty()) {
+        m_destination_links.resize(MachineType_base_number(MachineType_NUM),
+                                   -1);
+        for (MachineType type = MachineType_FIRST; type < MachineType_NUM;
+             ++type) {
+            for (NodeID num = 0; num < MachineType_base_count(type); num++) {
+                MachineID mach = {type, num};
+                for (int link = 0; link < m_routing_table.size(); link++) {
+                    if (m_routing_table[link].isElement(mach)) {
+                        m_destination_links[
+                            MachineType_base_number(type) + num] = link;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    int link =
+        m_destination_links[MachineType_base_number(dest.type) + dest.num];
+    assert(link >= 0);
+    return link;
+}
+
 void
 PerfectSwitch::wakeup()
 {
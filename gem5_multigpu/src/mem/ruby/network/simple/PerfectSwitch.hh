@@ -87,6 +87,8 @@ class PerfectSwitch : public Consumer
 
     void operateVnet(int vnet);
     void operateMessageBuffer(MessageBuffer *b, int incoming, int vnet);
+    // The first link whose routing table entry holds the destination
+    int destinationLink(MachineID dest);
 
     const SwitchID m_switch_id;
     Switch * const m_switch;
@@ -98,6 +100,16 @@ class PerfectSwitch : public Consumer
     std::vector<NetDest> m_routing_table;
     std::vector<LinkOrder> m_link_order;
 
+    // Output link of every destination machine when the links are looked
+    // at in their default order, indexed by MachineType_base_number.
+    // Built on first use, once the routing tables are complete.
+    std::vector<int> m_destination_links;
+
+    // Routing results of the message being routed, kept across messages
+    // so that routing does not allocate
+    std::vector<LinkID> m_output_links;
+    std::vector<NetDest> m_output_link_destinations;
+
     uint32_t m_virtual_networks;
     int m_round_robin_start;
     int m_wakeups_wo_switch;
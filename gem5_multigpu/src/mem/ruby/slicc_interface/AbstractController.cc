@@ -49,12 +49,13 @@
 
 AbstractController::AbstractController(const Params &p)
     : ClockedObject(p), Consumer(this), m_version(p.version),
-      m_clusterID(p.cluster_id),
+      m_clusterID(p.cluster_id), m_warmup_sequencer(p.warmup_sequencer),
       m_id(p.system->getRequestorId(this)), m_is_blocking(false),
       m_number_of_TBEs(p.number_of_TBEs),
       m_transitions_per_cycle(p.transitions_per_cycle),
       m_buffer_size(p.buffer_size), m_recycle_latency(p.recycle_latency),
       m_mandatory_queue_latency(p.mandatory_queue_latency),
+      m_wakeup_coalescing(p.wakeup_coalescing), m_poll_stall(false),
       memoryPort(csprintf("%s.memory", name()), this),
       addrRanges(p.addr_ranges.begin(), p.addr_ranges.end()),
       stats(this)
@@ -444,10 +445,17 @@ ControllerStats::ControllerStats(Stats::Group *parent)
     : Stats::Group(parent),
       ADD_STAT(fullyBusyCycles,
                "cycles for which number of transistions == max transitions"),
+      ADD_STAT(wakeups, "Number of times the controller woke up"),
+      ADD_STAT(uselessWakeups, "Number of wakeups in which the controller "
+               "did not take any transition"),
       ADD_STAT(delayHistogram, "delay_histogram")
 {
     fullyBusyCycles
         .flags(Stats::nozero);
+    wakeups
+        .flags(Stats::nozero);
+    uselessWakeups
+        .flags(Stats::nozero);
     delayHistogram
         .flags(Stats::nozero);
 }
@@ -110,6 +110,7 @@ class AbstractController : public ClockedObject, public Consumer
     virtual Sequencer* getCPUSequencer() const = 0;
     virtual DMASequencer* getDMASequencer() const = 0;
     virtual GPUCoalescer* getGPUCoalescer() const = 0;
+    Sequencer* getWarmupSequencer() const { return m_warmup_sequencer; }
 
     // This latency is used by the sequencer when enqueueing requests.
     // Different latencies may be used depending on the request type.
@@ -280,10 +281,40 @@ class AbstractController : public ClockedObject, public Consumer
     void wakeUpAllBuffers();
     bool serviceMemoryQueue();
 
+    /**
+     * Called by the generated code when a transition stalls, to retry it
+     * in the next cycle. With wakeup coalescing, the retry is only
+     * scheduled for stalls on resources that free up on their own. Any
+     * other stall can only clear when the controller takes a transition,
+     * which it retries all its ports after, or when a message enters or
+     * leaves one of its buffers, which wakes it up.
+     */
+    void
+    scheduleStallRetry()
+    {
+        if (!m_wakeup_coalescing || m_poll_stall)
+            scheduleEvent(Cycles(1));
+        m_poll_stall = false;
+    }
+
+    //! The stalled transition needs a full output buffer
+    void
+    stallOnBuffer(MessageBuffer *buf)
+    {
+        if (m_wakeup_coalescing)
+            buf->wakeOnDequeue(this, clockEdge());
+    }
+
+    //! The stalled transition waits for something that frees up on its own
+    void pollStall() { m_poll_stall = true; }
+
   protected:
     const NodeID m_version;
     MachineID m_machineID;
     const NodeID m_clusterID;
+    // Sequencer that replays this controller's cache trace, if the
+    // controller has no CPU sequencer of its own
+    Sequencer *m_warmup_sequencer;
 
     // RequestorID used by some components of gem5.
     const RequestorID m_id;
@@ -304,6 +335,8 @@ class AbstractController : public ClockedObject, public Consumer
     const unsigned int m_buffer_size;
     Cycles m_recycle_latency;
     const Cycles m_mandatory_queue_latency;
+    const bool m_wakeup_coalescing;
+    bool m_poll_stall;
 
     /**
      * Port that forwards requests and receives responses from the
@@ -369,6 +402,11 @@ class AbstractController : public ClockedObject, public Consumer
         //! were equal to the maximum allowed
         Stats::Scalar fullyBusyCycles;
 
+        //! Number of wakeups, and of the wakeups in which the controller
+        //! did not take any transition or service its memory queue
+        Stats::Scalar wakeups;
+        Stats::Scalar uselessWakeups;
+
         //! Histogram for profiling delay for the messages this controller
         //! cares for
         Stats::Histogram delayHistogram;
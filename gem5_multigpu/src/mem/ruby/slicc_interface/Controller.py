@@ -49,12 +49,17 @@ class RubyController(ClockedObject):
     addr_ranges = VectorParam.AddrRange([AllMemory], "Address range this "
                                         "controller responds to")
     cluster_id = Param.UInt32(0, "Id of this controller's cluster")
+    warmup_sequencer = Param.RubySequencer(NULL, "Sequencer used to replay "
+        "this controller's cache trace when it has no CPU sequencer")
 
     transitions_per_cycle = \
         Param.Int(32, "no. of  SLICC state machine transitions per cycle")
     buffer_size = Param.UInt32(0, "max buffer size 0 means infinite")
 
     recycle_latency = Param.Cycles(10, "")
+    wakeup_coalescing = Param.Bool(False, "Only retry stalled transitions "
+        "in the next cycle if they stalled on a resource that frees up on "
+        "its own, instead of after every stall")
     number_of_TBEs = Param.Int(256, "")
     ruby_system = Param.RubySystem("")
 
@@ -72,6 +72,7 @@ class RubyRequest : public Message
     bool m_htmFromTransaction;
     uint64_t m_htmTransactionUid;
     int m_homeNode;
+    bool m_isSLC;
 
     RubyRequest(Tick curTime, uint64_t _paddr, uint8_t* _data, int _len,
         uint64_t _pc, RubyRequestType _type, RubyAccessMode _access_mode,
@@ -88,7 +89,8 @@ class RubyRequest : public Message
           m_pkt(_pkt),
           m_contextId(_core_id),
           m_htmFromTransaction(false),
-          m_htmTransactionUid(0)
+          m_htmTransactionUid(0),
+          m_isSLC(false)
     {
         m_LineAddress = makeLineAddress(m_PhysicalAddress);
     }
@@ -116,7 +118,8 @@ class RubyRequest : public Message
           m_instSeqNum(_instSeqNum),
           m_htmFromTransaction(false),
           m_htmTransactionUid(0),
-          m_homeNode(homeNode)
+          m_homeNode(homeNode),
+          m_isSLC(false)
     {
         m_LineAddress = makeLineAddress(m_PhysicalAddress);
     }
@@ -145,7 +148,8 @@ class RubyRequest : public Message
           m_instSeqNum(_instSeqNum),
           m_htmFromTransaction(false),
           m_htmTransactionUid(0),
-          m_homeNode(homeNode)
+          m_homeNode(homeNode),
+          m_isSLC(false)
     {
         m_LineAddress = makeLineAddress(m_PhysicalAddress);
     }
@@ -59,6 +59,51 @@ mapAddressToRange(Addr addr, MachineType type, int low_bit,
     return mach;
 }
 
+/**
+ * Map an address to a TCC slice of a chiplet. The TCCs are numbered
+ * chiplet by chiplet, 2^num_bits of them per chiplet. The slice is picked
+ * by the num_bits address bits from low_bit up or, if hashed is set, by
+ * those bits XORed with every higher group of num_bits address bits, so
+ * that accesses with a power-of-two stride spread over all the slices.
+ */
+inline NodeID
+mapAddressToTCCSlice(Addr addr, int low_bit, int num_bits, bool hashed)
+{
+    if (num_bits == 0)
+        return 0;
+
+    NodeID slice = 0;
+    if (hashed) {
+        for (Addr bits = addr >> low_bit; bits; bits >>= num_bits)
+            slice ^= bits & ((1 << num_bits) - 1);
+    } else {
+        slice = bitSelect(addr, low_bit, low_bit + num_bits - 1);
+    }
+    return slice;
+}
+
+/** The TCC slice an address maps to on a chiplet */
+inline MachineID
+mapAddressToTCC(Addr addr, int low_bit, int num_bits, int chiplet,
+                bool hashed)
+{
+    MachineID mach = {MachineType_TCC, 0};
+    mach.num = mapAddressToTCCSlice(addr, low_bit, num_bits, hashed) +
+               (1 << num_bits) * chiplet;
+    return mach;
+}
+
+/** The TCC slices an address maps to on every chiplet */
+inline NetDest
+mapAddressToTCCs(Addr addr, int low_bit, int num_bits, int num_chiplets,
+                 bool hashed)
+{
+    NetDest dest;
+    for (int chiplet = 0; chiplet < num_chiplets; ++chiplet)
+        dest.add(mapAddressToTCC(addr, low_bit, num_bits, chiplet, hashed));
+    return dest;
+}
+
 inline NetDest
 mapTCPToTCCs(MachineID sender, int num_gpus)
 {
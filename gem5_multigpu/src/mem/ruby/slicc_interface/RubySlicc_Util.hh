@@ -57,6 +57,7 @@
 #include "mem/ruby/common/TypeDefines.hh"
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
+#include "mem/ruby/system/RubySystem.hh"
 
 inline Cycles zero_time() { return Cycles(0); }
 
@@ -96,6 +97,15 @@ mod(int val, int mod)
     return val % mod;
 }
 
+// True while the cache recorder replays a trace to warm up or flush the
+// caches around a checkpoint
+inline bool
+cacheTraceEnabled()
+{
+    return RubySystem::getWarmupEnabled() ||
+           RubySystem::getCooldownEnabled();
+}
+
 inline int max_tokens()
 {
   return 1024;
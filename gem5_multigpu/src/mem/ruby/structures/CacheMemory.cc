@@ -41,6 +41,9 @@
 
 #include "mem/ruby/structures/CacheMemory.hh"
 
+#include <algorithm>
+#include <climits>
+
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "debug/HtmMem.hh"
@@ -75,6 +78,16 @@ CacheMemory::CacheMemory(const Params &p)
     m_is_instruction_only_cache = p.is_icache;
     m_resource_stalls = p.resourceStalls;
     m_block_size = p.block_size;  // may be 0 at this point. Updated in init()
+    m_flat_tags = p.flat_tag_store;
+    m_compressor = p.compressor;
+    m_max_comp_ratio = m_compressor ? p.max_compression_ratio : 1;
+    m_comp_ratio_bits = floorLog2(m_max_comp_ratio);
+    m_data_assoc = m_cache_assoc;
+    m_valid_lines = 0;
+    m_last_comp_addr = MaxAddr;
+    m_last_comp_size = 0;
+    fatal_if(!isPowerOf2(m_max_comp_ratio),
+             "The compression ratio of a cache must be a power of 2");
     m_use_occupancy = dynamic_cast<ReplacementPolicy::WeightedLRU*>(
                                     m_replacementPolicy_ptr) ? true : false;
 }
@@ -85,18 +98,27 @@ CacheMemory::init()
     if (m_block_size == 0) {
         m_block_size = RubySystem::getBlockSizeBytes();
     }
-    m_cache_num_sets = (m_cache_size / m_cache_assoc) / m_block_size;
+    m_cache_num_sets = (m_cache_size / m_data_assoc) / m_block_size;
     assert(m_cache_num_sets > 1);
     m_cache_num_set_bits = floorLog2(m_cache_num_sets);
     assert(m_cache_num_set_bits > 0);
 
+    // A compressed cache has a tag for every line a way can hold
+    m_cache_assoc = m_data_assoc * m_max_comp_ratio;
+    if (m_compressor) {
+        m_decomp_lat.assign(m_cache_num_sets * m_cache_assoc, Cycles(0));
+        m_comp_factor.assign(m_cache_num_sets * m_data_assoc, 1);
+    }
+
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    if (m_flat_tags)
+        m_tags.assign(m_cache_num_sets * m_cache_assoc, MaxAddr);
     replacement_data.resize(m_cache_num_sets,
-                               std::vector<ReplData>(m_cache_assoc, nullptr));
+                               std::vector<ReplData>(m_data_assoc, nullptr));
     // instantiate all the replacement_data here
     for (int i = 0; i < m_cache_num_sets; i++) {
-        for ( int j = 0; j < m_cache_assoc; j++) {
+        for ( int j = 0; j < m_data_assoc; j++) {
             replacement_data[i][j] =
                                 m_replacementPolicy_ptr->instantiateEntry();
         }
@@ -119,8 +141,10 @@ int64_t
 CacheMemory::addressToCacheSet(Addr address) const
 {
     assert(address == makeLineAddress(address));
-    return bitSelect(address, m_start_index_bit,
-                     m_start_index_bit + m_cache_num_set_bits - 1);
+    // The lines of a super-block go to the same set
+    int start_bit = m_start_index_bit + m_comp_ratio_bits;
+    return bitSelect(address, start_bit,
+                     start_bit + m_cache_num_set_bits - 1);
 }
 
 // Given a cache index: returns the index of the tag in a set.
@@ -129,6 +153,13 @@ int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
+    if (m_flat_tags) {
+        int way = findWayInSet(cacheSet, tag);
+        if (way >= 0 && m_cache[cacheSet][way]->m_Permission !=
+            AccessPermission_NotPresent)
+            return way;
+        return -1;
+    }
     // search the set for the tags
     auto it = m_tag_index.find(tag);
     if (it != m_tag_index.end())
@@ -145,6 +176,8 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
                                            Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
+    if (m_flat_tags)
+        return findWayInSet(cacheSet, tag);
     // search the set for the tags
     auto it = m_tag_index.find(tag);
     if (it != m_tag_index.end())
@@ -152,6 +185,18 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
     return -1; // Not found
 }
 
+int
+CacheMemory::findWayInSet(int64_t cacheSet, Addr tag) const
+{
+    // Compare every way without branching on the result, so that the
+    // compiler can vectorize the search. A tag is in at most one way.
+    const Addr *tags = &m_tags[cacheSet * m_cache_assoc];
+    int way = -1;
+    for (int i = 0; i < m_cache_assoc; i++)
+        way = (tags[i] == tag) ? i : way;
+    return way;
+}
+
 // Given an unique cache block identifier (idx): return the valid address
 // stored by the cache block.  If the block is invalid/notpresent, the
 // function returns the 0 address
@@ -243,6 +288,13 @@ CacheMemory::cacheAvail(Addr address) const
 
     int64_t cacheSet = addressToCacheSet(address);
 
+    if (m_compressor) {
+        // Without the data, the line has to fit uncompressed
+        return findTagInSetIgnorePermissions(cacheSet, address) >= 0 ||
+               findCompressedWay(cacheSet, address,
+                                 m_block_size * CHAR_BIT) >= 0;
+    }
+
     for (int i = 0; i < m_cache_assoc; i++) {
         AbstractCacheEntry* entry = m_cache[cacheSet][i];
         if (entry != NULL) {
@@ -258,6 +310,22 @@ CacheMemory::cacheAvail(Addr address) const
     return false;
 }
 
+bool
+CacheMemory::cacheAvail(Addr address, const DataBlock& data)
+{
+    if (!m_compressor)
+        return cacheAvail(address);
+
+    assert(address == makeLineAddress(address));
+    int64_t cacheSet = addressToCacheSet(address);
+    if (findTagInSetIgnorePermissions(cacheSet, address) >= 0)
+        return true;
+
+    Cycles decomp_lat;
+    std::size_t size_bits = compressedSize(address, data, decomp_lat);
+    return findCompressedWay(cacheSet, address, size_bits) >= 0;
+}
+
 AbstractCacheEntry*
 CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
 {
@@ -266,6 +334,13 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
     assert(cacheAvail(address));
     DPRINTF(RubyCache, "address: %#x\n", address);
 
+    if (m_compressor) {
+        // The data is not known yet, so the line is not compressed until
+        // it is written
+        return allocateCompressed(address, entry, m_block_size * CHAR_BIT,
+                                  Cycles(0));
+    }
+
     // Find the first open slot
     int64_t cacheSet = addressToCacheSet(address);
     std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
@@ -278,16 +353,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
                     "leak here. Fix your protocol to eliminate these!",
                     address);
             }
-            set[i] = entry;  // Init entry
-            set[i]->m_Address = address;
-            set[i]->m_Permission = AccessPermission_Invalid;
-            DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
-                    address);
-            set[i]->m_locked = -1;
-            m_tag_index[address] = i;
-            set[i]->setPosition(cacheSet, i);
-            set[i]->replacementData = replacement_data[cacheSet][i];
-            set[i]->setLastAccess(curTick());
+            placeEntry(cacheSet, i, address, entry);
 
             // Call reset function here to set initial value for different
             // replacement policies.
@@ -299,18 +365,194 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
     panic("Allocate didn't find an available entry");
 }
 
+AbstractCacheEntry*
+CacheMemory::allocate(Addr address, AbstractCacheEntry *entry,
+                      const DataBlock& data)
+{
+    if (!m_compressor)
+        return allocate(address, entry);
+
+    assert(address == makeLineAddress(address));
+    assert(!isTagPresent(address));
+    DPRINTF(RubyCache, "address: %#x\n", address);
+
+    Cycles decomp_lat;
+    std::size_t size_bits = compressedSize(address, data, decomp_lat);
+    return allocateCompressed(address, entry, size_bits, decomp_lat);
+}
+
+void
+CacheMemory::placeEntry(int64_t cacheSet, int way, Addr address,
+                        AbstractCacheEntry *entry)
+{
+    m_cache[cacheSet][way] = entry;  // Init entry
+    entry->m_Address = address;
+    entry->m_Permission = AccessPermission_Invalid;
+    DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n", address);
+    entry->m_locked = -1;
+    if (m_flat_tags)
+        m_tags[cacheSet * m_cache_assoc + way] = address;
+    else
+        m_tag_index[address] = way;
+    entry->setPosition(cacheSet, way);
+    entry->replacementData =
+        replacement_data[cacheSet][way >> m_comp_ratio_bits];
+    entry->setLastAccess(curTick());
+}
+
+AbstractCacheEntry*
+CacheMemory::allocateCompressed(Addr address, AbstractCacheEntry *entry,
+                                std::size_t size_bits, Cycles decomp_lat)
+{
+    int64_t cacheSet = addressToCacheSet(address);
+    int data_way = findCompressedWay(cacheSet, address, size_bits);
+    panic_if(data_way < 0, "Allocate didn't find an available way");
+
+    // A line takes the tag of its offset in the super-block
+    int way = (data_way << m_comp_ratio_bits) +
+              ((address >> floorLog2(m_block_size)) &
+               (m_max_comp_ratio - 1));
+    warn_if(m_cache[cacheSet][way], "Replacing a NotPresent entry: %#x",
+            address);
+    bool shared = numValidInWay(cacheSet, data_way) > 0;
+
+    placeEntry(cacheSet, way, address, entry);
+    m_decomp_lat[cacheSet * m_cache_assoc + way] = decomp_lat;
+
+    // The first line of a way sets its compression factor, and the lines
+    // that join it share the recency of the way
+    int &factor = m_comp_factor[cacheSet * m_data_assoc + data_way];
+    if (shared) {
+        cacheMemoryStats.m_co_allocations++;
+        m_replacementPolicy_ptr->touch(entry->replacementData);
+    } else {
+        factor = compressionFactor(size_bits);
+        m_replacementPolicy_ptr->reset(entry->replacementData);
+    }
+    if (factor > 1)
+        cacheMemoryStats.m_compressed_fills++;
+    DPRINTF(RubyCache, "address %#x compressed to %d bits in way %d, "
+            "compression factor %d\n", address, size_bits, data_way, factor);
+
+    cacheMemoryStats.m_valid_lines = ++m_valid_lines;
+    return entry;
+}
+
+std::size_t
+CacheMemory::compressedSize(Addr address, const DataBlock& data,
+                            Cycles& decomp_lat)
+{
+    const uint8_t *bytes = data.getData(0, m_block_size);
+    if (address != m_last_comp_addr ||
+        !std::equal(bytes, bytes + m_block_size, m_last_comp_data.begin())) {
+        Cycles comp_lat;
+        std::unique_ptr<Compressor::Base::CompressionData> comp_data =
+            m_compressor->compress(reinterpret_cast<const uint64_t*>(bytes),
+                                   comp_lat, m_last_decomp_lat);
+        m_last_comp_addr = address;
+        m_last_comp_data.assign(bytes, bytes + m_block_size);
+        m_last_comp_size = comp_data->getSizeBits();
+    }
+    decomp_lat = m_last_decomp_lat;
+    return m_last_comp_size;
+}
+
+int
+CacheMemory::compressionFactor(std::size_t size_bits) const
+{
+    // As in the Classic super-blocks, the largest power of 2 of lines
+    // that fit in a way
+    int factor = 1;
+    while (factor < m_max_comp_ratio && fitsFactor(size_bits, 2 * factor))
+        factor *= 2;
+    return factor;
+}
+
+bool
+CacheMemory::fitsFactor(std::size_t size_bits, int factor) const
+{
+    return size_bits <= std::size_t(m_block_size * CHAR_BIT / factor);
+}
+
+bool
+CacheMemory::isWayValid(int64_t cacheSet, int way) const
+{
+    const AbstractCacheEntry *entry = m_cache[cacheSet][way];
+    return entry && entry->m_Permission != AccessPermission_NotPresent;
+}
+
+int
+CacheMemory::numValidInWay(int64_t cacheSet, int data_way) const
+{
+    int valid = 0;
+    for (int i = 0; i < m_max_comp_ratio; i++)
+        valid += isWayValid(cacheSet, (data_way << m_comp_ratio_bits) + i);
+    return valid;
+}
+
+int
+CacheMemory::findCompressedWay(int64_t cacheSet, Addr address,
+                               std::size_t size_bits) const
+{
+    int block_bits = floorLog2(m_block_size);
+    Addr super_block = address >> (block_bits + m_comp_ratio_bits);
+    int offset = (address >> block_bits) & (m_max_comp_ratio - 1);
+
+    // Prefer sharing a way with the lines of the same super-block, and
+    // only take an empty way if none has room
+    int empty_way = -1;
+    for (int d = 0; d < m_data_assoc; d++) {
+        int first = d << m_comp_ratio_bits;
+        int valid = 0;
+        bool same_block = true;
+        for (int i = 0; i < m_max_comp_ratio; i++) {
+            if (!isWayValid(cacheSet, first + i))
+                continue;
+            valid++;
+            same_block &= (m_cache[cacheSet][first + i]->m_Address >>
+                           (block_bits + m_comp_ratio_bits)) == super_block;
+        }
+        if (valid == 0) {
+            if (empty_way < 0)
+                empty_way = d;
+            continue;
+        }
+
+        int factor = m_comp_factor[cacheSet * m_data_assoc + d];
+        if (same_block && !isWayValid(cacheSet, first + offset) &&
+            valid < factor && fitsFactor(size_bits, factor)) {
+            return d;
+        }
+    }
+    return empty_way;
+}
+
 void
 CacheMemory::deallocate(Addr address)
 {
     DPRINTF(RubyCache, "address: %#x\n", address);
     AbstractCacheEntry* entry = lookup(address);
     assert(entry != nullptr);
-    m_replacementPolicy_ptr->invalidate(entry->replacementData);
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
+    // The lines of a compressed way share its replacement data
+    int data_way = way >> m_comp_ratio_bits;
+    bool last_in_way = !m_compressor ||
+                       numValidInWay(cache_set, data_way) == 1;
+    if (last_in_way)
+        m_replacementPolicy_ptr->invalidate(entry->replacementData);
     delete entry;
     m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    if (m_flat_tags)
+        m_tags[cache_set * m_cache_assoc + way] = MaxAddr;
+    else
+        m_tag_index.erase(address);
+
+    if (m_compressor) {
+        if (last_in_way)
+            m_comp_factor[cache_set * m_data_assoc + data_way] = 1;
+        cacheMemoryStats.m_valid_lines = --m_valid_lines;
+    }
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -322,14 +564,109 @@ CacheMemory::cacheProbe(Addr address) const
 
     int64_t cacheSet = addressToCacheSet(address);
     std::vector<ReplaceableEntry*> candidates;
-    for (int i = 0; i < m_cache_assoc; i++) {
-        candidates.push_back(static_cast<ReplaceableEntry*>(
+    if (m_compressor) {
+        // Pick a way, and one of its lines. The other lines follow on the
+        // next probes, as the way keeps its replacement data until it is
+        // empty.
+        for (int d = 0; d < m_data_assoc; d++) {
+            for (int i = 0; i < m_max_comp_ratio; i++) {
+                int way = (d << m_comp_ratio_bits) + i;
+                if (m_cache[cacheSet][way]) {
+                    candidates.push_back(m_cache[cacheSet][way]);
+                    break;
+                }
+            }
+        }
+    } else {
+        for (int i = 0; i < m_cache_assoc; i++) {
+            candidates.push_back(static_cast<ReplaceableEntry*>(
                                                        m_cache[cacheSet][i]));
+        }
     }
     return m_cache[cacheSet][m_replacementPolicy_ptr->
                         getVictim(candidates)->getWay()]->m_Address;
 }
 
+bool
+CacheMemory::fitsWrite(Addr address, const DataBlock& data,
+                       const WriteMask& mask)
+{
+    AbstractCacheEntry* entry = lookup(address);
+    if (!m_compressor || entry == nullptr)
+        return true;
+
+    int64_t cacheSet = entry->getSet();
+    int data_way = entry->getWay() >> m_comp_ratio_bits;
+    if (numValidInWay(cacheSet, data_way) == 1)
+        return true;
+
+    DataBlock written = entry->getDataBlk();
+    written.copyPartial(data, mask);
+    Cycles decomp_lat;
+    std::size_t size_bits = compressedSize(address, written, decomp_lat);
+    return fitsFactor(size_bits,
+                      m_comp_factor[cacheSet * m_data_assoc + data_way]);
+}
+
+Addr
+CacheMemory::coAllocatedProbe(Addr address) const
+{
+    const AbstractCacheEntry* entry = lookup(address);
+    assert(m_compressor && entry != nullptr);
+
+    int64_t cacheSet = entry->getSet();
+    int first = (entry->getWay() >> m_comp_ratio_bits) << m_comp_ratio_bits;
+    for (int i = 0; i < m_max_comp_ratio; i++) {
+        const AbstractCacheEntry* other = m_cache[cacheSet][first + i];
+        if (other && other != entry)
+            return other->m_Address;
+    }
+    panic("No other line shares the way of %#x", address);
+}
+
+void
+CacheMemory::recompress(Addr address)
+{
+    AbstractCacheEntry* entry = lookup(address);
+    if (!m_compressor || entry == nullptr)
+        return;
+
+    int64_t cacheSet = entry->getSet();
+    int way = entry->getWay();
+    int data_way = way >> m_comp_ratio_bits;
+    Cycles decomp_lat;
+    std::size_t size_bits = compressedSize(address, entry->getDataBlk(),
+                                           decomp_lat);
+    m_decomp_lat[cacheSet * m_cache_assoc + way] = decomp_lat;
+
+    // A line alone in its way can change its compression factor, while
+    // one that shares it must have been checked with fitsWrite()
+    int &factor = m_comp_factor[cacheSet * m_data_assoc + data_way];
+    if (numValidInWay(cacheSet, data_way) == 1) {
+        factor = compressionFactor(size_bits);
+    } else {
+        panic_if(!fitsFactor(size_bits, factor),
+                 "Line %#x does not fit its way after a write", address);
+    }
+}
+
+Cycles
+CacheMemory::getDecompressionLatency(Addr address)
+{
+    const AbstractCacheEntry* entry = lookup(address);
+    if (!m_compressor || entry == nullptr)
+        return Cycles(0);
+
+    int64_t cacheSet = entry->getSet();
+    int way = entry->getWay();
+    if (m_comp_factor[cacheSet * m_data_assoc +
+                      (way >> m_comp_ratio_bits)] == 1) {
+        return Cycles(0);
+    }
+    cacheMemoryStats.m_decompressions++;
+    return m_decomp_lat[cacheSet * m_cache_assoc + way];
+}
+
 // looks an address up in the cache
 AbstractCacheEntry*
 CacheMemory::lookup(Addr address)
@@ -537,7 +874,13 @@ CacheMemoryStats::CacheMemoryStats(Stats::Group *parent)
       ADD_STAT(m_hw_prefetches, "Number of hardware prefetches"),
       ADD_STAT(m_prefetches, "Number of prefetches",
                m_sw_prefetches + m_hw_prefetches),
-      ADD_STAT(m_accessModeType, "")
+      ADD_STAT(m_accessModeType, ""),
+      ADD_STAT(m_compressed_fills, "Number of lines stored compressed"),
+      ADD_STAT(m_co_allocations, "Number of lines stored in a way that "
+                                 "already held lines of their super-block"),
+      ADD_STAT(m_decompressions, "Number of reads of compressed lines"),
+      ADD_STAT(m_valid_lines, "Average number of lines in a compressed "
+                              "cache")
 {
     numDataArrayReads
         .flags(Stats::nozero);
@@ -592,6 +935,18 @@ CacheMemoryStats::CacheMemoryStats(Stats::Group *parent)
             .flags(Stats::nozero)
             ;
     }
+
+    m_compressed_fills
+        .flags(Stats::nozero);
+
+    m_co_allocations
+        .flags(Stats::nozero);
+
+    m_decompressions
+        .flags(Stats::nozero);
+
+    m_valid_lines
+        .flags(Stats::nozero);
 }
 
 // assumption: SLICC generated files will only call this function
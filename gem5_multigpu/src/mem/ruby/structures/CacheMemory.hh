@@ -47,9 +47,11 @@
 #include <vector>
 
 #include "base/statistics.hh"
+#include "mem/cache/compressors/base.hh"
 #include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/protocol/CacheRequestType.hh"
 #include "mem/ruby/protocol/CacheResourceType.hh"
 #include "mem/ruby/protocol/RubyRequest.hh"
@@ -86,6 +88,9 @@ class CacheMemory : public SimObject
     //   a) a tag match on this address or there is
     //   b) an unused line in the same cache "way"
     bool cacheAvail(Addr address) const;
+    // Same, for a line with the given data, which decides how many lines
+    // it can share a way with when the cache is compressed
+    bool cacheAvail(Addr address, const DataBlock& data);
 
     // Returns a NULL entry that acts as a placeholder for invalid lines
     AbstractCacheEntry*
@@ -96,6 +101,8 @@ class CacheMemory : public SimObject
 
     // find an unused entry and sets the tag appropriate for the address
     AbstractCacheEntry* allocate(Addr address, AbstractCacheEntry* new_entry);
+    AbstractCacheEntry* allocate(Addr address, AbstractCacheEntry* new_entry,
+                                 const DataBlock& data);
     void allocateVoid(Addr address, AbstractCacheEntry* new_entry)
     {
         allocate(address, new_entry);
@@ -107,6 +114,17 @@ class CacheMemory : public SimObject
     // Returns with the physical address of the conflicting cache line
     Addr cacheProbe(Addr address) const;
 
+    // Compressed caches: whether the line still fits its way once the
+    // write is applied, and if not which line to evict from the way to
+    // make room for it
+    bool fitsWrite(Addr address, const DataBlock& data,
+                   const WriteMask& mask);
+    Addr coAllocatedProbe(Addr address) const;
+    // Compress the line again after its data was written
+    void recompress(Addr address);
+    // Cycles to decompress the line on a read, 0 if it is not compressed
+    Cycles getDecompressionLatency(Addr address);
+
     // looks an address up in the cache
     AbstractCacheEntry* lookup(Addr address);
     const AbstractCacheEntry* lookup(Addr address) const;
@@ -161,6 +179,28 @@ class CacheMemory : public SimObject
     // returns -1 if the tag is not found.
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
+    // Search the flat tag store for the way holding the tag, -1 if none
+    int findWayInSet(int64_t cacheSet, Addr tag) const;
+
+    // Put an entry in a free way of a set
+    void placeEntry(int64_t cacheSet, int way, Addr address,
+                    AbstractCacheEntry* entry);
+
+    // Compressed caches
+    AbstractCacheEntry* allocateCompressed(Addr address,
+                                           AbstractCacheEntry* entry,
+                                           std::size_t size_bits,
+                                           Cycles decomp_lat);
+    std::size_t compressedSize(Addr address, const DataBlock& data,
+                               Cycles& decomp_lat);
+    int compressionFactor(std::size_t size_bits) const;
+    // Whether a line fits a way of the given compression factor
+    bool fitsFactor(std::size_t size_bits, int factor) const;
+    // The physical way a line of the set can go to, -1 if none
+    int findCompressedWay(int64_t cacheSet, Addr address,
+                          std::size_t size_bits) const;
+    int numValidInWay(int64_t cacheSet, int data_way) const;
+    bool isWayValid(int64_t cacheSet, int way) const;
 
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
@@ -175,9 +215,41 @@ class CacheMemory : public SimObject
     std::unordered_map<Addr, int> m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
 
+    // Optional flat tag store used instead of m_tag_index. It holds the
+    // line address of every way, set by set, so a lookup only compares
+    // the ways of one set. Empty ways hold MaxAddr, which is never a line
+    // address.
+    bool m_flat_tags;
+    std::vector<Addr> m_tags;
+
     /** We use the replacement policies from the Classic memory system. */
     ReplacementPolicy::Base *m_replacementPolicy_ptr;
 
+    /**
+     * Optional compressor from the Classic memory system. With one, every
+     * physical way holds a super-block of up to m_max_comp_ratio
+     * consecutive lines, each with its own tag, as long as they all
+     * compress to the fraction of the way given by its compression
+     * factor. m_cache_assoc then counts the tags, and m_data_assoc the
+     * physical ways, which share the replacement data of their lines.
+     */
+    Compressor::Base *m_compressor;
+    int m_max_comp_ratio;
+    int m_comp_ratio_bits;
+    int m_data_assoc;
+    // Decompression latency of every tag
+    std::vector<Cycles> m_decomp_lat;
+    // Compression factor of every physical way
+    std::vector<int> m_comp_factor;
+    int m_valid_lines;
+
+    // The last line compressed, since a fill that waits for a
+    // replacement asks whether it fits more than once
+    Addr m_last_comp_addr;
+    std::vector<uint8_t> m_last_comp_data;
+    std::size_t m_last_comp_size;
+    Cycles m_last_decomp_lat;
+
     BankedArray dataArray;
     BankedArray tagArray;
 
@@ -233,6 +305,11 @@ class CacheMemory : public SimObject
           Stats::Formula m_prefetches;
 
           Stats::Vector m_accessModeType;
+
+          Stats::Scalar m_compressed_fills;
+          Stats::Scalar m_co_allocations;
+          Stats::Scalar m_decompressions;
+          Stats::Average m_valid_lines;
       } cacheMemoryStats;
 
     public:
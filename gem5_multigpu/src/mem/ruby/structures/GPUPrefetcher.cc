@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/structures/GPUPrefetcher.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/RubyPrefetcher.hh"
+#include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
+#include "mem/ruby/system/RubySystem.hh"
+#include "sim/system.hh"
+
+GPUPrefetcher::GPUPrefetcher(const Params &p)
+    : SimObject(p), m_controller(nullptr), m_next_line(p.next_line),
+      m_degree(p.degree), m_train_threshold(p.train_threshold),
+      m_max_inflight(p.max_inflight), m_region_size(p.region_size),
+      m_page_shift(p.sys->getPageShift()), m_slice(p.slice),
+      m_slice_bits(p.slice_bits), m_slice_hashed(p.slice_hashed),
+      m_pollution_size(p.pollution_filter), m_queued(0), m_inflight(0),
+      m_epoch(0),
+      m_home_node(-1), stats(this)
+{
+    fatal_if(m_degree == 0, "A GPU prefetcher needs a degree of at least 1");
+    fatal_if(p.table_entries == 0, "A GPU prefetcher needs table entries");
+    if (m_next_line) {
+        fatal_if(m_region_size, "A next-line prefetcher has no regions");
+    } else if (m_region_size) {
+        fatal_if(!isPowerOf2(m_region_size) ||
+                 m_region_size < RubySystem::getBlockSizeBytes() ||
+                 m_region_size > 64 * RubySystem::getBlockSizeBytes(),
+                 "The prefetch region size must be a power of 2 of 1 to "
+                 "64 lines");
+        m_regions.resize(p.table_entries);
+    } else {
+        m_strides.resize(p.table_entries);
+    }
+}
+
+GPUPrefetcher::
+GPUPrefetcherStats::GPUPrefetcherStats(Stats::Group *parent)
+    : Stats::Group(parent),
+      ADD_STAT(missesObserved, "Number of demand misses observed"),
+      ADD_STAT(preloads, "Number of lines the command processor asked "
+                         "to preload"),
+      ADD_STAT(prefetchesIssued, "Number of prefetches sent"),
+      ADD_STAT(prefetchesDropped, "Number of prefetches not sent because "
+                                  "the line was present or pending, or "
+                                  "too many prefetches were in flight"),
+      ADD_STAT(staleFills, "Number of prefetch fills not kept because an "
+                           "acquire invalidated the cache after the "
+                           "prefetch was sent"),
+      ADD_STAT(usefulPrefetches, "Number of prefetched lines hit by a "
+                                 "demand load"),
+      ADD_STAT(latePrefetches, "Number of demand loads to a line whose "
+                               "prefetch was in flight"),
+      ADD_STAT(unusedPrefetches, "Number of prefetched lines evicted or "
+                                 "invalidated before a demand load used "
+                                 "them"),
+      ADD_STAT(pollutionMisses, "Number of demand misses to lines that a "
+                                "prefetch fill replaced"),
+      ADD_STAT(accuracy, "Fraction of the prefetches sent that a demand "
+                         "load used, in time or late"),
+      ADD_STAT(coverage, "Fraction of the demand misses that a prefetch "
+                         "removed or shortened")
+{
+    accuracy = (usefulPrefetches + latePrefetches) / prefetchesIssued;
+    coverage = (usefulPrefetches + latePrefetches) /
+               (usefulPrefetches + latePrefetches + missesObserved);
+}
+
+void
+GPUPrefetcher::observeMiss(Addr line, Addr pc, int home_node)
+{
+    stats.missesObserved++;
+
+    if (m_replaced_set.erase(line)) {
+        DPRINTF(RubyPrefetcher, "Miss to %#x replaced by a prefetch\n",
+                line);
+        stats.pollutionMisses++;
+        m_replaced.erase(std::find(m_replaced.begin(), m_replaced.end(),
+                                   line));
+    }
+
+    train(line, pc, home_node);
+}
+
+void
+GPUPrefetcher::observePfHit(Addr line, Addr pc, int home_node)
+{
+    stats.usefulPrefetches++;
+    train(line, pc, home_node);
+}
+
+void
+GPUPrefetcher::observePfLate(Addr line, Addr pc, int home_node)
+{
+    stats.latePrefetches++;
+    train(line, pc, home_node);
+}
+
+void
+GPUPrefetcher::observePfUnused(Addr line)
+{
+    stats.unusedPrefetches++;
+}
+
+void
+GPUPrefetcher::observePfReplacement(Addr victim)
+{
+    if (m_pollution_size == 0 || !m_replaced_set.insert(victim).second)
+        return;
+
+    m_replaced.push_back(victim);
+    if (m_replaced.size() > m_pollution_size) {
+        m_replaced_set.erase(m_replaced.front());
+        m_replaced.pop_front();
+    }
+}
+
+void
+GPUPrefetcher::observeFetchStream(Addr line)
+{
+    if (!m_next_line)
+        return;
+
+    int block_size = RubySystem::getBlockSizeBytes();
+    Addr page = pageAddress(line);
+    for (unsigned i = 1; i <= m_degree; i++) {
+        Addr pf_line = line + i * block_size;
+        if (pageAddress(pf_line) != page)
+            break;
+        if (mapsHere(pf_line))
+            prefetch(pf_line);
+    }
+}
+
+void
+GPUPrefetcher::preload(Addr line)
+{
+    stats.preloads++;
+    m_preloads.push_back(line);
+    sendPreloads();
+}
+
+void
+GPUPrefetcher::sendPreloads()
+{
+    while (!m_preloads.empty() && m_queued + m_inflight < m_max_inflight) {
+        prefetch(m_preloads.front());
+        m_preloads.pop_front();
+    }
+}
+
+void
+GPUPrefetcher::issued(Addr line)
+{
+    DPRINTF(RubyPrefetcher, "Prefetching %#x\n", line);
+    stats.prefetchesIssued++;
+    assert(m_queued > 0);
+    m_queued--;
+    m_inflight++;
+}
+
+void
+GPUPrefetcher::dropped(Addr line)
+{
+    stats.prefetchesDropped++;
+    assert(m_queued > 0);
+    m_queued--;
+    sendPreloads();
+}
+
+void
+GPUPrefetcher::completed(Addr line, bool stale)
+{
+    assert(m_inflight > 0);
+    m_inflight--;
+    if (stale) {
+        DPRINTF(RubyPrefetcher, "Dropping stale prefetch of %#x\n", line);
+        stats.staleFills++;
+    }
+    sendPreloads();
+}
+
+void
+GPUPrefetcher::train(Addr line, Addr pc, int home_node)
+{
+    m_home_node = home_node;
+    if (m_next_line) {
+        return;
+    } else if (m_region_size) {
+        trainRegion(line);
+    } else {
+        trainStride(line, pc);
+    }
+}
+
+void
+GPUPrefetcher::trainStride(Addr line, Addr pc)
+{
+    Addr page = pageAddress(line);
+    size_t idx = (pc ^ (page >> m_page_shift) * 0x9e3779b97f4a7c15ULL) %
+                 m_strides.size();
+    StrideEntry &entry = m_strides[idx];
+
+    if (!entry.valid || entry.pc != pc || entry.page != page) {
+        entry.valid = true;
+        entry.pc = pc;
+        entry.page = page;
+        entry.lastLine = line;
+        entry.stride = 0;
+        entry.confidence = 0;
+        entry.lastPrefetch = line;
+        return;
+    }
+
+    int block_size = RubySystem::getBlockSizeBytes();
+    int64_t stride = ((int64_t)line - (int64_t)entry.lastLine) / block_size;
+    if (stride == 0)
+        return;
+
+    if (stride == entry.stride) {
+        entry.confidence = std::min(entry.confidence + 1, m_train_threshold);
+    } else {
+        entry.stride = stride;
+        entry.confidence = 0;
+        entry.lastPrefetch = line;
+    }
+    entry.lastLine = line;
+
+    if (entry.confidence < m_train_threshold)
+        return;
+
+    // Only prefetch the lines past the ones already prefetched, so that a
+    // stream sends one prefetch per load once it is degree lines ahead
+    for (unsigned i = 1; i <= m_degree; i++) {
+        Addr pf_line = line + i * stride * block_size;
+        if (pageAddress(pf_line) != page)
+            break;
+        if (stride > 0 ? pf_line <= entry.lastPrefetch :
+                         pf_line >= entry.lastPrefetch) {
+            continue;
+        }
+        if (mapsHere(pf_line))
+            prefetch(pf_line);
+        entry.lastPrefetch = pf_line;
+    }
+}
+
+void
+GPUPrefetcher::trainRegion(Addr line)
+{
+    Addr region = line & ~(m_region_size - 1);
+    size_t idx = (region / m_region_size) % m_regions.size();
+    RegionEntry &entry = m_regions[idx];
+
+    int block_size = RubySystem::getBlockSizeBytes();
+    unsigned num_lines = m_region_size / block_size;
+    unsigned offset = (line - region) / block_size;
+
+    if (!entry.valid || entry.region != region) {
+        entry.valid = true;
+        entry.region = region;
+        entry.misses = 0;
+        entry.requested = 0;
+    }
+    entry.misses++;
+    entry.requested |= uint64_t(1) << offset;
+
+    if (entry.misses < m_train_threshold)
+        return;
+
+    // Prefetch the next lines of the region that were not requested yet,
+    // going up from the line and wrapping around, and skipping the lines
+    // of the other slices
+    unsigned sent = 0;
+    for (unsigned i = 1; i < num_lines && sent < m_degree; i++) {
+        unsigned pf_offset = (offset + i) % num_lines;
+        Addr pf_line = region + pf_offset * block_size;
+        if ((entry.requested & (uint64_t(1) << pf_offset)) ||
+            !mapsHere(pf_line)) {
+            continue;
+        }
+        entry.requested |= uint64_t(1) << pf_offset;
+        prefetch(pf_line);
+        sent++;
+    }
+}
+
+bool
+GPUPrefetcher::mapsHere(Addr line) const
+{
+    if (m_slice < 0)
+        return true;
+    return mapAddressToTCCSlice(line, RubySystem::getBlockSizeBits(),
+                                m_slice_bits, m_slice_hashed) == (NodeID)m_slice;
+}
+
+void
+GPUPrefetcher::prefetch(Addr line)
+{
+    assert(m_controller);
+    m_queued++;
+    m_controller->enqueuePrefetch(line, RubyRequestType_LD);
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_GPUPREFETCHER_HH__
+#define __MEM_RUBY_STRUCTURES_GPUPREFETCHER_HH__
+
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/ruby/common/Address.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
+#include "params/GPUPrefetcher.hh"
+#include "sim/sim_object.hh"
+
+/**
+ * A prefetcher for the GPU caches. It is either a stride prefetcher,
+ * which the TCP uses, a region prefetcher, which the TCC uses, or a
+ * next-line prefetcher, which the SQC uses.
+ *
+ * The stride prefetcher trains on the PC of the load and the page it
+ * accesses. The wavefronts of a CU run the same loads on different
+ * parts of an array, so a stride per PC alone would see the addresses
+ * of all of them interleaved; per PC and page it sees the stream of
+ * one wavefront, or of a few that walk the page together. Once a stride
+ * repeats, it prefetches up to degree lines ahead in the page.
+ *
+ * The region prefetcher counts the misses to each aligned region, and
+ * once a region has had enough of them prefetches the next lines of the
+ * region that have not been requested yet.
+ *
+ * The TCC slices interleave the lines, so the prefetcher of a slice
+ * skips the lines that map to the other slices: no core asks this slice
+ * for them.
+ *
+ * The next-line prefetcher does not train. The fetch unit marks the
+ * first fetch of each fetch stream, at the start of a wavefront or
+ * after a branch, and the prefetcher sends the degree lines after it
+ * in the page. The command processor can also preload the code of a
+ * kernel through it when it dispatches the kernel. The preloads wait in
+ * the prefetcher until there is room for them in flight, so that a
+ * large preload is not dropped.
+ *
+ * The controller sends the prefetches and tells the prefetcher how they
+ * end up: used by a load, hit by a load while still in flight (late),
+ * evicted unused, or dropped at the fill because an acquire invalidated
+ * the cache after the prefetch was sent. The lines replaced by prefetch
+ * fills are kept in a small filter, so the misses they cause afterwards
+ * are counted as cache pollution.
+ */
+class GPUPrefetcher : public SimObject
+{
+  public:
+    typedef GPUPrefetcherParams Params;
+    GPUPrefetcher(const Params &p);
+
+    void setController(AbstractController *ctrl) { m_controller = ctrl; }
+
+    /**
+     * A demand load to a line missed. The home node is that of the
+     * load's page, and is kept for the prefetches that the load leads to.
+     */
+    void observeMiss(Addr line, Addr pc, int home_node);
+    /** A demand load hit a prefetched line for the first time */
+    void observePfHit(Addr line, Addr pc, int home_node);
+    /** A demand load hit a line whose prefetch is in flight */
+    void observePfLate(Addr line, Addr pc, int home_node);
+    /** A prefetched line left the cache before a load used it */
+    void observePfUnused(Addr line);
+    /** A prefetch fill replaced a line */
+    void observePfReplacement(Addr victim);
+    /** An instruction fetch started a new fetch stream */
+    void observeFetchStream(Addr line);
+
+    /**
+     * Prefetch a line that is known to be needed soon, once fewer than
+     * max_inflight prefetches are queued or in flight
+     */
+    void preload(Addr line);
+
+    /** Whether another prefetch can be sent */
+    bool canIssue() const { return m_inflight < m_max_inflight; }
+    /** The controller sent a prefetch */
+    void issued(Addr line);
+    /** The controller did not send a prefetch */
+    void dropped(Addr line);
+    /**
+     * The data of a prefetch arrived. It is stale if the cache was
+     * invalidated after the prefetch was sent, and is not kept.
+     */
+    void completed(Addr line, bool stale);
+
+    /**
+     * The invalidation epoch. An acquire invalidates the cache, and a
+     * prefetch sent in an earlier epoch may have read data that is stale
+     * for the loads after it.
+     */
+    int getEpoch() const { return m_epoch; }
+    void invalidate() { m_epoch++; }
+
+    /**
+     * The home node of the load being trained on. The prefetches do not
+     * leave the page of the load, so they have the same home node.
+     */
+    int getHomeNode() const { return m_home_node; }
+
+  private:
+    struct StrideEntry
+    {
+        bool valid = false;
+        Addr pc = 0;
+        Addr page = 0;
+        Addr lastLine = 0;
+        // Stride in lines
+        int64_t stride = 0;
+        unsigned confidence = 0;
+        // The furthest line prefetched on this stride
+        Addr lastPrefetch = 0;
+    };
+
+    struct RegionEntry
+    {
+        bool valid = false;
+        Addr region = 0;
+        unsigned misses = 0;
+        // The lines of the region that were requested or prefetched
+        uint64_t requested = 0;
+    };
+
+    // Train on a load and send the prefetches it leads to
+    void train(Addr line, Addr pc, int home_node);
+    void trainStride(Addr line, Addr pc);
+    void trainRegion(Addr line);
+
+    void prefetch(Addr line);
+    // Whether the cache is asked for the line, which a TCC slice is not
+    // for the lines of the other slices
+    bool mapsHere(Addr line) const;
+    // Send the waiting preloads that there is room for
+    void sendPreloads();
+
+    Addr pageAddress(Addr addr) const
+    { return addr & ~((Addr(1) << m_page_shift) - 1); }
+
+    AbstractController *m_controller;
+
+    const bool m_next_line;
+    const unsigned m_degree;
+    const unsigned m_train_threshold;
+    const unsigned m_max_inflight;
+    const Addr m_region_size;
+    const Addr m_page_shift;
+    const int m_slice;
+    const unsigned m_slice_bits;
+    const bool m_slice_hashed;
+
+    std::vector<StrideEntry> m_strides;
+    std::vector<RegionEntry> m_regions;
+
+    // The lines replaced by prefetch fills, oldest first
+    const unsigned m_pollution_size;
+    std::deque<Addr> m_replaced;
+    std::unordered_set<Addr> m_replaced_set;
+
+    // The preloads not sent yet, oldest first
+    std::deque<Addr> m_preloads;
+
+    // The prefetches sent to the controller that it did not issue or
+    // drop yet, and the ones it issued that did not complete
+    unsigned m_queued;
+    unsigned m_inflight;
+    int m_epoch;
+    int m_home_node;
+
+    struct GPUPrefetcherStats : public Stats::Group
+    {
+        GPUPrefetcherStats(Stats::Group *parent);
+
+        Stats::Scalar missesObserved;
+        Stats::Scalar preloads;
+        Stats::Scalar prefetchesIssued;
+        Stats::Scalar prefetchesDropped;
+        Stats::Scalar staleFills;
+        Stats::Scalar usefulPrefetches;
+        Stats::Scalar latePrefetches;
+        Stats::Scalar unusedPrefetches;
+        Stats::Scalar pollutionMisses;
+        Stats::Formula accuracy;
+        Stats::Formula coverage;
+    } stats;
+};
+
+#endif // __MEM_RUBY_STRUCTURES_GPUPREFETCHER_HH__
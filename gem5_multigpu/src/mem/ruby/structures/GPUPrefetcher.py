@@ -0,0 +1,53 @@
+# Copyright (c) 2026 The gem5 multi-GPU authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.SimObject import SimObject
+from m5.params import *
+from m5.proxy import *
+
+class GPUPrefetcher(SimObject):
+    type = 'GPUPrefetcher'
+    cxx_class = 'GPUPrefetcher'
+    cxx_header = "mem/ruby/structures/GPUPrefetcher.hh"
+
+    region_size = Param.MemorySize("0B", "Size of the regions of a region "
+            "prefetcher, 0 for a stride prefetcher trained on the PC")
+    next_line = Param.Bool(False, "Prefetch the lines after the start of "
+            "each instruction fetch stream instead of training on misses")
+    table_entries = Param.UInt32(64, "Number of strides or regions tracked")
+    degree = Param.UInt32(4, "Number of lines to prefetch ahead")
+    train_threshold = Param.UInt32(1, "Number of times a stride must "
+            "repeat, or of misses a region must see, before prefetching")
+    max_inflight = Param.UInt32(16, "Maximum number of prefetches in flight")
+    pollution_filter = Param.UInt32(64, "Number of lines replaced by "
+            "prefetch fills tracked to count pollution misses")
+    slice = Param.Int(-1, "The TCC slice of the prefetcher's cache, which "
+            "only prefetches the lines it is asked for, -1 if not sliced")
+    slice_bits = Param.UInt32(0, "Number of address bits that select the "
+            "TCC slice")
+    slice_hashed = Param.Bool(False, "Whether the TCC slice is selected "
+            "by hashed address bits")
+    sys = Param.System(Parent.any, "System this prefetcher belongs to")
@@ -26,6 +26,7 @@
 
 from m5.params import *
 from m5.proxy import *
+from m5.objects.Compressors import BaseCacheCompressor
 from m5.objects.ReplacementPolicies import *
 from m5.SimObject import SimObject
 
@@ -39,6 +40,12 @@ class RubyCache(SimObject):
     start_index_bit = Param.Int(6, "index start, default 6 for 64-byte line");
     is_icache = Param.Bool(False, "is instruction only cache");
     block_size = Param.MemorySize("0B", "block size in bytes. 0 means default RubyBlockSize")
+    flat_tag_store = Param.Bool(False, "keep the tags in contiguous per-set "
+                                "arrays instead of a global tag index")
+    compressor = Param.BaseCacheCompressor(NULL, "compress the data so "
+                                           "that a way holds several lines")
+    max_compression_ratio = Param.Unsigned(4, "most lines a way holds when "
+                                           "the cache is compressed")
 
     dataArrayBanks = Param.Int(1, "Number of banks for the data array")
     tagArrayBanks = Param.Int(1, "Number of banks for the tag array")
@@ -33,8 +33,12 @@
 
 #include "mem/ruby/system/GPUCoalescer.hh"
 
+#include <algorithm>
+
 #include "base/logging.hh"
+#include "base/output.hh"
 #include "base/str.hh"
+#include "config/have_protobuf.hh"
 #include "config/the_isa.hh"
 #include "cpu/testers/rubytest/RubyTester.hh"
 #include "debug/GPUCoalescer.hh"
@@ -53,107 +57,135 @@
 #include "mem/ruby/structures/CacheMemory.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "params/RubyGPUCoalescer.hh"
+#include "sim/sim_exit.hh"
+
+#if HAVE_PROTOBUF
+#include "mem/ruby/system/GPUMemTraceRecorder.hh"
+#endif
 
 UncoalescedTable::UncoalescedTable(GPUCoalescer *gc)
     : coalescer(gc)
 {
 }
 
+UncoalescedTable::InstPackets *
+UncoalescedTable::findInst(InstSeqNum seqNum)
+{
+    auto it = std::lower_bound(insts.begin(), insts.end(), seqNum,
+        [](const InstPackets &inst, InstSeqNum seq_num)
+        { return inst.seqNum < seq_num; });
+    return it != insts.end() && it->seqNum == seqNum ? &*it : nullptr;
+}
+
 void
 UncoalescedTable::insertPacket(PacketPtr pkt)
 {
     uint64_t seqNum = pkt->req->getReqInstSeqNum();
 
-    instMap[seqNum].push_back(pkt);
+    InstPackets *inst = findInst(seqNum);
+    if (!inst) {
+        auto it = insts.end();
+        while (it != insts.begin() && std::prev(it)->seqNum > seqNum)
+            --it;
+        it = insts.insert(it, InstPackets{seqNum, -1, PerInstPackets()});
+        if (!freePktLists.empty()) {
+            it->pkts.swap(freePktLists.back());
+            freePktLists.pop_back();
+        }
+        inst = &*it;
+    }
+
+    inst->pkts.push_back(pkt);
     DPRINTF(GPUCoalescer, "Adding 0x%X seqNum %d to map. (map %d vec %d)\n",
-            pkt->getAddr(), seqNum, instMap.size(), instMap[seqNum].size());
+            pkt->getAddr(), seqNum, insts.size(), inst->pkts.size());
 }
 
 bool
 UncoalescedTable::packetAvailable()
 {
-    return !instMap.empty();
+    return !insts.empty();
 }
 
 void
 UncoalescedTable::initPacketsRemaining(InstSeqNum seqNum, int count)
 {
-    if (!instPktsRemaining.count(seqNum)) {
-        instPktsRemaining[seqNum] = count;
+    InstPackets *inst = findInst(seqNum);
+    assert(inst);
+    if (inst->pktsRemaining < 0) {
+        inst->pktsRemaining = count;
     }
 }
 
 int
 UncoalescedTable::getPacketsRemaining(InstSeqNum seqNum)
 {
-    return instPktsRemaining[seqNum];
+    InstPackets *inst = findInst(seqNum);
+    assert(inst && inst->pktsRemaining >= 0);
+    return inst->pktsRemaining;
 }
 
 void
 UncoalescedTable::setPacketsRemaining(InstSeqNum seqNum, int count)
 {
-    instPktsRemaining[seqNum] = count;
+    InstPackets *inst = findInst(seqNum);
+    assert(inst);
+    inst->pktsRemaining = count;
 }
 
 PerInstPackets*
 UncoalescedTable::getInstPackets(int offset)
 {
-    if (offset >= instMap.size()) {
+    if (offset >= insts.size()) {
         return nullptr;
     }
 
-    auto instMapIter = instMap.begin();
-    std::advance(instMapIter, offset);
-
-    return &(instMapIter->second);
+    return &insts[offset].pkts;
 }
 
 void
 UncoalescedTable::updateResources()
 {
-    for (auto iter = instMap.begin(); iter != instMap.end(); ) {
-        InstSeqNum seq_num = iter->first;
+    auto last = insts.begin();
+    for (auto iter = insts.begin(); iter != insts.end(); ++iter) {
+        InstSeqNum seq_num = iter->seqNum;
         DPRINTF(GPUCoalescer, "%s checking remaining pkts for %d\n",
                 coalescer->name().c_str(), seq_num);
-        assert(instPktsRemaining.count(seq_num));
+        assert(iter->pktsRemaining >= 0);
 
-        if (instPktsRemaining[seq_num] == 0) {
-            assert(iter->second.empty());
+        if (iter->pktsRemaining == 0) {
+            assert(iter->pkts.empty());
 
-            // Remove from both maps
-            instMap.erase(iter++);
-            instPktsRemaining.erase(seq_num);
+            // Keep the packet list for a later instruction
+            freePktLists.push_back(std::move(iter->pkts));
 
             // Release the token
             DPRINTF(GPUCoalescer, "Returning token seqNum %d\n", seq_num);
             coalescer->getGMTokenPort().sendTokens(1);
         } else {
-            ++iter;
+            if (last != iter) {
+                *last = std::move(*iter);
+            }
+            ++last;
         }
     }
+    insts.erase(last, insts.end());
 }
 
 bool
 UncoalescedTable::areRequestsDone(const uint64_t instSeqNum) {
-    // iterate the instructions held in UncoalescedTable to see whether there
-    // are more requests to issue; if yes, not yet done; otherwise, done
-    for (auto& inst : instMap) {
-        DPRINTF(GPUCoalescer, "instSeqNum= %d, pending packets=%d\n"
-            ,inst.first, inst.second.size());
-        if (inst.first == instSeqNum) { return false; }
-    }
-
-    return true;
+    // see whether the instruction has more requests to issue in the
+    // UncoalescedTable; if yes, not yet done; otherwise, done
+    return !findInst(instSeqNum);
 }
 
 void
 UncoalescedTable::printRequestTable(std::stringstream& ss)
 {
-    ss << "Listing pending packets from " << instMap.size() << " instructions";
+    ss << "Listing pending packets from " << insts.size() << " instructions";
 
-    for (auto& inst : instMap) {
-        ss << "\tAddr: " << printAddress(inst.first) << " with "
-           << inst.second.size() << " pending packets" << std::endl;
+    for (auto& inst : insts) {
+        ss << "\tAddr: " << printAddress(inst.seqNum) << " with "
+           << inst.pkts.size() << " pending packets" << std::endl;
     }
 }
 
@@ -162,8 +194,8 @@ UncoalescedTable::checkDeadlock(Tick threshold)
 {
     Tick current_time = curTick();
 
-    for (auto &it : instMap) {
-        for (auto &pkt : it.second) {
+    for (auto &inst : insts) {
+        for (auto &pkt : inst.pkts) {
             if (current_time - pkt->req->time() > threshold) {
                 std::stringstream ss;
                 printRequestTable(ss);
@@ -172,7 +204,7 @@ UncoalescedTable::checkDeadlock(Tick threshold)
                      "version: %d request.paddr: 0x%x uncoalescedTable: %d "
                      "current time: %u issue_time: %d difference: %d\n"
                      "Request Tables:\n\n%s", coalescer->getId(),
-                      pkt->getAddr(), instMap.size(), current_time,
+                      pkt->getAddr(), insts.size(), current_time,
                       pkt->req->time(), current_time - pkt->req->time(),
                       ss.str());
             }
@@ -185,9 +217,15 @@ GPUCoalescer::GPUCoalescer(const Params &p)
       issueEvent([this]{ completeIssue(); }, "Issue coalesced request",
                  false, Event::Progress_Event_Pri),
       uncoalescedTable(this),
+      coalescedTable(p.max_outstanding_requests),
+      traceRecorder(nullptr),
       deadlockCheckEvent([this]{ wakeup(); }, "GPUCoalescer deadlock check"),
       gmTokenPort(name() + ".gmTokenPort", this)
 {
+    // Sized for the instruction being coalesced, which can create at most
+    // one request per lane
+    coalescedReqs.reserve(TheGpuISA::NumVecElemPerVecReg);
+
     m_store_waiting_on_load_cycles = 0;
     m_store_waiting_on_store_cycles = 0;
     m_load_waiting_on_store_cycles = 0;
@@ -213,6 +251,23 @@ GPUCoalescer::GPUCoalescer(const Params &p)
 
     m_runningGarnetStandalone = p.garnet_standalone;
 
+    if (!p.trace_file.empty()) {
+#if HAVE_PROTOBUF
+        fatal_if(m_usingRubyTester, "%s: GPU memory traces can only be "
+                 "recorded from a compute unit\n", name());
+        traceRecorder = new GPUMemTraceRecorder(
+            simout.resolve(p.trace_file), name(),
+            RubySystem::getBlockSizeBytes());
+        // The trace must be flushed to the file before gem5 exits
+        registerExitCallback([this]() {
+            delete traceRecorder;
+            traceRecorder = nullptr;
+        });
+#else
+        fatal("%s: recording a GPU memory trace requires protobuf\n",
+              name());
+#endif
+    }
 
     // These statistical variables are not for display.
     // The profiler will collate these across different
@@ -276,17 +331,15 @@ void
 GPUCoalescer::wakeup()
 {
     Cycles current_time = curCycle();
-    for (auto& requestList : coalescedTable) {
-        for (auto& req : requestList.second) {
-            if (current_time - req->getIssueTime() > m_deadlock_threshold) {
-                std::stringstream ss;
-                printRequestTable(ss);
-                warn("GPUCoalescer %d Possible deadlock detected!\n%s\n",
-                     m_version, ss.str());
-                panic("Aborting due to deadlock!\n");
-            }
+    coalescedTable.forEach([&](Addr line, const CoalescedRequest &req) {
+        if (current_time - req.getIssueTime() > m_deadlock_threshold) {
+            std::stringstream ss;
+            printRequestTable(ss);
+            warn("GPUCoalescer %d Possible deadlock detected!\n%s\n",
+                 m_version, ss.str());
+            panic("Aborting due to deadlock!\n");
         }
-    }
+    });
 
     Tick tick_threshold = cyclesToTicks(m_deadlock_threshold);
     uncoalescedTable.checkDeadlock(tick_threshold);
@@ -304,21 +357,19 @@ GPUCoalescer::printRequestTable(std::stringstream& ss)
     ss << "Printing out " << coalescedTable.size()
        << " outstanding requests in the coalesced table\n";
 
-    for (auto& requestList : coalescedTable) {
-        for (auto& request : requestList.second) {
-            ss << "\tAddr: " << printAddress(requestList.first) << "\n"
-               << "\tInstruction sequence number: "
-               << request->getSeqNum() << "\n"
-               << "\t\tType: "
-               << RubyRequestType_to_string(request->getRubyType()) << "\n"
-               << "\t\tNumber of associated packets: "
-               << request->getPackets().size() << "\n"
-               << "\t\tIssue time: "
-               << request->getIssueTime() * clockPeriod() << "\n"
-               << "\t\tDifference from current tick: "
-               << (curCycle() - request->getIssueTime()) * clockPeriod();
-        }
-    }
+    coalescedTable.forEach([&](Addr line, CoalescedRequest &request) {
+        ss << "\tAddr: " << printAddress(line) << "\n"
+           << "\tInstruction sequence number: "
+           << request.getSeqNum() << "\n"
+           << "\t\tType: "
+           << RubyRequestType_to_string(request.getRubyType()) << "\n"
+           << "\t\tNumber of associated packets: "
+           << request.getPackets().size() << "\n"
+           << "\t\tIssue time: "
+           << request.getIssueTime() * clockPeriod() << "\n"
+           << "\t\tDifference from current tick: "
+           << (curCycle() - request.getIssueTime()) * clockPeriod();
+    });
 
     // print out packets waiting to be issued in uncoalesced table
     uncoalescedTable.printRequestTable(ss);
@@ -406,19 +457,15 @@ GPUCoalescer::writeCallback(Addr address,
     assert(address == makeLineAddress(address));
     assert(coalescedTable.count(address));
 
-    auto crequest = coalescedTable.at(address).front();
+    auto crequest = coalescedTable.front(address);
 
     hitCallback(crequest, mach, data, true, crequest->getIssueTime(),
                 forwardRequestTime, firstResponseTime, isRegion);
 
     // remove this crequest in coalescedTable
-    delete crequest;
-    coalescedTable.at(address).pop_front();
+    coalescedTable.popFront(address);
 
-    if (coalescedTable.at(address).empty()) {
-        coalescedTable.erase(address);
-    } else {
-        auto nextRequest = coalescedTable.at(address).front();
+    if (auto nextRequest = coalescedTable.front(address)) {
         issueRequest(nextRequest);
     }
 }
@@ -493,30 +540,22 @@ GPUCoalescer::readCallback(Addr address,
     assert(address == makeLineAddress(address));
     assert(coalescedTable.count(address));
 
-    auto crequest = coalescedTable.at(address).front();
+    auto crequest = coalescedTable.front(address);
     fatal_if(crequest->getRubyType() != RubyRequestType_LD,
              "readCallback received non-read type response\n");
 
     // Iterate over the coalesced requests to respond to as many loads as
     // possible until another request type is seen. Models MSHR for TCP.
-    while (crequest->getRubyType() == RubyRequestType_LD) {
+    while (crequest && crequest->getRubyType() == RubyRequestType_LD) {
         hitCallback(crequest, mach, data, true, crequest->getIssueTime(),
                     forwardRequestTime, firstResponseTime, isRegion);
 
-        delete crequest;
-        coalescedTable.at(address).pop_front();
-        if (coalescedTable.at(address).empty()) {
-            break;
-        }
-
-        crequest = coalescedTable.at(address).front();
+        coalescedTable.popFront(address);
+        crequest = coalescedTable.front(address);
     }
 
-    if (coalescedTable.at(address).empty()) {
-        coalescedTable.erase(address);
-    } else {
-        auto nextRequest = coalescedTable.at(address).front();
-        issueRequest(nextRequest);
+    if (crequest) {
+        issueRequest(crequest);
     }
 }
 
@@ -546,7 +585,10 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
     // update the data
     //
     // MUST AD DOING THIS FOR EACH REQUEST IN COALESCER
-    std::vector<PacketPtr> pktList = crequest->getPackets();
+    //
+    // The request stays in the coalescedTable until the caller removes it,
+    // so its packet list can be used without copying it
+    std::vector<PacketPtr> &pktList = crequest->getPackets();
     DPRINTF(GPUCoalescer, "Responding to %d packets for addr 0x%X\n",
             pktList.size(), request_line_address);
     for (auto& pkt : pktList) {
@@ -576,6 +618,14 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
     m_outstanding_count--;
     assert(m_outstanding_count >= 0);
 
+#if HAVE_PROTOBUF
+    if (traceRecorder) {
+        InstSeqNum seq_num = crequest->getSeqNum();
+        traceRecorder->requestDone(crequest,
+                                   uncoalescedTable.areRequestsDone(seq_num));
+    }
+#endif
+
     completeHitCallback(pktList);
 }
 
@@ -626,6 +676,23 @@ GPUCoalescer::makeRequest(PacketPtr pkt)
     // all packets must have valid instruction sequence numbers
     assert(pkt->req->hasInstSeqNum());
 
+#if HAVE_PROTOBUF
+    if (traceRecorder) {
+        GPUDynInstPtr gpuDynInst = getDynInst(pkt);
+        // Only the sync ops injected at kernel boundaries, which do not
+        // belong to a wavefront, carry a valid queue id
+        int queue_id = gpuDynInst->wfDynId < 0 ? gpuDynInst->queue_id : -1;
+        if (pkt->cmd == MemCmd::MemSyncReq) {
+            traceRecorder->syncIssued(pkt, gpuDynInst->wfDynId,
+                                      gpuDynInst->kern_id, queue_id);
+        } else {
+            traceRecorder->instIssued(pkt->req->getReqInstSeqNum(),
+                                      gpuDynInst->wfDynId,
+                                      gpuDynInst->kern_id, queue_id);
+        }
+    }
+#endif
+
     if (pkt->cmd == MemCmd::MemSyncReq) {
         // issue mem_sync requests immediately to the cache system without
         // going through uncoalescedTable like normal LD/ST/Atomic requests
@@ -713,16 +780,13 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
 
     // If the packet has the same line address as a request already in the
     // coalescedTable and has the same sequence number, it can be coalesced.
-    if (coalescedTable.count(line_addr)) {
-        // Search for a previous coalesced request with the same seqNum.
-        auto& creqQueue = coalescedTable.at(line_addr);
-        auto citer = std::find_if(creqQueue.begin(), creqQueue.end(),
-            [&](CoalescedRequest* c) { return c->getSeqNum() == seqNum; }
-        );
-        if (citer != creqQueue.end()) {
-            (*citer)->insertPacket(pkt);
-            return true;
-        }
+    // Search for a previous coalesced request with the same seqNum.
+    CoalescedRequest *prev_creq = coalescedTable.findIf(line_addr,
+        [&](const CoalescedRequest &c) { return c.getSeqNum() == seqNum; }
+    );
+    if (prev_creq) {
+        prev_creq->insertPacket(pkt);
+        return true;
     }
 
     if (m_outstanding_count < m_max_outstanding_requests) {
@@ -731,26 +795,28 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
         DPRINTF(GPUCoalescer, "Creating new or aliased request for 0x%X\n",
                 line_addr);
 
-        CoalescedRequest *creq = new CoalescedRequest(seqNum);
+        bool line_outstanding = coalescedTable.count(line_addr);
+
+        CoalescedRequest *creq = &coalescedTable.push(line_addr);
+        creq->reset(seqNum);
         creq->insertPacket(pkt);
         creq->setRubyType(getRequestType(pkt));
         creq->setIssueTime(curCycle());
 
-        if (!coalescedTable.count(line_addr)) {
+#if HAVE_PROTOBUF
+        if (traceRecorder)
+            traceRecorder->requestCreated(seqNum);
+#endif
+
+        if (!line_outstanding) {
             // If there is no outstanding request for this line address,
-            // create a new coalecsed request and issue it immediately.
-            auto reqList = std::deque<CoalescedRequest*> { creq };
-            coalescedTable.insert(std::make_pair(line_addr, reqList));
-            if (!coalescedReqs.count(seqNum)) {
-                coalescedReqs.insert(std::make_pair(seqNum, reqList));
-            } else {
-                coalescedReqs.at(seqNum).push_back(creq);
-            }
+            // the new coalesced request is issued once the instruction has
+            // been coalesced.
+            coalescedReqs.push_back(creq);
         } else {
             // The request is for a line address that is already outstanding
-            // but for a different instruction. Add it as a new request to be
-            // issued when the current outstanding request is completed.
-            coalescedTable.at(line_addr).push_back(creq);
+            // but for a different instruction. It was added as a new request
+            // to be issued when the current outstanding request is completed.
             DPRINTF(GPUCoalescer, "found address 0x%X with new seqNum %d\n",
                     line_addr, seqNum);
         }
@@ -829,20 +895,17 @@ GPUCoalescer::completeIssue()
             // erase them from the list if coalescing is successful and
             // leave them in the list otherwise. This aggressively attempts
             // to coalesce as many packets as possible from the current inst.
-            pkt_list->remove_if(
-                [&](PacketPtr pkt) { return coalescePacket(pkt); }
-            );
-
-            if (coalescedReqs.count(seq_num)) {
-                auto& creqs = coalescedReqs.at(seq_num);
-                for (auto creq : creqs) {
-                    DPRINTF(GPUCoalescer, "Issued req type %s seqNum %d\n",
-                            RubyRequestType_to_string(creq->getRubyType()),
-                                                      seq_num);
-                    issueRequest(creq);
-                }
-                coalescedReqs.erase(seq_num);
+            pkt_list->erase(std::remove_if(pkt_list->begin(), pkt_list->end(),
+                [&](PacketPtr pkt) { return coalescePacket(pkt); }),
+                pkt_list->end());
+
+            for (auto creq : coalescedReqs) {
+                DPRINTF(GPUCoalescer, "Issued req type %s seqNum %d\n",
+                        RubyRequestType_to_string(creq->getRubyType()),
+                                                  seq_num);
+                issueRequest(creq);
             }
+            coalescedReqs.clear();
 
             assert(pkt_list_size >= pkt_list->size());
             size_t pkt_list_diff = pkt_list_size - pkt_list->size();
@@ -894,7 +957,7 @@ GPUCoalescer::atomicCallback(Addr address,
     assert(address == makeLineAddress(address));
     assert(coalescedTable.count(address));
 
-    auto crequest = coalescedTable.at(address).front();
+    auto crequest = coalescedTable.front(address);
 
     fatal_if((crequest->getRubyType() != RubyRequestType_ATOMIC &&
               crequest->getRubyType() != RubyRequestType_ATOMIC_RETURN &&
@@ -904,13 +967,9 @@ GPUCoalescer::atomicCallback(Addr address,
     hitCallback(crequest, mach, (DataBlock&)data, true,
                 crequest->getIssueTime(), Cycles(0), Cycles(0), false);
 
-    delete crequest;
-    coalescedTable.at(address).pop_front();
+    coalescedTable.popFront(address);
 
-    if (coalescedTable.at(address).empty()) {
-        coalescedTable.erase(address);
-    } else {
-        auto nextRequest = coalescedTable.at(address).front();
+    if (auto nextRequest = coalescedTable.front(address)) {
         issueRequest(nextRequest);
     }
 }
@@ -919,6 +978,11 @@ void
 GPUCoalescer::completeHitCallback(std::vector<PacketPtr> & mylist)
 {
     for (auto& pkt : mylist) {
+#if HAVE_PROTOBUF
+        if (traceRecorder && pkt->cmd == MemCmd::MemSyncReq)
+            traceRecorder->syncDone(pkt);
+#endif
+
         RubyPort::SenderState *ss =
             safe_cast<RubyPort::SenderState *>(pkt->senderState);
         MemResponsePort *port = ss->port;
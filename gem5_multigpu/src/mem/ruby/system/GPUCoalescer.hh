@@ -36,6 +36,7 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "gpu-compute/gpu_dyn_inst.hh"
@@ -47,6 +48,7 @@
 #include "mem/ruby/protocol/RubyAccessMode.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 #include "mem/ruby/protocol/SequencerRequestType.hh"
+#include "mem/ruby/system/RequestTable.hh"
 #include "mem/ruby/system/Sequencer.hh"
 #include "mem/token_port.hh"
 
@@ -54,11 +56,12 @@ class DataBlock;
 class CacheMsg;
 class MachineID;
 class CacheMemory;
+class GPUMemTraceRecorder;
 
 class RubyGPUCoalescerParams;
 
 // List of packets that belongs to a specific instruction.
-typedef std::list<PacketPtr> PerInstPackets;
+typedef std::vector<PacketPtr> PerInstPackets;
 
 class UncoalescedTable
 {
@@ -88,26 +91,51 @@ class UncoalescedTable
     void checkDeadlock(Tick threshold);
 
   private:
+    struct InstPackets
+    {
+        InstSeqNum seqNum;
+        // Packets the instruction has yet to coalesce, or -1 until
+        // initPacketsRemaining is called
+        int pktsRemaining;
+        PerInstPackets pkts;
+    };
+
+    InstPackets *findInst(InstSeqNum seqNum);
+
     GPUCoalescer *coalescer;
 
-    // Maps an instructions unique sequence number to a queue of packets
-    // which need responses. This data structure assumes the sequence number
-    // is monotonically increasing (which is true for CU class) in order to
-    // issue packets in age order.
-    std::map<InstSeqNum, PerInstPackets> instMap;
+    // The instructions with packets which need responses, sorted by their
+    // unique sequence numbers in order to issue packets in age order. The
+    // sequence number is monotonically increasing (which is true for CU
+    // class), so new instructions go at the back. There is at most one
+    // instruction per coalescer token.
+    std::vector<InstPackets> insts;
 
-    std::map<InstSeqNum, int> instPktsRemaining;
+    // Packet lists of the instructions that have been removed, which are
+    // reused for new instructions so that they keep their capacity
+    std::vector<PerInstPackets> freePktLists;
 };
 
 class CoalescedRequest
 {
   public:
-    CoalescedRequest(uint64_t _seqNum)
+    CoalescedRequest(uint64_t _seqNum = 0)
         : seqNum(_seqNum), issueTime(Cycles(0)),
           rubyType(RubyRequestType_NULL)
     {}
     ~CoalescedRequest() {}
 
+    // Reuse the request for another instruction. The packet list keeps
+    // its capacity.
+    void
+    reset(uint64_t _seqNum)
+    {
+        seqNum = _seqNum;
+        issueTime = Cycles(0);
+        rubyType = RubyRequestType_NULL;
+        pkts.clear();
+    }
+
     void insertPacket(PacketPtr pkt) { pkts.push_back(pkt); }
     void setSeqNum(uint64_t _seqNum) { seqNum = _seqNum; }
     void setIssueTime(Cycles _issueTime) { issueTime = _issueTime; }
@@ -324,6 +352,10 @@ class GPUCoalescer : public RubyPort
 
     bool empty() const;
 
+    // Whether a request to a line is waiting to be issued or to complete
+    bool isLinePending(Addr line) const
+    { return coalescedTable.count(line) > 0; }
+
     void print(std::ostream& out) const;
 
     void evictionCallback(Addr address);
@@ -427,18 +459,24 @@ class GPUCoalescer : public RubyPort
     // this table may or may not be outstanding in the memory hierarchy. The
     // maximum size is equal to the maximum outstanding requests for a CU
     // (typically the number of blocks in TCP). If there are duplicates of
-    // an address, the are serviced in age order.
-    std::map<Addr, std::deque<CoalescedRequest*>> coalescedTable;
-    // Map of instruction sequence number to coalesced requests that get
-    // created in coalescePacket, used in completeIssue to send the fully
-    // coalesced request
-    std::unordered_map<uint64_t, std::deque<CoalescedRequest*>> coalescedReqs;
+    // an address, the are serviced in age order. The requests are
+    // recycled, so the table doesn't allocate once it has reached its
+    // maximum size.
+    RequestTable<CoalescedRequest> coalescedTable;
+    // The coalesced requests for new lines that get created in
+    // coalescePacket for the instruction being coalesced, used in
+    // completeIssue to send the fully coalesced requests
+    std::vector<CoalescedRequest*> coalescedReqs;
 
     // a map btw an instruction sequence number and PendingWriteInst
     // this is used to do a final call back for each write when it is
     // completely done in the memory system
     std::unordered_map<uint64_t, PendingWriteInst> pendingWriteInsts;
 
+    // Records the coalesced requests into a trace for replay with
+    // GPUMemTracePlayer, nullptr unless a trace file is configured
+    GPUMemTraceRecorder *traceRecorder;
+
     // Global outstanding request count, across all request tables
     int m_outstanding_count;
     bool m_deadlock_check_scheduled;
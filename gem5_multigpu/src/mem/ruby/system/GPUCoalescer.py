@@ -52,5 +52,7 @@ class RubyGPUCoalescer(RubyPort):
        "max outstanding cycles for a request before " \
        "deadlock/livelock declared")
    garnet_standalone = Param.Bool(False, "")
+   trace_file = Param.String("", "Record the coalesced requests into " \
+                             "this trace file (requires protobuf)")
 
    gmTokenPort = ResponsePort("Port to the CU for sharing tokens")
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/system/GPUMemTraceRecorder.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "mem/ruby/common/Address.hh"
+#include "mem/ruby/system/GPUCoalescer.hh"
+#include "proto/gpu_mem_trace.pb.h"
+#include "sim/core.hh"
+
+GPUMemTraceRecorder::GPUMemTraceRecorder(const std::string &filename,
+                                         const std::string &obj_id,
+                                         unsigned block_size)
+    : traceStream(new ProtoOutputStream(filename)), blockSize(block_size),
+      startTick(0), started(false), hasBoundarySync(false),
+      boundarySyncDone(false), boundarySync(0), boundarySyncDoneTick(0)
+{
+    ProtoMessage::GPUMemTraceHeader header_msg;
+    header_msg.set_obj_id(obj_id);
+    header_msg.set_tick_freq(SimClock::Frequency);
+    header_msg.set_block_size(blockSize);
+    traceStream->write(header_msg);
+}
+
+GPUMemTraceRecorder::~GPUMemTraceRecorder()
+{
+    // Deleting the stream flushes it and closes the file
+    delete traceStream;
+}
+
+GPUMemTraceRecorder::InstInfo &
+GPUMemTraceRecorder::newInst(InstSeqNum seq_num, int wave_id, int kernel_id,
+                             int queue_id)
+{
+    if (!started) {
+        startTick = curTick();
+        started = true;
+    }
+
+    auto wave_it = waves.find(wave_id);
+    bool new_wave = wave_it == waves.end();
+    if (new_wave) {
+        wave_it = waves.emplace(wave_id,
+            WaveInfo{startTick, false, 0, 0}).first;
+    }
+    WaveInfo &wave = wave_it->second;
+
+    InstInfo &inst = insts[seq_num];
+    inst.waveId = wave_id;
+    inst.kernelId = kernel_id;
+    inst.queueId = queue_id;
+    inst.hasDep = wave.hasCompleted;
+    inst.depSeqNum = wave.youngestDone;
+    inst.outstanding = 0;
+
+    // The instruction could have issued once the previous instruction
+    // of the wavefront issued and its dependency completed
+    Tick ready = wave.lastIssue;
+    if (wave.hasCompleted)
+        ready = std::max(ready, wave.youngestDoneTick);
+
+    // and, across wavefronts, once the kernel boundary before it was done
+    inst.waveDeps.clear();
+    if (wave_id < 0) {
+        for (int active_id : activeWaves) {
+            const WaveInfo &active = waves[active_id];
+            if (!active.hasCompleted)
+                continue;
+            inst.waveDeps.push_back(active.youngestDone);
+            ready = std::max(ready, active.youngestDoneTick);
+        }
+        activeWaves.clear();
+        hasBoundarySync = true;
+        boundarySyncDone = false;
+        boundarySync = seq_num;
+    } else {
+        if (new_wave && hasBoundarySync && boundarySyncDone) {
+            inst.waveDeps.push_back(boundarySync);
+            ready = std::max(ready, boundarySyncDoneTick);
+        }
+        activeWaves.insert(wave_id);
+    }
+    inst.delay = curTick() - ready;
+    wave.lastIssue = curTick();
+
+    return inst;
+}
+
+void
+GPUMemTraceRecorder::instIssued(InstSeqNum seq_num, int wave_id,
+                                int kernel_id, int queue_id)
+{
+    if (insts.count(seq_num))
+        return;
+
+    newInst(seq_num, wave_id, kernel_id, queue_id);
+}
+
+void
+GPUMemTraceRecorder::syncIssued(PacketPtr pkt, int wave_id, int kernel_id,
+                                int queue_id)
+{
+    // A kernel launch may invalidate both the L1 and the L2 with the same
+    // sequence number, in which case both belong to the same instruction
+    InstSeqNum seq_num = pkt->req->getReqInstSeqNum();
+    auto inst_it = insts.find(seq_num);
+    InstInfo &inst = inst_it != insts.end() ? inst_it->second :
+        newInst(seq_num, wave_id, kernel_id, queue_id);
+    inst.outstanding++;
+
+    ProtoMessage::GPUMemRecord record;
+    record.set_seq_num(seq_num);
+    record.set_wave_id(wave_id);
+    record.set_kernel_id(kernel_id);
+    if (pkt->req->isInvL1()) {
+        record.set_type(ProtoMessage::GPUMemRecord::INV_L1);
+    } else if (pkt->req->isWbL1()) {
+        record.set_type(ProtoMessage::GPUMemRecord::WB_L1);
+    } else if (pkt->req->isGL2CacheInv()) {
+        record.set_type(ProtoMessage::GPUMemRecord::INV_L2);
+    } else {
+        record.set_type(ProtoMessage::GPUMemRecord::FLUSH_L2);
+    }
+    if (inst.hasDep)
+        record.set_dep_seq_num(inst.depSeqNum);
+    for (auto dep : inst.waveDeps)
+        record.add_wave_dep_seq_nums(dep);
+    record.set_delay(inst.delay);
+    record.set_queue_id(queue_id);
+    traceStream->write(record);
+}
+
+void
+GPUMemTraceRecorder::requestCreated(InstSeqNum seq_num)
+{
+    assert(insts.count(seq_num));
+    insts[seq_num].outstanding++;
+}
+
+void
+GPUMemTraceRecorder::requestDone(CoalescedRequest *crequest,
+                                 bool all_coalesced)
+{
+    InstSeqNum seq_num = crequest->getSeqNum();
+    assert(insts.count(seq_num));
+    InstInfo &inst = insts[seq_num];
+
+    PacketPtr first_pkt = crequest->getFirstPkt();
+    Addr line_addr = makeLineAddress(first_pkt->getAddr());
+
+    // One bit per byte of the line
+    std::string mask((blockSize + 7) / 8, 0);
+    for (auto pkt : crequest->getPackets()) {
+        Addr offset = pkt->getAddr() - line_addr;
+        for (unsigned i = 0; i < pkt->getSize(); i++)
+            mask[(offset + i) / 8] |= 1 << ((offset + i) % 8);
+    }
+
+    ProtoMessage::GPUMemRecord record;
+    record.set_seq_num(seq_num);
+    record.set_wave_id(inst.waveId);
+    record.set_kernel_id(inst.kernelId);
+    switch (crequest->getRubyType()) {
+      case RubyRequestType_LD:
+        record.set_type(ProtoMessage::GPUMemRecord::LOAD);
+        break;
+      case RubyRequestType_ST:
+        record.set_type(ProtoMessage::GPUMemRecord::STORE);
+        break;
+      case RubyRequestType_ATOMIC:
+      case RubyRequestType_ATOMIC_RETURN:
+        record.set_type(ProtoMessage::GPUMemRecord::ATOMIC);
+        break;
+      case RubyRequestType_ATOMIC_NO_RETURN:
+        record.set_type(ProtoMessage::GPUMemRecord::ATOMIC_NO_RETURN);
+        break;
+      default:
+        panic("Unexpected coalesced request type %s\n",
+              RubyRequestType_to_string(crequest->getRubyType()));
+    }
+    record.set_addr(line_addr);
+    record.set_mask(mask);
+    record.set_home_node(first_pkt->req->getHomeNode(line_addr));
+    record.set_slc(first_pkt->req->isSLC());
+    if (inst.hasDep)
+        record.set_dep_seq_num(inst.depSeqNum);
+    for (auto dep : inst.waveDeps)
+        record.add_wave_dep_seq_nums(dep);
+    record.set_delay(inst.delay);
+    traceStream->write(record);
+
+    assert(inst.outstanding > 0);
+    inst.outstanding--;
+    if (inst.outstanding == 0 && all_coalesced)
+        instDone(seq_num);
+}
+
+void
+GPUMemTraceRecorder::syncDone(PacketPtr pkt)
+{
+    InstSeqNum seq_num = pkt->req->getReqInstSeqNum();
+    if (!insts.count(seq_num))
+        return;
+
+    InstInfo &inst = insts[seq_num];
+    assert(inst.outstanding > 0);
+    inst.outstanding--;
+    if (inst.outstanding == 0)
+        instDone(seq_num);
+}
+
+void
+GPUMemTraceRecorder::instDone(InstSeqNum seq_num)
+{
+    int wave_id = insts[seq_num].waveId;
+    WaveInfo &wave = waves[wave_id];
+    if (!wave.hasCompleted || seq_num > wave.youngestDone) {
+        wave.hasCompleted = true;
+        wave.youngestDone = seq_num;
+        wave.youngestDoneTick = curTick();
+    }
+    if (wave_id < 0 && hasBoundarySync && seq_num == boundarySync) {
+        boundarySyncDone = true;
+        boundarySyncDoneTick = curTick();
+    }
+    insts.erase(seq_num);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_SYSTEM_GPUMEMTRACERECORDER_HH__
+#define __MEM_RUBY_SYSTEM_GPUMEMTRACERECORDER_HH__
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "proto/protoio.hh"
+
+class CoalescedRequest;
+
+/**
+ * Records the coalesced requests and memory sync ops that a GPU
+ * coalescer sees into a trace, so that the memory system can be
+ * re-simulated with GPUMemTracePlayer without the CU pipeline.
+ *
+ * Besides the requests themselves, the recorder tracks when the
+ * instructions of each wavefront issue and complete. Every instruction
+ * records the youngest instruction of its wavefront that had completed
+ * when it was issued, and the time it issued after that. The player uses
+ * these to replay the trace closed-loop, so that a faster or slower
+ * memory system speeds up or slows down the wavefronts.
+ *
+ * The sync ops injected at kernel boundaries have no wavefront (-1) and
+ * order the wavefronts around them: the first instruction of a wavefront
+ * depends on the last boundary sync op, and a boundary sync op depends
+ * on the youngest completed instruction of each wavefront that issued
+ * since the previous one.
+ */
+class GPUMemTraceRecorder
+{
+  public:
+    GPUMemTraceRecorder(const std::string &filename,
+                        const std::string &obj_id, unsigned block_size);
+    ~GPUMemTraceRecorder();
+
+    /**
+     * A packet of a vector memory instruction reached the coalescer. Only
+     * the first packet of an instruction is recorded.
+     */
+    void instIssued(InstSeqNum seq_num, int wave_id, int kernel_id,
+                    int queue_id);
+
+    /** A memory sync op reached the coalescer */
+    void syncIssued(PacketPtr pkt, int wave_id, int kernel_id,
+                    int queue_id);
+
+    /** A coalesced request was created for an instruction */
+    void requestCreated(InstSeqNum seq_num);
+
+    /**
+     * A coalesced request completed. all_coalesced is false if the
+     * instruction still has packets waiting to be coalesced.
+     */
+    void requestDone(CoalescedRequest *crequest, bool all_coalesced);
+
+    /** A memory sync op completed */
+    void syncDone(PacketPtr pkt);
+
+  private:
+    struct InstInfo
+    {
+        int waveId;
+        int kernelId;
+        int queueId;
+        bool hasDep;
+        InstSeqNum depSeqNum;
+        // Instructions of other wavefronts this one depends on
+        std::vector<InstSeqNum> waveDeps;
+        Tick delay;
+        // Coalesced requests that have been created but not completed
+        int outstanding;
+    };
+
+    struct WaveInfo
+    {
+        Tick lastIssue;
+        bool hasCompleted;
+        InstSeqNum youngestDone;
+        Tick youngestDoneTick;
+    };
+
+    /** Set up the timing and dependency of a new instruction */
+    InstInfo &newInst(InstSeqNum seq_num, int wave_id, int kernel_id,
+                      int queue_id);
+    void instDone(InstSeqNum seq_num);
+
+    ProtoOutputStream *traceStream;
+    const unsigned blockSize;
+    // Time of the first recorded instruction. Wavefronts that have not
+    // issued anything yet are considered ready from this point on
+    Tick startTick;
+    bool started;
+
+    std::unordered_map<InstSeqNum, InstInfo> insts;
+    std::unordered_map<int, WaveInfo> waves;
+
+    // The last kernel-boundary sync op, and when it completed
+    bool hasBoundarySync;
+    bool boundarySyncDone;
+    InstSeqNum boundarySync;
+    Tick boundarySyncDoneTick;
+    // Wavefronts that issued since the last kernel-boundary sync op
+    std::unordered_set<int> activeWaves;
+};
+
+#endif // __MEM_RUBY_SYSTEM_GPUMEMTRACERECORDER_HH__
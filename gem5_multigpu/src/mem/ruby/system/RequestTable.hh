@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_SYSTEM_REQUESTTABLE_HH__
+#define __MEM_RUBY_SYSTEM_REQUESTTABLE_HH__
+
+#include <cassert>
+#include <deque>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "mem/ruby/common/Address.hh"
+
+/**
+ * The outstanding requests of a sequencer or a coalescer, by line
+ * address. The requests to a line are kept in the order they were added.
+ *
+ * The lines are kept in an open-addressed hash table, and the requests
+ * in a pool of records that are linked into a list per line and
+ * recycled through a free list. Both are sized for the maximum number of
+ * outstanding requests up front, so adding and removing requests does
+ * not allocate as long as that number holds; beyond it they grow.
+ *
+ * A record is not reconstructed when it is recycled, the caller
+ * reinitializes the request it gets from push(), so a request can keep
+ * its own buffers from one use to the next. Records never move, so a
+ * reference to a request stays valid until the request is popped, even
+ * if other requests are pushed in the meantime.
+ */
+template<class Request>
+class RequestTable
+{
+  public:
+    RequestTable(int max_requests);
+
+    /** Add a request to the back of a line's list */
+    Request &push(Addr line);
+    /** Remove the request at the front of a line's list */
+    void popFront(Addr line);
+
+    /** Get the oldest request to a line, or nullptr if there is none */
+    Request *front(Addr line);
+    /** Get the oldest request to a line that satisfies a predicate */
+    template<class Pred>
+    Request *findIf(Addr line, Pred pred);
+
+    /** Number of requests to a line */
+    int count(Addr line) const;
+
+    bool empty() const { return m_num_requests == 0; }
+    int size() const { return m_num_requests; }
+    int numLines() const { return m_num_lines; }
+
+    /**
+     * Call a function on every request, as f(line, request). The lines
+     * are visited in no particular order, the requests of a line oldest
+     * first.
+     */
+    template<class Func>
+    void forEach(Func f);
+    template<class Func>
+    void forEach(Func f) const;
+
+  private:
+    struct Record
+    {
+        Request request;
+        int next;
+    };
+
+    // A line with no requests is an empty slot
+    struct Slot
+    {
+        Addr line;
+        int head;
+        int tail;
+        int count;
+    };
+
+    size_t
+    home(Addr line) const
+    {
+        // Fibonacci hashing, which takes the index from the top bits of
+        // the product so that the zero low bits of a line don't matter
+        return (line * 0x9e3779b97f4a7c15ULL) >> m_hash_shift;
+    }
+
+    // Find the slot of a line, or the empty slot it would go in
+    size_t probe(Addr line) const;
+    void removeSlot(size_t idx);
+    void resizeSlots(size_t num_slots);
+
+    std::deque<Record> m_records;
+    int m_free_list;
+
+    std::vector<Slot> m_slots;
+    int m_hash_shift;
+
+    int m_num_lines;
+    int m_num_requests;
+};
+
+template<class Request>
+inline
+RequestTable<Request>::RequestTable(int max_requests)
+    : m_free_list(-1), m_hash_shift(0), m_num_lines(0), m_num_requests(0)
+{
+    assert(max_requests > 0);
+    m_records.resize(max_requests);
+    for (int i = max_requests - 1; i >= 0; --i) {
+        m_records[i].next = m_free_list;
+        m_free_list = i;
+    }
+
+    // Keep the load factor of the slots at most one half
+    resizeSlots(size_t(1) << ceilLog2(2 * max_requests));
+}
+
+template<class Request>
+inline Request &
+RequestTable<Request>::push(Addr line)
+{
+    if (2 * size_t(m_num_lines + 1) > m_slots.size())
+        resizeSlots(2 * m_slots.size());
+
+    int idx = m_free_list;
+    if (idx >= 0) {
+        m_free_list = m_records[idx].next;
+    } else {
+        idx = m_records.size();
+        m_records.emplace_back();
+    }
+    m_records[idx].next = -1;
+
+    Slot &slot = m_slots[probe(line)];
+    if (slot.count == 0) {
+        slot.line = line;
+        slot.head = idx;
+        ++m_num_lines;
+    } else {
+        m_records[slot.tail].next = idx;
+    }
+    slot.tail = idx;
+    ++slot.count;
+    ++m_num_requests;
+
+    return m_records[idx].request;
+}
+
+template<class Request>
+inline void
+RequestTable<Request>::popFront(Addr line)
+{
+    size_t slot_idx = probe(line);
+    Slot &slot = m_slots[slot_idx];
+    assert(slot.count > 0);
+
+    int idx = slot.head;
+    slot.head = m_records[idx].next;
+    m_records[idx].next = m_free_list;
+    m_free_list = idx;
+    --m_num_requests;
+
+    if (--slot.count == 0) {
+        removeSlot(slot_idx);
+        --m_num_lines;
+    }
+}
+
+template<class Request>
+inline Request *
+RequestTable<Request>::front(Addr line)
+{
+    const Slot &slot = m_slots[probe(line)];
+    return slot.count ? &m_records[slot.head].request : nullptr;
+}
+
+template<class Request>
+template<class Pred>
+inline Request *
+RequestTable<Request>::findIf(Addr line, Pred pred)
+{
+    const Slot &slot = m_slots[probe(line)];
+    for (int idx = slot.count ? slot.head : -1; idx >= 0;
+         idx = m_records[idx].next) {
+        if (pred(m_records[idx].request))
+            return &m_records[idx].request;
+    }
+    return nullptr;
+}
+
+template<class Request>
+inline int
+RequestTable<Request>::count(Addr line) const
+{
+    return m_slots[probe(line)].count;
+}
+
+template<class Request>
+template<class Func>
+inline void
+RequestTable<Request>::forEach(Func f)
+{
+    for (const Slot &slot : m_slots) {
+        for (int idx = slot.count ? slot.head : -1; idx >= 0;
+             idx = m_records[idx].next) {
+            f(slot.line, m_records[idx].request);
+        }
+    }
+}
+
+template<class Request>
+template<class Func>
+inline void
+RequestTable<Request>::forEach(Func f) const
+{
+    for (const Slot &slot : m_slots) {
+        for (int idx = slot.count ? slot.head : -1; idx >= 0;
+             idx = m_records[idx].next) {
+            f(slot.line, (const Request &)m_records[idx].request);
+        }
+    }
+}
+
+template<class Request>
+inline size_t
+RequestTable<Request>::probe(Addr line) const
+{
+    const size_t mask = m_slots.size() - 1;
+    size_t idx = home(line);
+    while (m_slots[idx].count && m_slots[idx].line != line)
+        idx = (idx + 1) & mask;
+    return idx;
+}
+
+template<class Request>
+inline void
+RequestTable<Request>::removeSlot(size_t idx)
+{
+    // Shift back the slots after the removed one that are not at their
+    // home, so that no probe for them runs into an empty slot
+    const size_t mask = m_slots.size() - 1;
+    size_t next = idx;
+    while (true) {
+        next = (next + 1) & mask;
+        if (!m_slots[next].count)
+            break;
+        // The slot can move back unless its home is cyclically in
+        // (idx, next]
+        size_t h = home(m_slots[next].line);
+        bool stays = idx <= next ? (idx < h && h <= next) :
+                                   (idx < h || h <= next);
+        if (!stays) {
+            m_slots[idx] = m_slots[next];
+            idx = next;
+        }
+    }
+    m_slots[idx].count = 0;
+}
+
+template<class Request>
+inline void
+RequestTable<Request>::resizeSlots(size_t num_slots)
+{
+    std::vector<Slot> old_slots(num_slots, Slot{0, -1, -1, 0});
+    old_slots.swap(m_slots);
+    m_hash_shift = 64 - floorLog2(num_slots);
+
+    for (const Slot &slot : old_slots) {
+        if (slot.count)
+            m_slots[probe(slot.line)] = slot;
+    }
+}
+
+#endif // __MEM_RUBY_SYSTEM_REQUESTTABLE_HH__
@@ -42,14 +42,13 @@
 #define __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 
 #include <iostream>
-#include <list>
-#include <unordered_map>
 
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/MachineType.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 #include "mem/ruby/protocol/SequencerRequestType.hh"
 #include "mem/ruby/structures/CacheMemory.hh"
+#include "mem/ruby/system/RequestTable.hh"
 #include "mem/ruby/system/RubyPort.hh"
 #include "params/RubySequencer.hh"
 
@@ -59,6 +58,10 @@ struct SequencerRequest
     RubyRequestType m_type;
     RubyRequestType m_second_type;
     Cycles issue_time;
+    SequencerRequest()
+        : pkt(nullptr), m_type(RubyRequestType_NULL),
+          m_second_type(RubyRequestType_NULL), issue_time(0)
+    {}
     SequencerRequest(PacketPtr _pkt, RubyRequestType _m_type,
                      RubyRequestType _m_second_type, Cycles _issue_time)
                 : pkt(_pkt), m_type(_m_type), m_second_type(_m_second_type),
@@ -124,6 +127,10 @@ class Sequencer : public RubyPort
     virtual bool empty() const;
     int outstandingCount() const override { return m_outstanding_count; }
 
+    // Whether a request to a line is outstanding
+    bool isLinePending(Addr line) const
+    { return m_RequestTable.count(line) > 0; }
+
     bool isDeadlockEventScheduled() const override
     { return deadlockCheckEvent.scheduled(); }
 
@@ -207,7 +214,7 @@ class Sequencer : public RubyPort
 
   protected:
     // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    RequestTable<SequencerRequest> m_RequestTable;
 
     Cycles m_deadlock_threshold;
 
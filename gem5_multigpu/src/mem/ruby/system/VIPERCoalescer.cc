@@ -39,6 +39,7 @@
 #include "cpu/testers/rubytest/RubyTester.hh"
 #include "debug/GPUCoalescer.hh"
 #include "debug/CPCoh.hh"
+#include "debug/Drain.hh"
 #include "debug/GlobalScheduler.hh"
 #include "debug/MemoryAccess.hh"
 #include "debug/ProtocolTrace.hh"
@@ -57,9 +58,14 @@ VIPERCoalescer::VIPERCoalescer(const Params &p)
     : GPUCoalescer(p),
       m_cache_inv_pkt(nullptr),
       m_num_pending_invs(0),
+      m_cache_wb_pkt(nullptr),
+      m_num_pending_releases(0),
+      m_num_pending_tcp_wbs(0),
       m_L2cache_flush_pkt(nullptr),
       m_L2cache_inv_pkt(nullptr),
       m_num_pending_wbs(0),
+      m_write_back_on_drain(p.write_back_on_drain),
+      m_drain_wbs(false),
       m_num_pending_tcc_wb(8),
       m_num_pending_tcc_inv(8),
       m_default_acq_rel(p.default_acq_rel)
@@ -77,6 +83,7 @@ VIPERCoalescer::makeRequest(PacketPtr pkt)
 {
     // VIPER only supports following memory request types
     //    MemSyncReq & INV_L1 : TCP cache invalidation
+    //    MemSyncReq & WB_L1  : TCP dirty line write-back
     //    ReadReq             : cache read
     //    WriteReq            : cache write
     //    AtomicOp            : cache atomic
@@ -88,7 +95,7 @@ VIPERCoalescer::makeRequest(PacketPtr pkt)
             pkt->cmd == MemCmd::WriteReq ||
             pkt->isAtomicOp());*/
     panic_if(!((pkt->cmd == MemCmd::MemSyncReq &&
-            (pkt->req->isInvL1() || pkt->req->isGL2CacheFlush() || pkt->req->isGL2CacheInv())) ||
+            (pkt->req->isInvL1() || pkt->req->isWbL1() || pkt->req->isGL2CacheFlush() || pkt->req->isGL2CacheInv())) ||
             pkt->cmd == MemCmd::ReadReq ||
             pkt->cmd == MemCmd::WriteReq ||
             pkt->isAtomicOp()), "Packet command: %s not expected",
@@ -103,6 +110,12 @@ VIPERCoalescer::makeRequest(PacketPtr pkt)
         return RequestStatus_Aliased;
     }
 
+    if (pkt->req->isWbL1() && m_cache_wb_pkt) {
+        // The L1 write-backs of the workgroups ending on this CU are
+        // serialized in the same way
+        return RequestStatus_Aliased;
+    }
+
     GPUCoalescer::makeRequest(pkt);
 
     if (pkt->req->isInvL1()) {
@@ -115,6 +128,15 @@ VIPERCoalescer::makeRequest(PacketPtr pkt)
         invTCP();
     }
 
+    if (pkt->req->isWbL1()) {
+        // A write-back TCP writes its dirty lines back when a workgroup
+        // ends, so that its stores are visible at the next kernel. The
+        // request is completed once all of them are acked.
+        assert(!m_cache_wb_pkt);
+        m_cache_wb_pkt = pkt;
+        releaseTCP();
+    }
+
     return RequestStatus_Issued;
 }
 
@@ -182,6 +204,7 @@ VIPERCoalescer::issueRequest(CoalescedRequest* crequest)
                               blockSize, accessMask,
                               dataBlock, crequest->getSeqNum(), pkt->req->getHomeNode(pkt->getAddr()));
     }
+    msg->m_isSLC = pkt->req->isSLC();
 
     if (pkt->cmd == MemCmd::WriteReq) {
         makeWriteCompletePkts(crequest);
@@ -279,7 +302,7 @@ void
 VIPERCoalescer::issueMemSyncRequest(PacketPtr pkt)
 {
     DPRINTF(GPUCoalescer, "issue VIPER MemSyncRequest\n");
-    if (!pkt->req->isInvL1()){
+    if (!pkt->req->isInvL1() && !pkt->req->isWbL1()){
         if(pkt->req->isGL2CacheInv()){
             if(m_L2cache_inv_pkt){
                 m_L2cache_inv_queue.push(pkt);
@@ -374,6 +397,93 @@ VIPERCoalescer::invTCP()
             m_num_pending_invs);
 }
 
+void
+VIPERCoalescer::releaseTCPCallback(Addr addr)
+{
+    assert(m_cache_wb_pkt && m_num_pending_releases > 0);
+
+    m_num_pending_releases--;
+
+    tryCompleteRelease();
+}
+
+void
+VIPERCoalescer::writeBackIssued(Addr addr)
+{
+    m_pending_tcp_wbs[makeLineAddress(addr)]++;
+    m_num_pending_tcp_wbs++;
+}
+
+void
+VIPERCoalescer::writeBackAcked(Addr addr)
+{
+    auto it = m_pending_tcp_wbs.find(makeLineAddress(addr));
+    assert(it != m_pending_tcp_wbs.end() && m_num_pending_tcp_wbs > 0);
+
+    if (--it->second == 0) {
+        m_pending_tcp_wbs.erase(it);
+    }
+    m_num_pending_tcp_wbs--;
+
+    tryCompleteRelease();
+}
+
+int
+VIPERCoalescer::getNumPendingWriteBacks(Addr addr)
+{
+    auto it = m_pending_tcp_wbs.find(makeLineAddress(addr));
+    return it == m_pending_tcp_wbs.end() ? 0 : it->second;
+}
+
+/**
+  * The release is done once the dirty lines found by the cache walk and
+  * every write-back still in flight have reached the TCC
+  */
+void
+VIPERCoalescer::tryCompleteRelease()
+{
+    if (m_cache_wb_pkt && m_num_pending_releases == 0 &&
+        m_num_pending_tcp_wbs == 0) {
+        std::vector<PacketPtr> pkt_list { m_cache_wb_pkt };
+        m_cache_wb_pkt = nullptr;
+        completeHitCallback(pkt_list);
+    }
+}
+
+/**
+  * Write the dirty lines of the TCP back
+  */
+void
+VIPERCoalescer::releaseTCP()
+{
+    int size = m_dataCache_ptr->getNumBlocks();
+    // Walk the cache, only the dirty lines have something to write back
+    for (int i = 0; i < size; i++) {
+        Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
+        AbstractCacheEntry *entry = m_dataCache_ptr->lookup(addr);
+        if (!entry ||
+            entry->getPermission() != AccessPermission_Read_Write) {
+            continue;
+        }
+        RubyRequestType request_type = RubyRequestType_Release;
+        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+            clockEdge(), addr, (uint8_t*) 0, 0, 0,
+            request_type, RubyAccessMode_Supervisor,
+            nullptr);
+        DPRINTF(GPUCoalescer, "Writing back addr 0x%x\n", addr);
+        assert(m_mandatory_q_ptr != NULL);
+        Tick latency = cyclesToTicks(
+            m_controller->mandatoryQueueLatency(request_type));
+        m_mandatory_q_ptr->enqueue(msg, clockEdge(), latency);
+        m_num_pending_releases++;
+    }
+    DPRINTF(GPUCoalescer,
+            "There are %d write-backs outstanding after Cache Walk, "
+            "%d in flight\n", m_num_pending_releases, m_num_pending_tcp_wbs);
+
+    tryCompleteRelease();
+}
+
 void
 VIPERCoalescer::triggerFlushTCC(MachineID requestor)
 {
@@ -443,8 +553,63 @@ bool VIPERCoalescer::flushTCCCallback(Addr addr)
         DPRINTF(GPUCoalescer,
                 "There are %d Flushes outstanding after this request\n",
                 m_num_pending_wbs);
-        return (m_num_pending_wbs == 0);
+        if (m_num_pending_wbs != 0)
+            return false;
+
+        // write-backs issued on drain have no TCP waiting for an ack
+        bool ack = !m_drain_wbs;
+        m_drain_wbs = false;
+        if (drainState() == DrainState::Draining) {
+            signalDrainDone();
+        }
+        return ack;
+    }
+}
+
+// Enqueue a flush for every dirty line of the data cache. Returns
+// true if any write-back is now pending.
+bool
+VIPERCoalescer::writeBackDirtyLines()
+{
+    int size = m_dataCache_ptr->getNumBlocks();
+    for (int i = 0; i < size; i++) {
+        Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
+        AbstractCacheEntry *entry = m_dataCache_ptr->lookup(addr);
+        if (entry == nullptr ||
+            entry->getPermission() != AccessPermission_Read_Write) {
+            continue;
+        }
+
+        RubyRequestType request_type = RubyRequestType_FLUSH;
+        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+            clockEdge(), addr, (uint8_t*) 0, 0, 0,
+            request_type, RubyAccessMode_Supervisor,
+            nullptr);
+        DPRINTF(GPUCoalescer, "Drain write-back addr 0x%x\n", addr);
+        Tick latency = cyclesToTicks(
+            m_controller->mandatoryQueueLatency(request_type));
+        m_mandatory_q_ptr->enqueue(msg, clockEdge(), latency);
+        m_num_pending_wbs++;
+        m_drain_wbs = true;
+    }
+    DPRINTF(GPUCoalescer,
+            "There are %d write-backs outstanding on drain\n",
+            m_num_pending_wbs);
+    return m_num_pending_wbs > 0;
+}
+
+DrainState
+VIPERCoalescer::drain()
+{
+    // Checkpoints only hold memory, so dirty lines are written back
+    // before the cache trace is taken. Written back lines are clean, so
+    // the next drain pass finds nothing left to do.
+    if (m_write_back_on_drain &&
+        (m_num_pending_wbs > 0 || writeBackDirtyLines())) {
+        DPRINTF(Drain, "VIPERCoalescer writing back dirty lines\n");
+        return DrainState::Draining;
     }
+    return GPUCoalescer::drain();
 }
 
 void VIPERCoalescer::invTCCCallback()
@@ -59,6 +59,10 @@ class VIPERCoalescer : public GPUCoalescer
     ~VIPERCoalescer();
     void writeCompleteCallback(Addr address, uint64_t instSeqNum);
     void invTCPCallback(Addr address);
+    void releaseTCPCallback(Addr address);
+    void writeBackIssued(Addr address);
+    void writeBackAcked(Addr address);
+    int getNumPendingWriteBacks(Addr address);
     RequestStatus makeRequest(PacketPtr pkt);
     void issueRequest(CoalescedRequest* crequest);
     void issueMemSyncRequest(PacketPtr pkt) override;
@@ -71,8 +75,13 @@ class VIPERCoalescer : public GPUCoalescer
     void setNumTCCSPending (int numtcc, bool wb);
     bool isFlushDone(bool wb);
 
+    DrainState drain() override;
+
   private:
     void invTCP();
+    void releaseTCP();
+    void tryCompleteRelease();
+    bool writeBackDirtyLines();
 
     // make write-complete response packets from original write request packets
     void makeWriteCompletePkts(CoalescedRequest* crequest);
@@ -84,6 +93,18 @@ class VIPERCoalescer : public GPUCoalescer
     // number of remaining cache lines to be invalidated in TCP
     int m_num_pending_invs;
 
+    // current L1 write-back request of a write-back TCP
+    // nullptr if there is no active L1 write-back request
+    PacketPtr m_cache_wb_pkt;
+
+    // number of remaining dirty lines to be written back by the TCP
+    int m_num_pending_releases;
+
+    // write-backs of the TCP not yet acked by the TCC, per line and in
+    // total; replacements write back too, so a release waits for all
+    std::unordered_map<Addr, int> m_pending_tcp_wbs;
+    int m_num_pending_tcp_wbs;
+
     // current cache invalidation packet
     // nullptr if there is no active cache invalidation request
     std::queue<PacketPtr> m_L2cache_inv_queue;
@@ -96,6 +117,11 @@ class VIPERCoalescer : public GPUCoalescer
 
     MachineID flush_requestor;
 
+    // write dirty lines back on drain, and whether the pending
+    // write-backs were issued by drain rather than by a TCP flush
+    bool m_write_back_on_drain;
+    bool m_drain_wbs;
+
     int m_num_pending_tcc_wb;
     int m_num_pending_tcc_inv;
     // a map of instruction sequence number and corresponding pending
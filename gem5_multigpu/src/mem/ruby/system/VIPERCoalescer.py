@@ -40,3 +40,5 @@ class VIPERCoalescer(RubyGPUCoalescer):
     max_inv_per_cycle = Param.Int(32, "max invalidations per cycle")
     max_wb_per_cycle = Param.Int(32, "max writebacks per cycle")
     default_acq_rel = Param.Bool(False, "are we using default orderding of rel/acq")
+    write_back_on_drain = Param.Bool(False,
+        "write dirty lines of the data cache back to memory on drain")
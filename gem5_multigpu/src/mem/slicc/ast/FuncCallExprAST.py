@@ -178,13 +178,13 @@ class FuncCallExprAST(ExprAST):
             counter++;
             continue; // Check the first port again
         } else {
-            scheduleEvent(Cycles(1));
+            scheduleStallRetry();
             // Cannot do anything with this transition, go check next doable transition (mostly likely of next port)
         }
 ''')
             else:
                 code('''
-        scheduleEvent(Cycles(1));
+        scheduleStallRetry();
         // Cannot do anything with this transition, go check next doable transition (mostly likely of next port)
 ''')
             code('''
@@ -197,13 +197,13 @@ class FuncCallExprAST(ExprAST):
             counter++;
             continue; // Check the first port again
         } else {
-            scheduleEvent(Cycles(1));
+            scheduleStallRetry();
             // Cannot do anything with this transition, go check next doable transition (mostly likely of next port)
         }
 ''')
             else:
                 code('''
-        scheduleEvent(Cycles(1));
+        scheduleStallRetry();
         // Cannot do anything with this transition, go check next doable transition (mostly likely of next port)
 ''')
             code('''
@@ -60,9 +60,16 @@ class PeekStatementAST(StatementAST):
         qcode = self.queue_name.var.code
         code('''
 {
-    // Declare message
+    // Declare message. Messages are nearly always of the exact type
+    // peeked for, which a typeid check finds without walking the class
+    // hierarchy like dynamic_cast does.
+    const Message *msg_ptr = ($qcode).${{self.method}}();
     M5_VAR_USED const $mtid* in_msg_ptr;
-    in_msg_ptr = dynamic_cast<const $mtid *>(($qcode).${{self.method}}());
+    if (msg_ptr && typeid(*msg_ptr) == typeid($mtid)) {
+        in_msg_ptr = static_cast<const $mtid *>(msg_ptr);
+    } else {
+        in_msg_ptr = dynamic_cast<const $mtid *>(msg_ptr);
+    }
     if (in_msg_ptr == NULL) {
         // If the cast fails, this is the wrong inport (wrong message type).
         // Throw an exception, and the caller will decide to either try a
@@ -63,6 +63,7 @@ python_class_map = {
                     "MessageBuffer": "MessageBuffer",
                     "DMASequencer": "DMASequencer",
                     "RubyPrefetcher":"RubyPrefetcher",
+                    "GPUPrefetcher":"GPUPrefetcher",
                     "Cycles":"Cycles",
                    }
 
@@ -88,7 +89,8 @@ class StateMachine(Symbol):
 
             self.symtab.registerSym(param.ident, var)
 
-            if str(param.type_ast.type) == "RubyPrefetcher":
+            if str(param.type_ast.type) in ("RubyPrefetcher",
+                                            "GPUPrefetcher"):
                 self.prefetchers.append(var)
 
         self.states = OrderedDict()
@@ -108,6 +110,7 @@ class StateMachine(Symbol):
         # Python's sets are not sorted so we have to be careful when using
         # this to generate deterministic output.
         self.debug_flags = set()
+        self.debug_flags.add('ProtocolTrace')
         self.debug_flags.add('RubyGenerated')
         self.debug_flags.add('RubySlicc')
 
@@ -228,7 +231,7 @@ class StateMachine(Symbol):
         self.printControllerPython(path)
         self.printControllerHH(path)
         self.printControllerCC(path, includes)
-        self.printCSwitch(path)
+        self.printCSwitch(path, includes)
         self.printCWakeup(path, includes)
 
     def printControllerPython(self, path):
@@ -460,6 +463,21 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
         code('#endif // __${ident}_CONTROLLER_H__')
         code.write(path, '%s.hh' % c_ident)
 
+    def appendCommentMacro(self):
+        '''The comments only end up in the protocol trace, so they are only
+        built when it is enabled'''
+        return '''
+#ifndef NDEBUG
+#define APPEND_TRANSITION_COMMENT(str) \\
+    do { \\
+        if (DTRACE(ProtocolTrace)) \\
+            ${ident}_transitionComment << str; \\
+    } while (0)
+#else
+#define APPEND_TRANSITION_COMMENT(str) do {} while (0)
+#endif
+'''.replace('${ident}', self.ident)
+
     def printControllerCC(self, path, includes):
         '''Output the actions for performing the actions'''
 
@@ -544,11 +562,7 @@ std::vector<std::vector<Stats::Vector *> >  $c_ident::transVec;
 // for adding information to the protocol debug trace
 std::stringstream ${ident}_transitionComment;
 
-#ifndef NDEBUG
-#define APPEND_TRANSITION_COMMENT(str) (${ident}_transitionComment << str)
-#else
-#define APPEND_TRANSITION_COMMENT(str) do {} while (0)
-#endif
+${{self.appendCommentMacro()}}
 
 /** \\brief constructor */
 $c_ident::$c_ident(const Params &p)
@@ -1049,7 +1063,66 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
         code.dedent()
         code('''
 }
+''')
+        for func in self.functions:
+            code(func.generateCode())
+
+        # Function for functional writes to messages buffered in the controller
+        code('''
+int
+$c_ident::functionalWriteBuffers(PacketPtr& pkt)
+{
+    int num_functional_writes = 0;
+''')
+        for var in self.objects:
+            vtype = var.type
+            if vtype.isBuffer:
+                vid = "m_%s_ptr" % var.ident
+                code('num_functional_writes += $vid->functionalWrite(pkt);')
+
+        for var in self.config_parameters:
+            vtype = var.type_ast.type
+            if vtype.isBuffer:
+                vid = "m_%s_ptr" % var.ident
+                code('num_functional_writes += $vid->functionalWrite(pkt);')
+
+        code('''
+    return num_functional_writes;
+}
+''')
 
+        # Function for functional reads to messages buffered in the controller
+        code('''
+bool
+$c_ident::functionalReadBuffers(PacketPtr& pkt)
+{
+''')
+        for var in self.objects:
+            vtype = var.type
+            if vtype.isBuffer:
+                vid = "m_%s_ptr" % var.ident
+                code('if ($vid->functionalRead(pkt)) return true;')
+
+        for var in self.config_parameters:
+            vtype = var.type_ast.type
+            if vtype.isBuffer:
+                vid = "m_%s_ptr" % var.ident
+                code('if ($vid->functionalRead(pkt)) return true;')
+
+        code('''
+    return false;
+}
+''')
+
+        code.write(path, "%s.cc" % c_ident)
+
+    def printActions(self, code):
+        '''Output the actions, which the transitions call'''
+
+        c_ident = "%s_Controller" % self.ident
+        ident = self.ident
+
+        code('''
 // Actions
 ''')
         if self.TBEType != None and self.EntryType != None:
@@ -1118,57 +1191,6 @@ $c_ident::${{action.ident}}(Addr addr)
 }
 
 ''')
-        for func in self.functions:
-            code(func.generateCode())
-
-        # Function for functional writes to messages buffered in the controller
-        code('''
-int
-$c_ident::functionalWriteBuffers(PacketPtr& pkt)
-{
-    int num_functional_writes = 0;
-''')
-        for var in self.objects:
-            vtype = var.type
-            if vtype.isBuffer:
-                vid = "m_%s_ptr" % var.ident
-                code('num_functional_writes += $vid->functionalWrite(pkt);')
-
-        for var in self.config_parameters:
-            vtype = var.type_ast.type
-            if vtype.isBuffer:
-                vid = "m_%s_ptr" % var.ident
-                code('num_functional_writes += $vid->functionalWrite(pkt);')
-
-        code('''
-    return num_functional_writes;
-}
-''')
-
-        # Function for functional reads to messages buffered in the controller
-        code('''
-bool
-$c_ident::functionalReadBuffers(PacketPtr& pkt)
-{
-''')
-        for var in self.objects:
-            vtype = var.type
-            if vtype.isBuffer:
-                vid = "m_%s_ptr" % var.ident
-                code('if ($vid->functionalRead(pkt)) return true;')
-
-        for var in self.config_parameters:
-            vtype = var.type_ast.type
-            if vtype.isBuffer:
-                vid = "m_%s_ptr" % var.ident
-                code('if ($vid->functionalRead(pkt)) return true;')
-
-        code('''
-    return false;
-}
-''')
-
-        code.write(path, "%s.cc" % c_ident)
 
     def printCWakeup(self, path, includes):
         '''Output the wakeup loop for the events'''
@@ -1224,10 +1246,14 @@ $c_ident::functionalReadBuffers(PacketPtr& pkt)
 void
 ${ident}_Controller::wakeup()
 {
+    bool serviced_memory = false;
     if (getMemReqQueue() && getMemReqQueue()->isReady(clockEdge())) {
         serviceMemoryQueue();
+        serviced_memory = true;
     }
 
+    stats.wakeups++;
+
     int counter = 0;
     while (true) {
         unsigned char rejected[${{len(msg_bufs)}}];
@@ -1294,37 +1320,66 @@ ${ident}_Controller::wakeup()
         code('''
         break;
     }
+
+    // Count the wakeups that found nothing to do
+    if (counter == 0 && !serviced_memory) {
+        stats.uselessWakeups++;
+    }
 }
 ''')
 
         code.write(path, "%s_Wakeup.cc" % self.ident)
 
-    def printCSwitch(self, path):
+    def printCSwitch(self, path, includes):
         '''Output switch statement for transition table'''
 
         code = self.symtab.codeFormatter()
         ident = self.ident
 
+        # The actions are generated in the same file as the transitions, so
+        # that the compiler can inline them into doTransitionWorker. This
+        # file therefore needs the same includes as the controller's.
         code('''
 // Auto generated C++ code started by $__file__:$__line__
 // ${ident}: ${{self.short}}
 
 #include <cassert>
+#include <cstdint>
+#include <sstream>
+#include <typeinfo>
+
+#include "mem/ruby/common/BoolVec.hh"
 
+#include "base/compiler.hh"
+#include "base/cprintf.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
-#include "debug/ProtocolTrace.hh"
-#include "debug/RubyGenerated.hh"
+
+''')
+        for f in sorted(self.debug_flags):
+            code('#include "debug/${{f}}.hh"')
+        code('''
 #include "mem/ruby/protocol/${ident}_Controller.hh"
 #include "mem/ruby/protocol/${ident}_Event.hh"
 #include "mem/ruby/protocol/${ident}_State.hh"
 #include "mem/ruby/protocol/Types.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
+''')
+        for include_path in includes:
+            code('#include "${{include_path}}"')
+
+        code('''
 #define HASH_FUN(state, event)  ((int(state)*${ident}_Event_NUM)+int(event))
 
 #define GET_TRANSITION_COMMENT() (${ident}_transitionComment.str())
-#define CLEAR_TRANSITION_COMMENT() (${ident}_transitionComment.str(""))
+#define CLEAR_TRANSITION_COMMENT() \\
+    do { \\
+        if (DTRACE(ProtocolTrace)) \\
+            ${ident}_transitionComment.str(""); \\
+    } while (0)
+
+${{self.appendCommentMacro()}}
 
 TransitionResult
 ${ident}_Controller::doTransition(${ident}_Event event,
@@ -1478,16 +1533,27 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
             case_sorter = []
             res = trans.resources
             for key,val in res.items():
+                # Tell the controller what will free up the resource, for
+                # it to know whether it needs to retry the transition. TBEs
+                # are only freed by the controller's own transitions.
+                if key.type.ident == "OutPort":
+                    on_stall = "    stallOnBuffer(&%s);\n" % key.code
+                elif key.type.ident == "TBETable":
+                    on_stall = ""
+                else:
+                    on_stall = "    pollStall();\n"
                 val = '''
-if (!%s.areNSlotsAvailable(%s, clockEdge()))
-    return TransitionResult_ResourceStall;
-''' % (key.code, val)
+if (!%s.areNSlotsAvailable(%s, clockEdge())) {
+%s    return TransitionResult_ResourceStall;
+}
+''' % (key.code, val, on_stall)
                 case_sorter.append(val)
 
             # Check all of the request_types for resource constraints
             for request_type in request_types:
                 val = '''
 if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
+    pollStall();
     return TransitionResult_ResourceStall;
 }
 ''' % (self.ident, request_type.ident)
@@ -1554,6 +1620,8 @@ if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
     return TransitionResult_Valid;
 }
 ''')
+        self.printActions(code)
+
         code.write(path, "%s_Transitions.cc" % self.ident)
 
 
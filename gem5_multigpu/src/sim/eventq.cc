@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -101,20 +102,95 @@ Event::insertBefore(Event *event, Event *curr)
 
         // Insert event at the top of the stack
         event->nextInBin = curr;
+#if USE_CALENDAR_EVENTQ
+        curr->prevInBin = event;
+#endif
     }
+#if USE_CALENDAR_EVENTQ
+    event->prevInBin = NULL;
+#endif
 
     return event;
 }
 
+#if USE_CALENDAR_EVENTQ
+void
+EventQueue::calendarInsert(Event *event, Event *curr)
+{
+    if (curr && *curr == *event)
+        calendar.replaceBin(curr, event);
+    else
+        calendar.insertBin(event);
+
+    if (calendar.resizeNeeded())
+        rebuildCalendar();
+}
+
+void
+EventQueue::calendarRemove(Event *event, Event *top, Event *new_top)
+{
+    // Removing an event from under the top of a bin leaves the bin as is
+    if (event != top)
+        return;
+
+    if (new_top && *new_top == *top)
+        calendar.replaceBin(top, new_top);
+    else
+        calendar.removeBin(top);
+
+    if (calendar.resizeNeeded())
+        rebuildCalendar();
+}
+
+void
+EventQueue::rebuildCalendar()
+{
+    size_t num_bins = 0;
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        ++num_bins;
+
+    // Size the buckets after the average spacing of the bins, leaving out
+    // the last few, which tend to be far-off outliers like the exit event
+    Tick width = 1;
+    if (num_bins > 1) {
+        size_t last = num_bins - 1 - num_bins / 16;
+        Event *bin = head;
+        for (size_t i = 0; i < last; ++i)
+            bin = bin->nextBin;
+        width = (bin->when() - head->when()) / std::max<size_t>(last, 1);
+        width = width > MaxTick / 2 ? MaxTick : 2 * width;
+    }
+
+    calendar.reset(num_bins, width);
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        calendar.insertBin(bin);
+}
+#endif
+
 void
 EventQueue::insert(Event *event)
 {
     // Deal with the head case
     if (!head || *event <= *head) {
+#if USE_CALENDAR_EVENTQ
+        Event *curr = head;
         head = Event::insertBefore(event, head);
+        calendarInsert(event, curr);
+#else
+        head = Event::insertBefore(event, head);
+#endif
         return;
     }
 
+#if USE_CALENDAR_EVENTQ
+    // The calendar knows which bin comes before the event, which is the
+    // only one whose nextBin pointer needs to change
+    Event *prev = calendar.prevBin(event);
+    assert(prev);
+    Event *curr = prev->nextBin;
+    prev->nextBin = Event::insertBefore(event, curr);
+    calendarInsert(event, curr);
+#else
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
     Event *prev = head;
@@ -127,12 +203,12 @@ EventQueue::insert(Event *event)
     // Note: this operation may render all nextBin pointers on the
     // prev 'in bin' list stale (except for the top one)
     prev->nextBin = Event::insertBefore(event, curr);
+#endif
 }
 
 Event *
 Event::removeItem(Event *event, Event *top)
 {
-    Event *curr = top;
     Event *next = top->nextInBin;
 
     // if we removed the top item, we need to handle things specially
@@ -142,11 +218,23 @@ Event::removeItem(Event *event, Event *top)
         if (!next)
             return top->nextBin;
         next->nextBin = top->nextBin;
+#if USE_CALENDAR_EVENTQ
+        next->prevInBin = NULL;
+#endif
         return next;
     }
 
+#if USE_CALENDAR_EVENTQ
+    // Unlink the event from its neighbours without walking the stack
+    if (!event->prevInBin || *event != *top)
+        panic("event not found!");
+    event->prevInBin->nextInBin = event->nextInBin;
+    if (event->nextInBin)
+        event->nextInBin->prevInBin = event->prevInBin;
+#else
     // Since we already checked the current element, we're going to
     // keep checking event against the next element.
+    Event *curr = top;
     while (event != next) {
         if (!next)
             panic("event not found!");
@@ -157,6 +245,7 @@ Event::removeItem(Event *event, Event *top)
 
     // remove next from the 'in bin' list since it's what we're looking for
     curr->nextInBin = next->nextInBin;
+#endif
     return top;
 }
 
@@ -171,17 +260,30 @@ EventQueue::remove(Event *event)
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
+#if USE_CALENDAR_EVENTQ
+        Event *top = head;
         head = Event::removeItem(event, head);
+        calendarRemove(event, top, head);
+#else
+        head = Event::removeItem(event, head);
+#endif
         return;
     }
 
     // Find the 'in bin' list that this event belongs on
+#if USE_CALENDAR_EVENTQ
+    Event *prev = calendar.prevBin(event);
+    if (!prev)
+        panic("event not found!");
+    Event *curr = prev->nextBin;
+#else
     Event *prev = head;
     Event *curr = head->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
     }
+#endif
 
     if (!curr || *curr != *event)
         panic("event not found!");
@@ -190,6 +292,9 @@ EventQueue::remove(Event *event)
     // we remove an item, it returns the new top item (which may be
     // unchanged)
     prev->nextBin = Event::removeItem(event, curr);
+#if USE_CALENDAR_EVENTQ
+    calendarRemove(event, curr, prev->nextBin);
+#endif
 }
 
 Event *
@@ -203,6 +308,9 @@ EventQueue::serviceOne()
     if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
+#if USE_CALENDAR_EVENTQ
+        next->prevInBin = NULL;
+#endif
 
         // pop the stack
         head = next;
@@ -211,6 +319,9 @@ EventQueue::serviceOne()
         // the 'in bin' list and point to the next bin list
         head = head->nextBin;
     }
+#if USE_CALENDAR_EVENTQ
+    calendarRemove(event, event, head);
+#endif
 
     // handle action
     if (!event->squashed()) {
@@ -355,6 +466,9 @@ EventQueue::replaceHead(Event* s)
 {
     Event* t = head;
     head = s;
+#if USE_CALENDAR_EVENTQ
+    rebuildCalendar();
+#endif
     return t;
 }
 
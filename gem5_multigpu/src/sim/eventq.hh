@@ -48,10 +48,15 @@
 #include "base/flags.hh"
 #include "base/types.hh"
 #include "base/uncontended_mutex.hh"
+#include "config/use_calendar_eventq.hh"
 #include "debug/Event.hh"
 #include "sim/core.hh"
 #include "sim/serialize.hh"
 
+#if USE_CALENDAR_EVENTQ
+#include "sim/eventq_calendar.hh"
+#endif
+
 class EventQueue;       // forward declaration
 class BaseGlobalEvent;
 
@@ -261,6 +266,11 @@ class Event : public EventBase, public Serializable
     // over the current fully linear insertion.
     Event *nextBin;
     Event *nextInBin;
+#if USE_CALENDAR_EVENTQ
+    // With the calendar the bins are found in constant time, so the
+    // 'in bin' list is doubly linked for the removal to be as well
+    Event *prevInBin;
+#endif
 
     static Event *insertBefore(Event *event, Event *curr);
     static Event *removeItem(Event *event, Event *last);
@@ -409,8 +419,11 @@ class Event : public EventBase, public Serializable
      * @ingroup api_eventq
      */
     Event(Priority p = Default_Pri, Flags f = 0)
-        : nextBin(nullptr), nextInBin(nullptr), _when(0), _priority(p),
-          flags(Initialized | f)
+        : nextBin(nullptr), nextInBin(nullptr),
+#if USE_CALENDAR_EVENTQ
+          prevInBin(nullptr),
+#endif
+          _when(0), _priority(p), flags(Initialized | f)
     {
         assert(f.noneSet(~PublicWrite));
 #ifndef NDEBUG
@@ -625,6 +638,19 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
+#if USE_CALENDAR_EVENTQ
+    //! Index of the bins, so that insert() and remove() do not walk them
+    EventCalendar calendar;
+
+    //! Update the calendar after an event was put in front of the bin
+    //! list curr, i.e., on top of curr's bin or in a new bin before it
+    void calendarInsert(Event *event, Event *curr);
+    //! Update the calendar after an event was taken out of the bin that
+    //! had top on top, and that now has new_top on top, or is gone
+    void calendarRemove(Event *event, Event *top, Event *new_top);
+    void rebuildCalendar();
+#endif
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
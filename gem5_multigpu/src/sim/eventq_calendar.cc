@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/eventq_calendar.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <iterator>
+
+#include "base/intmath.hh"
+#include "sim/eventq.hh"
+
+EventCalendar::EventCalendar()
+    : buckets(minBuckets), shift(0), numBins(0)
+{
+}
+
+Event *
+EventCalendar::findBin(const Event *event) const
+{
+    const Bin key = {event->when(), event->priority(), nullptr};
+    const std::vector<Bin> &b = bucket(day(key.when));
+    auto it = std::lower_bound(b.begin(), b.end(), key, binLess);
+    if (it != b.end() && it->when == key.when &&
+        it->priority == key.priority) {
+        return it->top;
+    }
+    return nullptr;
+}
+
+Event *
+EventCalendar::prevBin(const Event *event) const
+{
+    const Bin key = {event->when(), event->priority(), nullptr};
+
+    // Look at the event's own day first, and then at the days before it,
+    // one bucket at a time. Every bucket also holds the bins of other
+    // years, i.e., of days that are numBuckets apart, so only the bins
+    // of the day being looked at count.
+    Tick d = day(key.when);
+    Bin bound = key;
+    const size_t scan_days =
+        buckets.size() < maxScanDays ? buckets.size() : maxScanDays;
+    for (size_t i = 0; i < scan_days; ++i) {
+        const std::vector<Bin> &b = bucket(d);
+        auto it = std::lower_bound(b.begin(), b.end(), bound, binLess);
+        if (it != b.begin() && day(std::prev(it)->when) == d)
+            return std::prev(it)->top;
+        if (d == 0)
+            return nullptr;
+        bound = {d << shift, INT_MIN, nullptr};
+        --d;
+    }
+
+    // The event is far from the bins before it compared to the bucket
+    // width, so the last one before it can be in any bucket
+    const Bin *prev = nullptr;
+    for (const auto &b : buckets) {
+        auto it = std::lower_bound(b.begin(), b.end(), key, binLess);
+        if (it != b.begin() && (!prev || binLess(*prev, *std::prev(it))))
+            prev = &*std::prev(it);
+    }
+    return prev ? prev->top : nullptr;
+}
+
+void
+EventCalendar::insertBin(Event *top)
+{
+    const Bin bin = {top->when(), top->priority(), top};
+    std::vector<Bin> &b = bucket(day(bin.when));
+    if (b.empty() || binLess(b.back(), bin)) {
+        b.push_back(bin);
+    } else {
+        auto it = std::upper_bound(b.begin(), b.end(), bin, binLess);
+        b.insert(it, bin);
+    }
+    ++numBins;
+}
+
+void
+EventCalendar::removeBin(Event *top)
+{
+    const Bin key = {top->when(), top->priority(), top};
+    std::vector<Bin> &b = bucket(day(key.when));
+    auto it = std::lower_bound(b.begin(), b.end(), key, binLess);
+    assert(it != b.end() && it->top == top);
+    b.erase(it);
+    --numBins;
+}
+
+void
+EventCalendar::replaceBin(Event *old_top, Event *new_top)
+{
+    assert(*old_top == *new_top);
+    const Bin key = {old_top->when(), old_top->priority(), old_top};
+    std::vector<Bin> &b = bucket(day(key.when));
+    auto it = std::lower_bound(b.begin(), b.end(), key, binLess);
+    assert(it != b.end() && it->top == old_top);
+    it->top = new_top;
+}
+
+void
+EventCalendar::reset(size_t num_bins, Tick width)
+{
+    size_t num_buckets = minBuckets;
+    while (num_buckets < num_bins)
+        num_buckets *= 2;
+
+    buckets.clear();
+    buckets.resize(num_buckets);
+    // Keep the shift below the width of a Tick even for huge widths
+    shift = std::min(ceilLog2(std::max<Tick>(width, 1)), 62);
+    numBins = 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENTQ_CALENDAR_HH__
+#define __SIM_EVENTQ_CALENDAR_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/types.hh"
+
+class Event;
+
+/**
+ * A calendar queue index over the bins of an EventQueue.
+ *
+ * The EventQueue keeps its events in a sorted list of bins, one per
+ * (when, priority) pair, and without an index it has to walk that list
+ * to find where an event goes. The calendar hashes the top event of
+ * every bin into a bucket by its tick, (when >> shift) % numBuckets, and
+ * keeps every bucket sorted, so the bin before an event is found in the
+ * event's bucket or in the few buckets before it. The list itself, and
+ * so the order the events are serviced in, is left unchanged.
+ *
+ * The EventQueue rebuilds the calendar from its list whenever
+ * resizeNeeded() says the number of bins has outgrown, or shrunk well
+ * below, the number of buckets. That is also when the bucket width is
+ * re-estimated from the average spacing of the bins.
+ */
+class EventCalendar
+{
+  public:
+    EventCalendar();
+
+    /** Get the top event of the bin an event would go in, if any */
+    Event *findBin(const Event *event) const;
+
+    /**
+     * Get the top event of the last bin before an event, or nullptr if
+     * the event would go in the first bin.
+     */
+    Event *prevBin(const Event *event) const;
+
+    /** Add a new bin, or remove a bin that has become empty */
+    void insertBin(Event *top);
+    void removeBin(Event *top);
+
+    /** Change the top event of a bin */
+    void replaceBin(Event *old_top, Event *new_top);
+
+    bool
+    resizeNeeded() const
+    {
+        return numBins > 2 * buckets.size() ||
+            (buckets.size() > minBuckets && numBins < buckets.size() / 4);
+    }
+
+    /**
+     * Drop all the bins and size the calendar for a number of bins, with
+     * buckets that are a number of ticks wide (rounded up to a power of
+     * two).
+     */
+    void reset(size_t num_bins, Tick width);
+
+    size_t size() const { return numBins; }
+
+  private:
+    struct Bin
+    {
+        Tick when;
+        int priority;
+        Event *top;
+    };
+
+    static bool
+    binLess(const Bin &l, const Bin &r)
+    {
+        return l.when < r.when ||
+            (l.when == r.when && l.priority < r.priority);
+    }
+
+    static const size_t minBuckets = 16;
+    // Days prevBin() looks back before it searches all the buckets
+    static const size_t maxScanDays = 32;
+
+    Tick day(Tick when) const { return when >> shift; }
+    std::vector<Bin> &
+    bucket(Tick day)
+    {
+        return buckets[day & (buckets.size() - 1)];
+    }
+    const std::vector<Bin> &
+    bucket(Tick day) const
+    {
+        return buckets[day & (buckets.size() - 1)];
+    }
+
+    std::vector<std::vector<Bin>> buckets;
+    unsigned shift;
+    size_t numBins;
+};
+
+#endif // __SIM_EVENTQ_CALENDAR_HH__
@@ -356,9 +356,25 @@ Process::serialize(CheckpointOut &cp) const
 {
     memState->serialize(cp);
     pTable->serialize(cp);
+
     /**
-     * Checkpoints for file descriptors currently do not work. Need to
-     * come back and fix them at a later date.
+     * Emulated device file descriptors only refer to a driver, so they
+     * can be recreated on restore. The driver state is checkpointed by
+     * the driver itself.
+     */
+    std::vector<int> device_fds;
+    for (int tgt_fd = 0; tgt_fd < fds->getSize(); tgt_fd++) {
+        auto dfdp = std::dynamic_pointer_cast<DeviceFDEntry>((*fds)[tgt_fd]);
+        if (!dfdp)
+            continue;
+        device_fds.push_back(tgt_fd);
+        dfdp->serializeSection(cp, csprintf("device_fd%d", tgt_fd));
+    }
+    SERIALIZE_CONTAINER(device_fds);
+
+    /**
+     * Checkpoints for other file descriptors currently do not work. Need
+     * to come back and fix them at a later date.
      */
 
     warn("Checkpoints for file descriptors currently do not work.");
@@ -369,6 +385,21 @@ Process::unserialize(CheckpointIn &cp)
 {
     memState->unserialize(cp);
     pTable->unserialize(cp);
+
+    // Older checkpoints don't record device file descriptors
+    std::vector<int> device_fds;
+    if (cp.entryExists(Serializable::currentSection(), "device_fds"))
+        UNSERIALIZE_CONTAINER(device_fds);
+    for (auto tgt_fd : device_fds) {
+        auto dfdp = std::make_shared<DeviceFDEntry>(nullptr, "");
+        dfdp->unserializeSection(cp, csprintf("device_fd%d", tgt_fd));
+
+        EmulatedDriver *driver = findDriver(dfdp->getFileName());
+        fatal_if(!driver, "No driver for checkpointed device %s\n",
+                 dfdp->getFileName());
+        fds->setFDEntry(tgt_fd, std::make_shared<DeviceFDEntry>(driver,
+            dfdp->getFileName(), dfdp->getCOE()));
+    }
     /**
      * Checkpoints for file descriptors currently do not work. Need to
      * come back and fix them at a later date.
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 The gem5 multi-GPU authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Event queue churn microbenchmark. A population of events keeps
+ * rescheduling itself, with mostly short delays and a few long ones,
+ * while random events get rescheduled or descheduled from under the
+ * queue, the way Ruby controllers and GPU CUs move their wakeups around.
+ *
+ * Build it with and without USE_CALENDAR_EVENTQ to compare the two
+ * event queue implementations:
+ *
+ *     eventqtime [num events] [num serviced events]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "config/use_calendar_eventq.hh"
+#include "sim/eventq.hh"
+
+namespace
+{
+
+std::mt19937_64 rng(0x5eed);
+
+Tick
+randomDelay()
+{
+    // Most events are a few cycles out, some are far in the future
+    if (rng() % 16)
+        return 1 + rng() % 64;
+    return 1 + rng() % 100000;
+}
+
+class ChurnEvent : public Event
+{
+  public:
+    ChurnEvent(EventQueue &_eq, Priority p) : Event(p), eq(_eq) {}
+
+    void
+    process() override
+    {
+        ++processed;
+        eq.schedule(this, eq.getCurTick() + randomDelay());
+    }
+
+    static uint64_t processed;
+
+  private:
+    EventQueue &eq;
+};
+
+uint64_t ChurnEvent::processed = 0;
+
+} // anonymous namespace
+
+int
+main(int argc, char *argv[])
+{
+    const int num_events = argc > 1 ? atoi(argv[1]) : 50000;
+    const uint64_t num_serviced = argc > 2 ? atoll(argv[2]) : 10000000;
+
+    EventQueue eq("churn");
+    curEventQueue(&eq);
+
+    std::vector<std::unique_ptr<ChurnEvent>> events;
+    for (int i = 0; i < num_events; ++i) {
+        Event::Priority prio = Event::Default_Pri + (int)(rng() % 3) - 1;
+        events.emplace_back(new ChurnEvent(eq, prio));
+        eq.schedule(events.back().get(), randomDelay());
+    }
+
+    uint64_t num_moved = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (ChurnEvent::processed < num_serviced) {
+        eq.serviceOne();
+
+        // Move one random event for every event serviced
+        ChurnEvent *event = events[rng() % events.size()].get();
+        if (event->scheduled() && rng() % 4 == 0) {
+            eq.deschedule(event);
+        } else {
+            eq.reschedule(event, eq.getCurTick() + randomDelay(), true);
+        }
+        ++num_moved;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    cprintf("%s event queue, %d events: serviced %d and moved %d events "
+            "in %.3fs, %.0f events/s, ended at tick %d\n",
+            USE_CALENDAR_EVENTQ ? "calendar" : "list", num_events,
+            ChurnEvent::processed, num_moved, seconds,
+            (ChurnEvent::processed + num_moved) / seconds, eq.getCurTick());
+
+    for (auto &event : events) {
+        if (event->scheduled())
+            eq.deschedule(event.get());
+    }
+
+    return 0;
+}
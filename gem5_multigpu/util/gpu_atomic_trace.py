@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The gem5 multi-GPU authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Generates GPU memory traces of contended atomics, to measure the atomic
+# throughput of a GPU_VIPER system with configs/example/gpu_mem_trace_replay.py.
+# Every wavefront of every CU runs a chain of returning atomics, each one
+# waiting for the old value of the previous one as a worklist or reduction
+# loop does. The atomics go to a set of counters one line apart, so a few
+# counters model a reduction or worklist tail and many counters a
+# histogram. Each atomic updates the first --lanes words of its counter's
+# line, as the lanes of a wavefront that hit the same line do. The atomics
+# are system scope unless --scope agent is given, and only system-scope
+# atomics run near memory. For example:
+#
+# util/gpu_atomic_trace.py --num-gpus 4 -u 4 --num-counters 1 --prefix atom
+# build/GPU_VIPER/gem5.opt configs/example/gpu_mem_trace_replay.py \
+#     --num-gpus 4 -u 4 --trace-prefix atom [--near-memory-atomics]
+#
+# The atomic throughput is the number of atomics, printed here, over the
+# simulated time. The traces need the Python package of the trace
+# messages, which can be generated from the gem5 root with:
+# protoc --python_out=util --proto_path=src/proto src/proto/gpu_mem_trace.proto
+
+import argparse
+import gzip
+import random
+
+import protolib
+
+try:
+    import gpu_mem_trace_pb2
+except:
+    print("Did not find GPU memory trace proto definitions, attempting to "
+          "generate")
+    from subprocess import call
+    error = call(['protoc', '--python_out=util', '--proto_path=src/proto',
+                  'src/proto/gpu_mem_trace.proto'])
+    if not error:
+        print("Generated GPU memory trace proto definitions")
+
+        try:
+            import google.protobuf
+        except:
+            print("Please install the Python protobuf module")
+            exit(-1)
+
+        import gpu_mem_trace_pb2
+    else:
+        print("Failed to import GPU memory trace proto definitions")
+        exit(-1)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Generate GPU memory traces of contended atomics")
+    parser.add_argument("--prefix", default="gpu_atomic",
+                        help="Prefix of the traces, one "
+                        "<prefix>.<cu>.trc.gz per CU")
+    parser.add_argument("--num-gpus", type=int, default=1,
+                        help="Number of GPUs (chiplets)")
+    parser.add_argument("-u", "--num-compute-units", type=int, default=4,
+                        help="Number of CUs per GPU")
+    parser.add_argument("--waves-per-cu", type=int, default=4,
+                        help="Number of wavefronts per CU")
+    parser.add_argument("--atomics-per-wave", type=int, default=256,
+                        help="Number of atomics each wavefront runs")
+    parser.add_argument("--num-counters", type=int, default=1,
+                        help="Number of counters the atomics go to")
+    parser.add_argument("--lanes", type=int, default=1,
+                        help="Number of consecutive words of the counter's "
+                        "line each atomic updates")
+    parser.add_argument("--scope", choices=["system", "agent"],
+                        default="system",
+                        help="Memory scope of the atomics")
+    parser.add_argument("--base-addr", type=lambda x: int(x, 0),
+                        default=0x10000000,
+                        help="Address of the first counter")
+    parser.add_argument("--home-node", type=int, default=0,
+                        help="GPU that is the home node of the counters, "
+                        "-1 to map them by address")
+    parser.add_argument("--delay", type=int, default=0,
+                        help="Ticks between the old value of an atomic "
+                        "returning and the next atomic of the wavefront")
+    parser.add_argument("--block-size", type=int, default=64,
+                        help="Cache line size in bytes")
+    parser.add_argument("--seed", type=int, default=0,
+                        help="Seed of the counter choice")
+    args = parser.parse_args()
+
+    if args.num_counters < 1:
+        print("Need at least one counter")
+        exit(-1)
+
+    if args.lanes < 1 or args.lanes * 4 > args.block_size:
+        print("Need between 1 and %d lanes" % (args.block_size // 4))
+        exit(-1)
+
+    rng = random.Random(args.seed)
+
+    # Each atomic updates the first words of its counter's line, one mask
+    # bit per byte
+    mask = ((1 << (args.lanes * 4)) - 1).to_bytes(args.block_size // 8,
+                                                  "little")
+
+    num_cus = args.num_gpus * args.num_compute_units
+    for cu in range(num_cus):
+        filename = "%s.%d.trc.gz" % (args.prefix, cu)
+        with gzip.open(filename, 'wb') as proto_out:
+            # Write the magic number in 4-byte Little Endian, similar to
+            # what is done in src/proto/protoio.cc
+            proto_out.write(b"gem5")
+
+            header = gpu_mem_trace_pb2.GPUMemTraceHeader()
+            header.obj_id = "Atomic throughput trace for CU %d" % cu
+            # Assume the default tick rate
+            header.tick_freq = 1000000000000
+            header.block_size = args.block_size
+            protolib.encodeMessage(proto_out, header)
+
+            seq_num = 0
+            for wave in range(args.waves_per_cu):
+                for i in range(args.atomics_per_wave):
+                    counter = rng.randrange(args.num_counters)
+                    record = gpu_mem_trace_pb2.GPUMemRecord()
+                    record.seq_num = seq_num
+                    record.wave_id = wave
+                    record.kernel_id = 0
+                    record.type = gpu_mem_trace_pb2.GPUMemRecord.ATOMIC
+                    record.addr = args.base_addr + counter * args.block_size
+                    record.mask = mask
+                    record.home_node = args.home_node
+                    record.slc = args.scope == "system"
+                    if i > 0:
+                        record.dep_seq_num = seq_num - 1
+                        record.delay = args.delay
+                    protolib.encodeMessage(proto_out, record)
+                    seq_num += 1
+
+    print("Wrote %d atomics to %d traces %s.<cu>.trc.gz" %
+          (num_cus * args.waves_per_cu * args.atomics_per_wave, num_cus,
+           args.prefix))
+
+if __name__ == "__main__":
+    main()